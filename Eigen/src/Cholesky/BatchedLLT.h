@@ -0,0 +1,295 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_LLT_H
+#define EIGEN_BATCHED_LLT_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal Cholesky factorization, in place in the lower triangle, of the problems starting at \a first */
+template<typename Scalar, int Size>
+struct batched_llt_factor_kernel
+{
+  batched_llt_factor_kernel(const batched_view<Scalar,Size>& matrix, Scalar* failures)
+    : m_matrix(matrix), m_failures(failures)
+  {}
+
+  template<typename Packet, int Packets>
+  void run(Index first) const
+  {
+    enum { PacketSize = unpacket_traits<Packet>::size, Width = Packets * PacketSize };
+    const Index n = m_matrix.rows();
+    ei_declare_aligned_stack_constructed_variable(Scalar, data, n*n*Width, 0);
+    const batched_view<Scalar,Size,Width> a(data, Width, n);
+    batched_copy<Packet,Packets>(m_matrix, first, a, 0, n);
+    for(Index p = 0; p < Packets; ++p)
+      pstoreu<Scalar>(m_failures + first + p*PacketSize, factor<Packet>(a, p*PacketSize));
+    batched_copy<Packet,Packets>(a, 0, m_matrix, first, n);
+  }
+
+  /** \internal \returns 1 in the lanes whose matrix is not positive definite, and 0 elsewhere */
+  template<typename Packet, typename View>
+  static Packet factor(const View& a, Index first)
+  {
+    const Index n = a.rows();
+    const Packet zero = pset1<Packet>(Scalar(0));
+    Packet failed = zero;
+    // right-looking variant: the updates of the trailing columns are independent of each other
+    for(Index j = 0; j < n; ++j)
+    {
+      Packet d = a.template load<Packet>(first, j, j);
+      // a non positive (or NaN) pivot flags the lane, the remaining columns of this lane are meaningless
+      failed = pselect(pcmp_lt(zero, d), failed, pset1<Packet>(Scalar(1)));
+      Packet ljj = psqrt(d);
+      a.store(first, j, j, ljj);
+      for(Index i = j+1; i < n; ++i)
+        a.store(first, i, j, pdiv(a.template load<Packet>(first, i, j), ljj));
+      for(Index c = j+1; c < n; ++c)
+      {
+        Packet lcj = a.template load<Packet>(first, c, j);
+        for(Index i = c; i < n; ++i)
+          a.store(first, i, c, psub(a.template load<Packet>(first, i, c), pmul(a.template load<Packet>(first, i, j), lcj)));
+      }
+    }
+    return failed;
+  }
+
+  batched_view<Scalar,Size> m_matrix;
+  Scalar* m_failures;
+};
+
+/** \internal Solves L L^T X = B in place in \a rhs, for the problems starting at \a first */
+template<typename Scalar, int Size>
+struct batched_llt_solve_kernel
+{
+  batched_llt_solve_kernel(const batched_view<const Scalar,Size>& matrix, const batched_view<Scalar,Size>& rhs, Index rhsCols)
+    : m_matrix(matrix), m_rhs(rhs), m_rhsCols(rhsCols)
+  {}
+
+  template<typename Packet, int Packets>
+  void run(Index first) const
+  {
+    enum { PacketSize = unpacket_traits<Packet>::size, Width = Packets * PacketSize };
+    const Index n = m_matrix.rows();
+    ei_declare_aligned_stack_constructed_variable(Scalar, data, n*n*Width, 0);
+    const batched_view<Scalar,Size,Width> L(data, Width, n);
+    batched_copy<Packet,Packets>(m_matrix, first, L, 0, n);
+    ei_declare_aligned_stack_constructed_variable(Scalar, rhsData, n*m_rhsCols*Width, 0);
+    const batched_view<Scalar,Size,Width> x(rhsData, Width, n);
+    batched_copy<Packet,Packets>(m_rhs, first, x, 0, m_rhsCols);
+    for(Index p = 0; p < Packets; ++p)
+      solve<Packet>(L, x, p*PacketSize, m_rhsCols);
+    batched_copy<Packet,Packets>(x, 0, m_rhs, first, m_rhsCols);
+  }
+
+  template<typename Packet, typename View>
+  static void solve(const View& L, const View& x, Index first, Index rhsCols)
+  {
+    const Index n = L.rows();
+    for(Index c = 0; c < rhsCols; ++c)
+    {
+      // L y = b
+      for(Index k = 0; k < n; ++k)
+      {
+        Packet xk = pdiv(x.template load<Packet>(first, k, c), L.template load<Packet>(first, k, k));
+        x.store(first, k, c, xk);
+        for(Index i = k+1; i < n; ++i)
+          x.store(first, i, c, psub(x.template load<Packet>(first, i, c), pmul(L.template load<Packet>(first, i, k), xk)));
+      }
+      // L^T x = y
+      for(Index k = n-1; k >= 0; --k)
+      {
+        Packet xk = pdiv(x.template load<Packet>(first, k, c), L.template load<Packet>(first, k, k));
+        x.store(first, k, c, xk);
+        for(Index i = 0; i < k; ++i)
+          x.store(first, i, c, psub(x.template load<Packet>(first, i, c), pmul(L.template load<Packet>(first, k, i), xk)));
+      }
+    }
+  }
+
+  batched_view<const Scalar,Size> m_matrix;
+  batched_view<Scalar,Size> m_rhs;
+  Index m_rhsCols;
+};
+
+} // end namespace internal
+
+/** \ingroup Cholesky_Module
+  *
+  * \class BatchedLLT
+  *
+  * \brief Cholesky decompositions (LL^T) of a batch of small matrices of the same size
+  *
+  * \tparam _MatrixType the type of one matrix of the batch, e.g. Matrix<double,8,8> or MatrixXd
+  *
+  * This class computes the LL^T decompositions of many independent symmetric positive definite
+  * matrices at once. The batch is stored in an interleaved ("structure of arrays") layout: it is a
+  * B x n<sup>2</sup> matrix of type BatchType, whose row \a b holds the coefficients of the \a b-th
+  * n x n matrix in column-major order. Hence, the same coefficient of consecutive matrices is contiguous
+  * in memory, and each SIMD lane of a packet factorizes its own matrix: the B problems advance in lockstep,
+  * which is faster than decomposing small matrices (up to about 16x16) one after the other. The right hand sides
+  * of solve() use the same layout, with n x k matrices stored in B x (n*k) batches.
+  *
+  * Only the lower triangular part of each matrix is read. When the size is not fixed at compile time, it
+  * is deduced from the number of columns of the batch. Large batches are split among the available threads
+  * (see \ref TopicMultiThreading).
+  *
+  * A matrix that is not positive definite does not stop the decomposition of the others: info(Index) reports
+  * the status of each of them.
+  *
+  * \code
+  * MatrixXd batch(1000, 8*8);           // row b: the 64 coefficients of the b-th 8x8 matrix
+  * BatchedLLT<Matrix<double,8,8> > llt(batch);
+  * MatrixXd x = llt.solve(rhs);         // rhs is a 1000 x 8 batch of vectors
+  * \endcode
+  *
+  * This class is restricted to real scalar types.
+  *
+  * \sa class LLT, class BatchedPartialPivLU
+  */
+template<typename _MatrixType> class BatchedLLT
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef Matrix<Scalar,Dynamic,Dynamic> BatchType;
+    enum { SizeAtCompileTime = MatrixType::RowsAtCompileTime };
+
+    /** \brief Default Constructor.
+      *
+      * The default constructor is useful in cases in which the user intends to
+      * perform decompositions via BatchedLLT::compute(const MatrixBase<InputType>&).
+      */
+    BatchedLLT() : m_size(0), m_isInitialized(false)
+    {
+      check_template_parameters();
+    }
+
+    /** \brief Constructor computing the decompositions of a batch of matrices
+      *
+      * \param batch the B x n<sup>2</sup> batch of matrices to decompose
+      */
+    template<typename InputType>
+    explicit BatchedLLT(const MatrixBase<InputType>& batch) : m_size(0), m_isInitialized(false)
+    {
+      check_template_parameters();
+      compute(batch.derived());
+    }
+
+    template<typename InputType>
+    BatchedLLT& compute(const MatrixBase<InputType>& batch);
+
+    /** \returns the number of matrices of the batch */
+    Index batchSize() const { return m_matrix.rows(); }
+
+    /** \returns the size of each matrix of the batch */
+    Index size() const { return m_size; }
+
+    /** \returns the factors L of the batch, in the lower triangular parts of its matrices */
+    const BatchType& matrixLLT() const
+    {
+      eigen_assert(m_isInitialized && "BatchedLLT is not initialized.");
+      return m_matrix;
+    }
+
+    /** \returns \c Success if all the matrices of the batch are positive definite, \c NumericalIssue otherwise */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "BatchedLLT is not initialized.");
+      return (m_failures.array() != Scalar(0)).any() ? NumericalIssue : Success;
+    }
+
+    /** \returns \c Success if the \a b-th matrix of the batch is positive definite, \c NumericalIssue otherwise */
+    ComputationInfo info(Index b) const
+    {
+      eigen_assert(m_isInitialized && "BatchedLLT is not initialized.");
+      return m_failures.coeff(b) != Scalar(0) ? NumericalIssue : Success;
+    }
+
+    /** \returns the solutions x<sub>b</sub> of A<sub>b</sub> x<sub>b</sub> = b<sub>b</sub>, using the current decompositions
+      *
+      * \param rhs the B x (n*k) batch of the n x k right hand sides
+      */
+    template<typename Rhs>
+    BatchType solve(const MatrixBase<Rhs>& rhs) const;
+
+    /** \returns the inverses of the matrices of the batch, in the same layout */
+    BatchType inverse() const
+    {
+      eigen_assert(m_isInitialized && "BatchedLLT is not initialized.");
+      return solve(identityBatch());
+    }
+
+  protected:
+
+    static void check_template_parameters()
+    {
+      EIGEN_STATIC_ASSERT_NON_INTEGER(Scalar);
+      EIGEN_STATIC_ASSERT(!NumTraits<Scalar>::IsComplex, NUMERIC_TYPE_MUST_BE_REAL);
+      EIGEN_STATIC_ASSERT(MatrixType::RowsAtCompileTime==MatrixType::ColsAtCompileTime, YOU_MIXED_MATRICES_OF_DIFFERENT_SIZES);
+    }
+
+    BatchType identityBatch() const
+    {
+      BatchType id = BatchType::Zero(batchSize(), m_size*m_size);
+      for(Index i = 0; i < m_size; ++i)
+        id.col(i*(m_size+1)).setOnes();
+      return id;
+    }
+
+    BatchType m_matrix;
+    Matrix<Scalar,Dynamic,1> m_failures;
+    Index m_size;
+    bool m_isInitialized;
+};
+
+/** Computes the Cholesky decompositions of the matrices of \a batch, a B x n<sup>2</sup> batch of symmetric positive definite matrices.
+  *
+  * \returns a reference to *this
+  */
+template<typename MatrixType>
+template<typename InputType>
+BatchedLLT<MatrixType>& BatchedLLT<MatrixType>::compute(const MatrixBase<InputType>& batch)
+{
+  m_size = SizeAtCompileTime==Dynamic ? Index(std::sqrt(double(batch.cols())) + 0.5) : Index(SizeAtCompileTime);
+  eigen_assert(m_size*m_size == batch.cols() && "BatchedLLT: the batch must have n^2 columns");
+
+  m_matrix = batch;
+  m_failures.resize(m_matrix.rows());
+  internal::batched_run<Scalar>(
+      internal::batched_llt_factor_kernel<Scalar,SizeAtCompileTime>(
+          internal::batched_view<Scalar,SizeAtCompileTime>(m_matrix.data(), m_matrix.rows(), m_size), m_failures.data()),
+      m_matrix.rows());
+
+  m_isInitialized = true;
+  return *this;
+}
+
+template<typename MatrixType>
+template<typename Rhs>
+typename BatchedLLT<MatrixType>::BatchType BatchedLLT<MatrixType>::solve(const MatrixBase<Rhs>& rhs) const
+{
+  eigen_assert(m_isInitialized && "BatchedLLT is not initialized.");
+  eigen_assert(rhs.rows() == batchSize() && "BatchedLLT::solve(): invalid number of rows of the right hand side batch");
+  eigen_assert((m_size == 0 || rhs.cols() % m_size == 0) && "BatchedLLT::solve(): invalid number of columns of the right hand side batch");
+
+  BatchType dst = rhs;
+  if(m_size == 0)
+    return dst;
+  internal::batched_run<Scalar>(
+      internal::batched_llt_solve_kernel<Scalar,SizeAtCompileTime>(
+          internal::batched_view<const Scalar,SizeAtCompileTime>(m_matrix.data(), batchSize(), m_size),
+          internal::batched_view<Scalar,SizeAtCompileTime>(dst.data(), batchSize(), m_size), dst.cols() / m_size),
+      batchSize());
+  return dst;
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_LLT_H
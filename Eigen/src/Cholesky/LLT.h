@@ -56,6 +56,10 @@ template<typename MatrixType, int UpLo> struct LLT_Traits;
   * with the Upper triangular part. Otherwise, you might get a 20% slowdown for the full factorization
   * step, and rank-updates can be up to 3 times slower.
   *
+  * When several threads are available (see \ref TopicMultiThreading), matrices of size 512 and above are
+  * split into tiles, and the factorizations, triangular solves, and updates of the tiles are scheduled as
+  * soon as their dependencies are satisfied. This requires C++11 atomics.
+  *
   * This class supports the \link InplaceDecomposition inplace decomposition \endlink mechanism.
   *
   * Note that during the decomposition, only the lower (or upper, as defined by _UpLo) triangular part of A is considered.
@@ -306,6 +310,173 @@ static Index llt_rank_update_lower(MatrixType& mat, const VectorType& vec, const
   return -1;
 }
 
+#if EIGEN_HAS_CXX11_ATOMIC
+/** \internal Tiled, multi-threaded, variant of llt_inplace<Scalar,Lower>::blocked().
+  *
+  * The lower triangular part of the matrix is split into square tiles, and the factorization is
+  * expressed as a dependency graph of tile operations (POTRF of the diagonal tiles, TRSM of the
+  * off-diagonal ones, SYRK and GEMM updates). Each tile (i,j) holds the number of operations already
+  * applied to it: its j updates come first, and are followed by either its POTRF or its TRSM.
+  *
+  * The tasks are listed in a topological order which favors the critical path: the tiles of the next
+  * column are updated, factorized, and solved before the rest of the trailing matrix is updated. The
+  * threads pick the tasks in that order and wait for the dependencies of their current task, hence the
+  * next columns are processed while the other threads still update the trailing matrix.
+  */
+template<typename MatrixType> struct llt_tiled
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Block<MatrixType,Dynamic,Dynamic> TileType;
+  enum { Potrf, Trsm, Update };
+
+  static Index tileSize(Index size) { return size>=4096 ? 256 : 128; }
+
+  // whether the tiled algorithm is worth it: the matrix is large enough, and its tasks would run in parallel
+  static bool enabled(Index size)
+  {
+    if(size<512)
+      return false;
+    const Index ts = tileSize(size);
+    return parallelize_tasks_threads((size+ts-1)/ts)>1;
+  }
+
+  llt_tiled(MatrixType& m, Index tileSize)
+    : m_mat(m), m_tileSize(tileSize), m_nbTiles((m.rows()+tileSize-1)/tileSize),
+      m_done(0), m_next(0), m_failure(-1)
+  {}
+
+  Index tileStart(Index i) const { return i*m_tileSize; }
+  Index tileLength(Index i) const { return (std::min)(m_tileSize, m_mat.rows()-i*m_tileSize); }
+  TileType tile(Index i, Index j) const { return TileType(m_mat, tileStart(i), tileStart(j), tileLength(i), tileLength(j)); }
+  std::atomic<int>& done(Index i, Index j) const { return m_done[i+j*m_nbTiles]; }
+
+  void push(Index& count, Index type, Index i, Index j, Index k)
+  {
+    if(m_tasks.cols()>0)
+      m_tasks.col(count) << type, i, j, k;
+    ++count;
+  }
+
+  // lists the tasks in topological order, or only counts them if m_tasks is empty
+  Index schedule()
+  {
+    const Index T = m_nbTiles;
+    Index count = 0;
+    push(count, Potrf, 0, 0, 0);
+    for(Index i=1; i<T; ++i)
+      push(count, Trsm, i, 0, 0);
+    for(Index k=0; k+1<T; ++k)
+    {
+      // look-ahead: column k+1 is updated, factorized and solved first
+      for(Index i=k+1; i<T; ++i)
+        push(count, Update, i, k+1, k);
+      push(count, Potrf, k+1, k+1, k+1);
+      for(Index i=k+2; i<T; ++i)
+        push(count, Trsm, i, k+1, k+1);
+      // update of the rest of the trailing matrix
+      for(Index j=k+2; j<T; ++j)
+        for(Index i=j; i<T; ++i)
+          push(count, Update, i, j, k);
+    }
+    return count;
+  }
+
+  // waits until tile (i,j) has undergone at least n operations, returns false if the factorization failed
+  bool wait(Index i, Index j, Index n) const
+  {
+    // spin for a short while, since most dependencies are satisfied quickly, then leave the core to the
+    // threads which compute them
+    for(int spins=0; done(i,j).load(std::memory_order_acquire)<n; ++spins)
+    {
+      if(m_failure.load(std::memory_order_relaxed)>=0)
+        return false;
+      if(spins>=64)
+        std::this_thread::yield();
+    }
+    return true;
+  }
+
+  void run(Index t)
+  {
+    const Index type = m_tasks(0,t), i = m_tasks(1,t), j = m_tasks(2,t), k = m_tasks(3,t);
+    if(type==Potrf)
+    {
+      // A_kk = L_kk L_kk^*
+      if(!wait(k,k,k)) return;
+      TileType Akk = tile(k,k);
+      Matrix<Scalar,Dynamic,Dynamic> tmp(Akk);
+      Index ret = llt_inplace<Scalar,Lower>::blocked(tmp);
+      Akk = tmp;
+      if(ret>=0)
+      {
+        m_failure.store(tileStart(k)+ret);
+        return;
+      }
+    }
+    else if(type==Trsm)
+    {
+      // A_ik = A_ik L_kk^-*
+      if(!wait(i,k,k) || !wait(k,k,k+1)) return;
+      TileType Aik = tile(i,k);
+      tile(k,k).adjoint().template triangularView<Upper>().template solveInPlace<OnTheRight>(Aik);
+    }
+    else
+    {
+      // A_ij -= A_ik A_jk^*
+      if(!wait(i,j,k) || !wait(i,k,k+1) || !wait(j,k,k+1)) return;
+      TileType Aij = tile(i,j);
+      if(i==j)
+        Aij.template selfadjointView<Lower>().rankUpdate(tile(i,k), typename NumTraits<RealScalar>::Literal(-1));
+      else
+        Aij.noalias() -= tile(i,k) * tile(j,k).adjoint();
+    }
+    done(i,j).store(internal::convert_index<int>(k+1), std::memory_order_release);
+  }
+
+  // each worker repeatedly picks the next task of the schedule
+  struct worker
+  {
+    worker(llt_tiled& dag) : m_dag(dag) {}
+    void operator()(Index) const
+    {
+      const Index nb_tasks = m_dag.m_tasks.cols();
+      for(Index t=m_dag.m_next++; t<nb_tasks && m_dag.m_failure.load(std::memory_order_relaxed)<0; t=m_dag.m_next++)
+        m_dag.run(t);
+    }
+    llt_tiled& m_dag;
+  };
+
+  static Index compute(MatrixType& m)
+  {
+    const Index size = m.rows();
+    llt_tiled dag(m, tileSize(size));
+    const Index T = dag.m_nbTiles;
+    dag.m_tasks.resize(4, dag.schedule());
+    dag.schedule();
+
+    ei_declare_aligned_stack_constructed_variable(std::atomic<int>, done, T*T, 0);
+    for(Index i=0; i<T*T; ++i)
+      done[i].store(0, std::memory_order_relaxed);
+    dag.m_done = done;
+
+    // Since the tasks are picked in topological order and a worker only waits for the dependencies
+    // of its current task, the workers cannot deadlock, even if some of them start late.
+    const Index threads = (std::min)(Index(nbThreads()), T);
+    parallelize_tasks(threads, worker(dag));
+    return dag.m_failure.load();
+  }
+
+  MatrixType& m_mat;
+  const Index m_tileSize;
+  const Index m_nbTiles;
+  Matrix<Index,4,Dynamic> m_tasks;
+  std::atomic<int>* m_done;
+  std::atomic<Index> m_next;
+  std::atomic<Index> m_failure;
+};
+#endif
+
 template<typename Scalar> struct llt_inplace<Scalar, Lower>
 {
   typedef typename NumTraits<Scalar>::Real RealScalar;
@@ -343,6 +514,11 @@ template<typename Scalar> struct llt_inplace<Scalar, Lower>
     if(size<32)
       return unblocked(m);
 
+#if EIGEN_HAS_CXX11_ATOMIC
+    if(llt_tiled<MatrixType>::enabled(size))
+      return llt_tiled<MatrixType>::compute(m);
+#endif
+
     Index blockSize = size/8;
     blockSize = (blockSize/16)*16;
     blockSize = (std::min)((std::max)(blockSize,Index(8)), Index(128));
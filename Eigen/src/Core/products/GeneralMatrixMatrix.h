@@ -81,12 +81,13 @@ static void run(Index rows, Index cols, Index depth,
   gemm_pack_rhs<RhsScalar, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
   gebp_kernel<LhsScalar, RhsScalar, Index, ResMapper, Traits::mr, Traits::nr, ConjugateLhs, ConjugateRhs> gebp;
 
-#ifdef EIGEN_HAS_OPENMP
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_GEMM_THREADPOOL)
   if(info)
   {
     // this is the parallel version!
-    int tid = omp_get_thread_num();
-    int threads = omp_get_num_threads();
+    int tid = info->logical_thread_id;
+    int threads = info->num_threads;
+    GemmParallelTaskInfo<Index>* task_info = info->task_info;
 
     LhsScalar* blockA = blocking.blockA();
     eigen_internal_assert(blockA!=0);
@@ -107,15 +108,15 @@ static void run(Index rows, Index cols, Index depth,
       // each thread packs the sub block A_k,i to A'_i where i is the thread id.
 
       // However, before copying to A'_i, we have to make sure that no other thread is still using it,
-      // i.e., we test that info[tid].users equals 0.
-      // Then, we set info[tid].users to the number of threads to mark that all other threads are going to use it.
-      while(info[tid].users!=0) {}
-      info[tid].users = threads;
+      // i.e., we test that task_info[tid].users equals 0.
+      // Then, we set task_info[tid].users to the number of threads to mark that all other threads are going to use it.
+      while(task_info[tid].users!=0) {}
+      task_info[tid].users = threads;
 
-      pack_lhs(blockA+info[tid].lhs_start*actual_kc, lhs.getSubMapper(info[tid].lhs_start,k), actual_kc, info[tid].lhs_length);
+      pack_lhs(blockA+task_info[tid].lhs_start*actual_kc, lhs.getSubMapper(task_info[tid].lhs_start,k), actual_kc, task_info[tid].lhs_length);
 
       // Notify the other threads that the part A'_i is ready to go.
-      info[tid].sync = k;
+      task_info[tid].sync = k;
 
       // Computes C_i += A' * B' per A'_i
       for(int shift=0; shift<threads; ++shift)
@@ -126,11 +127,11 @@ static void run(Index rows, Index cols, Index depth,
         // we use testAndSetOrdered to mimic a volatile access.
         // However, no need to wait for the B' part which has been updated by the current thread!
         if (shift>0) {
-          while(info[i].sync!=k) {
+          while(task_info[i].sync!=k) {
           }
         }
 
-        gebp(res.getSubMapper(info[i].lhs_start, 0), blockA+info[i].lhs_start*actual_kc, blockB, info[i].lhs_length, actual_kc, nc, alpha);
+        gebp(res.getSubMapper(task_info[i].lhs_start, 0), blockA+task_info[i].lhs_start*actual_kc, blockB, task_info[i].lhs_length, actual_kc, nc, alpha);
       }
 
       // Then keep going as usual with the remaining B'
@@ -151,11 +152,11 @@ static void run(Index rows, Index cols, Index depth,
 #if !EIGEN_HAS_CXX11_ATOMIC
         #pragma omp atomic
 #endif
-        info[i].users -= 1;
+        task_info[i].users -= 1;
     }
   }
   else
-#endif // EIGEN_HAS_OPENMP
+#endif // EIGEN_HAS_OPENMP || EIGEN_HAS_GEMM_THREADPOOL
   {
     EIGEN_UNUSED_VARIABLE(info);
 
@@ -204,6 +205,123 @@ static void run(Index rows, Index cols, Index depth,
 
 };
 
+/*  Col-major destination and reduced precision scalars (half, bfloat16)
+ *    => the blocks of the operands are converted to float before being packed,
+ *       the float gebp kernel is used, and the products are accumulated in float
+ *       along the whole depth before being rounded once into the destination. */
+template<typename Index, typename Scalar, int LhsStorageOrder, int RhsStorageOrder, int ResInnerStride>
+struct reduced_precision_gemm
+{
+typedef gebp_traits<float,float> Traits;
+
+typedef Scalar ResScalar;
+static void run(Index rows, Index cols, Index depth,
+  const Scalar* lhs_, Index lhsStride,
+  const Scalar* rhs_, Index rhsStride,
+  Scalar* res_, Index resIncr, Index resStride,
+  Scalar alpha,
+  level3_blocking<Scalar,Scalar>& /*blocking*/,
+  GemmParallelInfo<Index>* /*info*/ = 0)
+{
+  // Each thread works on its own columns with its own buffers, hence there is no need
+  // to share the packed lhs through the parallel info (see gemm_uses_blocking_buffers).
+  typedef Map<const Matrix<Scalar,Dynamic,Dynamic,LhsStorageOrder>,0,OuterStride<> > LhsMap;
+  typedef Map<const Matrix<Scalar,Dynamic,Dynamic,RhsStorageOrder>,0,OuterStride<> > RhsMap;
+  typedef Map<Matrix<Scalar,Dynamic,Dynamic,ColMajor>,0,Stride<Dynamic,ResInnerStride> > ResMap;
+  typedef Map<Matrix<float,Dynamic,Dynamic,LhsStorageOrder> > LhsBlock;
+  typedef Map<Matrix<float,Dynamic,Dynamic,RhsStorageOrder> > RhsBlock;
+  typedef Map<Matrix<float,Dynamic,Dynamic,ColMajor> > AccBlock;
+  typedef const_blas_data_mapper<float, Index, LhsStorageOrder> LhsMapper;
+  typedef const_blas_data_mapper<float, Index, RhsStorageOrder> RhsMapper;
+  typedef blas_data_mapper<float, Index, ColMajor> AccMapper;
+
+  LhsMap lhs(lhs_, rows, depth, OuterStride<>(lhsStride));
+  RhsMap rhs(rhs_, depth, cols, OuterStride<>(rhsStride));
+  ResMap res(res_, rows, cols, Stride<Dynamic,ResInnerStride>(resStride, resIncr));
+
+  Index kc = depth, mc = rows, nc = cols;
+  computeProductBlockingSizes<float,float,1,Index>(kc, mc, nc, 1);
+
+  gemm_pack_lhs<float, Index, LhsMapper, Traits::mr, Traits::LhsProgress, typename Traits::LhsPacket4Packing, LhsStorageOrder> pack_lhs;
+  gemm_pack_rhs<float, Index, RhsMapper, Traits::nr, RhsStorageOrder> pack_rhs;
+  gebp_kernel<float, float, Index, AccMapper, Traits::mr, Traits::nr, false, false> gebp;
+
+  ei_declare_aligned_stack_constructed_variable(float, blockA, kc*mc, 0);
+  ei_declare_aligned_stack_constructed_variable(float, blockB, kc*nc, 0);
+  ei_declare_aligned_stack_constructed_variable(float, convA, kc*mc, 0);
+  ei_declare_aligned_stack_constructed_variable(float, convB, kc*nc, 0);
+  ei_declare_aligned_stack_constructed_variable(float, acc, mc*nc, 0);
+
+  const bool pack_once = kc==depth && nc==cols;
+  const float actualAlpha = static_cast<float>(alpha);
+
+  for(Index i2=0; i2<rows; i2+=mc)
+  {
+    const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+
+    for(Index j2=0; j2<cols; j2+=nc)
+    {
+      const Index actual_nc = (std::min)(j2+nc,cols)-j2;
+      AccBlock C(acc, actual_mc, actual_nc);
+      C.setZero();
+
+      for(Index k2=0; k2<depth; k2+=kc)
+      {
+        const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+
+        // The conversion keeps the storage order of the operands such that it runs on contiguous packets.
+        LhsBlock A(convA, actual_mc, actual_kc);
+        A = lhs.block(i2,k2,actual_mc,actual_kc).template cast<float>();
+        pack_lhs(blockA, LhsMapper(convA, LhsStorageOrder==ColMajor ? actual_mc : actual_kc), actual_kc, actual_mc);
+
+        // When the whole rhs fits in a single block, it is converted and packed only once.
+        if((!pack_once) || i2==0)
+        {
+          RhsBlock B(convB, actual_kc, actual_nc);
+          B = rhs.block(k2,j2,actual_kc,actual_nc).template cast<float>();
+          pack_rhs(blockB, RhsMapper(convB, RhsStorageOrder==ColMajor ? actual_kc : actual_nc), actual_kc, actual_nc);
+        }
+
+        gebp(AccMapper(acc, actual_mc), blockA, blockB, actual_mc, actual_kc, actual_nc, 1.f);
+      }
+
+      typename ResMap::BlockXpr R(res.block(i2,j2,actual_mc,actual_nc));
+      R = (R.template cast<float>() + actualAlpha * C).template cast<Scalar>();
+    }
+  }
+}
+};
+
+template<
+  typename Index,
+  int LhsStorageOrder, bool ConjugateLhs,
+  int RhsStorageOrder, bool ConjugateRhs,
+  int ResInnerStride>
+struct general_matrix_matrix_product<Index,half,LhsStorageOrder,ConjugateLhs,half,RhsStorageOrder,ConjugateRhs,ColMajor,ResInnerStride>
+  : reduced_precision_gemm<Index,half,LhsStorageOrder,RhsStorageOrder,ResInnerStride>
+{};
+
+template<
+  typename Index,
+  int LhsStorageOrder, bool ConjugateLhs,
+  int RhsStorageOrder, bool ConjugateRhs,
+  int ResInnerStride>
+struct general_matrix_matrix_product<Index,bfloat16,LhsStorageOrder,ConjugateLhs,bfloat16,RhsStorageOrder,ConjugateRhs,ColMajor,ResInnerStride>
+  : reduced_precision_gemm<Index,bfloat16,LhsStorageOrder,RhsStorageOrder,ResInnerStride>
+{};
+
+// Tells whether the Gemm kernel packs its operands into the buffers of its blocking, so that
+// they have to be allocated before a parallel session.
+template<typename Gemm> struct gemm_uses_blocking_buffers { enum { value = true }; };
+
+template<typename Index, int LhsStorageOrder, bool ConjugateLhs, int RhsStorageOrder, bool ConjugateRhs, int ResStorageOrder, int ResInnerStride>
+struct gemm_uses_blocking_buffers<general_matrix_matrix_product<Index,half,LhsStorageOrder,ConjugateLhs,half,RhsStorageOrder,ConjugateRhs,ResStorageOrder,ResInnerStride> >
+{ enum { value = false }; };
+
+template<typename Index, int LhsStorageOrder, bool ConjugateLhs, int RhsStorageOrder, bool ConjugateRhs, int ResStorageOrder, int ResInnerStride>
+struct gemm_uses_blocking_buffers<general_matrix_matrix_product<Index,bfloat16,LhsStorageOrder,ConjugateLhs,bfloat16,RhsStorageOrder,ConjugateRhs,ResStorageOrder,ResInnerStride> >
+{ enum { value = false }; };
+
 /*********************************************************************************
 *  Specialization of generic_product_impl for "large" GEMM, i.e.,
 *  implementation of the high level wrapper to general_matrix_matrix_product
@@ -219,7 +337,8 @@ struct gemm_functor
   void initParallelSession(Index num_threads) const
   {
     m_blocking.initParallel(m_lhs.rows(), m_rhs.cols(), m_lhs.cols(), num_threads);
-    m_blocking.allocateA();
+    if(gemm_uses_blocking_buffers<Gemm>::value)
+      m_blocking.allocateA();
   }
 
   void operator() (Index row, Index rows, Index col=0, Index cols=-1, GemmParallelInfo<Index>* info=0) const
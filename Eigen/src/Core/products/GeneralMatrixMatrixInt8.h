@@ -0,0 +1,406 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_GENERAL_MATRIX_MATRIX_INT8_H
+#define EIGEN_GENERAL_MATRIX_MATRIX_INT8_H
+
+namespace Eigen {
+
+namespace internal {
+
+/* Kernels for products of 8-bit integer matrices accumulated in 32-bit integers,
+ * that is for expressions like A.cast<int>() * B.cast<int>() with int8_t or uint8_t
+ * operands.
+ *
+ * The packed blocks store pairs of consecutive coefficients along the depth,
+ * widened to 16 bits, in one 32-bit word. The micro kernel multiplies a packet of
+ * such pairs of the lhs with a broadcast pair of the rhs and sums each pair of products
+ * into 32-bit lanes (pmaddwd, or vpdpwssd with AVX512-VNNI). The 16-bit products of
+ * 8-bit values cannot overflow, so the result is exactly the one of the int32 product.
+ */
+template<typename Scalar> struct is_int8_gemm_scalar { enum { value = 0 }; };
+template<> struct is_int8_gemm_scalar<numext::int8_t>  { enum { value = 1 }; };
+template<> struct is_int8_gemm_scalar<numext::uint8_t> { enum { value = 1 }; };
+
+struct int8_gemm_traits
+{
+#if defined(EIGEN_VECTORIZE_AVX512BW)
+  typedef Packet16i Packet;
+  enum { nr = 8 };
+#elif defined(EIGEN_VECTORIZE_AVX2)
+  typedef Packet8i Packet;
+  enum { nr = 6 };
+#elif defined(EIGEN_VECTORIZE_SSE2)
+  typedef Packet4i Packet;
+  enum { nr = 6 };
+#else
+  typedef int Packet;
+  enum { nr = 4 };
+#endif
+  enum {
+    PacketSize = unpacket_traits<Packet>::size,
+    LhsPackets = 2,
+    mr = LhsPackets*PacketSize
+  };
+
+  // c + a[2i]*b[2i] + a[2i+1]*b[2i+1] on the 16-bit halves of each 32-bit lane
+  static EIGEN_STRONG_INLINE Packet madd(const Packet& a, const Packet& b, const Packet& c)
+  {
+#if defined(EIGEN_VECTORIZE_AVX512BW) && defined(EIGEN_VECTORIZE_AVX512VNNI)
+    return _mm512_dpwssd_epi32(c, a, b);
+#elif defined(EIGEN_VECTORIZE_AVX512BW)
+    return _mm512_add_epi32(c, _mm512_madd_epi16(a, b));
+#elif defined(EIGEN_VECTORIZE_AVX2)
+    return _mm256_add_epi32(c, _mm256_madd_epi16(a, b));
+#elif defined(EIGEN_VECTORIZE_SSE2)
+    return _mm_add_epi32(c, _mm_madd_epi16(a, b));
+#else
+    return c + int(numext::int16_t(a & 0xffff)) * int(numext::int16_t(b & 0xffff))
+             + int(numext::int16_t((a >> 16) & 0xffff)) * int(numext::int16_t((b >> 16) & 0xffff));
+#endif
+  }
+
+  // packs two coefficients along the depth into a 32-bit word
+  static EIGEN_STRONG_INLINE int pair(int lo, int hi)
+  {
+    return numext::bit_cast<int>(numext::uint32_t(numext::uint16_t(numext::int16_t(lo)))
+                              | (numext::uint32_t(numext::uint16_t(numext::int16_t(hi))) << 16));
+  }
+
+  template<typename Index>
+  static Index pairs(Index depth) { return (depth+1)/2; }
+};
+
+/* Packs a rows x depth block of the lhs into panels of mr rows, the last panel
+ * being padded with zeros. Each panel stores, for each pair of columns, mr words. */
+template<typename Index, typename DataMapper>
+struct int8_gemm_pack_lhs
+{
+  typedef int8_gemm_traits Traits;
+  EIGEN_DONT_INLINE void operator()(int* blockA, const DataMapper& lhs, Index depth, Index rows) const
+  {
+    const Index pairs = Traits::pairs(depth);
+    for(Index i0=0; i0<rows; i0+=Traits::mr)
+    {
+      const Index actual_mr = (std::min)(Index(Traits::mr), rows-i0);
+      int* panel = blockA + i0*pairs;
+      for(Index p=0; p<pairs; ++p)
+      {
+        const Index k = 2*p;
+        int* dst = panel + p*Traits::mr;
+        if(k+1<depth)
+          for(Index r=0; r<actual_mr; ++r)
+            dst[r] = Traits::pair(lhs(i0+r,k), lhs(i0+r,k+1));
+        else
+          for(Index r=0; r<actual_mr; ++r)
+            dst[r] = Traits::pair(lhs(i0+r,k), 0);
+        for(Index r=actual_mr; r<Traits::mr; ++r)
+          dst[r] = 0;
+      }
+    }
+  }
+};
+
+/* Packs a depth x cols block of the rhs into panels of nr columns, the last panel
+ * being padded with zeros. Each panel stores, for each pair of rows, nr words. */
+template<typename Index, typename DataMapper>
+struct int8_gemm_pack_rhs
+{
+  typedef int8_gemm_traits Traits;
+  EIGEN_DONT_INLINE void operator()(int* blockB, const DataMapper& rhs, Index depth, Index cols) const
+  {
+    const Index pairs = Traits::pairs(depth);
+    for(Index j0=0; j0<cols; j0+=Traits::nr)
+    {
+      const Index actual_nr = (std::min)(Index(Traits::nr), cols-j0);
+      int* panel = blockB + j0*pairs;
+      for(Index c=0; c<actual_nr; ++c)
+      {
+        for(Index p=0; p<pairs; ++p)
+        {
+          const Index k = 2*p;
+          panel[p*Traits::nr+c] = Traits::pair(rhs(k,j0+c), k+1<depth ? rhs(k+1,j0+c) : 0);
+        }
+      }
+      for(Index c=actual_nr; c<Traits::nr; ++c)
+        for(Index p=0; p<pairs; ++p)
+          panel[p*Traits::nr+c] = 0;
+    }
+  }
+};
+
+/* Computes res += alpha * A' * B' for blocks packed by int8_gemm_pack_lhs and
+ * int8_gemm_pack_rhs. DataMapper is a column-major blas_data_mapper on int. */
+template<typename Index, typename DataMapper>
+struct int8_gebp_kernel
+{
+  typedef int8_gemm_traits Traits;
+  typedef Traits::Packet Packet;
+  enum { PacketSize = Traits::PacketSize, LhsPackets = Traits::LhsPackets, mr = Traits::mr, nr = Traits::nr };
+
+  EIGEN_DONT_INLINE void operator()(const DataMapper& res, const int* blockA, const int* blockB,
+                                    Index rows, Index depth, Index cols, int alpha) const
+  {
+    const Index pairs = Traits::pairs(depth);
+    const Packet pAlpha = pset1<Packet>(alpha);
+    for(Index j=0; j<cols; j+=nr)
+    {
+      const int* B = blockB + j*pairs;
+      const Index actual_nr = (std::min)(Index(nr), cols-j);
+      for(Index i=0; i<rows; i+=mr)
+      {
+        const int* A = blockA + i*pairs;
+        const Index actual_mr = (std::min)(Index(mr), rows-i);
+
+        Packet acc[LhsPackets][nr];
+        for(int c=0; c<nr; ++c)
+          for(int r=0; r<LhsPackets; ++r)
+            acc[r][c] = pzero(pAlpha);
+
+        for(Index p=0; p<pairs; ++p)
+        {
+          Packet a[LhsPackets];
+          for(int r=0; r<LhsPackets; ++r)
+            a[r] = ploadu<Packet>(A + p*mr + r*PacketSize);
+          for(int c=0; c<nr; ++c)
+          {
+            const Packet b = pset1<Packet>(B[p*nr+c]);
+            for(int r=0; r<LhsPackets; ++r)
+              acc[r][c] = Traits::madd(a[r], b, acc[r][c]);
+          }
+        }
+
+        if(actual_mr==mr && actual_nr==nr)
+        {
+          for(int c=0; c<nr; ++c)
+            for(int r=0; r<LhsPackets; ++r)
+            {
+              int* dst = &res(i+r*PacketSize, j+c);
+              pstoreu(dst, padd(ploadu<Packet>(dst), pmul(pAlpha, acc[r][c])));
+            }
+        }
+        else
+        {
+          EIGEN_ALIGN_MAX int tmp[mr];
+          for(Index c=0; c<actual_nr; ++c)
+          {
+            for(int r=0; r<LhsPackets; ++r)
+              pstore(tmp + r*PacketSize, acc[r][c]);
+            for(Index r=0; r<actual_mr; ++r)
+              res(i+r, j+c) += alpha * tmp[r];
+          }
+        }
+      }
+    }
+  }
+};
+
+/* Column-major int32 destination, 8-bit operands: blocked algorithm following the
+ * one of general_matrix_matrix_product, with the int8 packing and micro kernel. */
+template<typename Index, typename LhsScalar, int LhsStorageOrder, typename RhsScalar, int RhsStorageOrder>
+struct general_matrix_matrix_product_int8
+{
+  typedef int8_gemm_traits Traits;
+
+  static void run(Index rows, Index cols, Index depth,
+    const LhsScalar* lhs_, Index lhsStride,
+    const RhsScalar* rhs_, Index rhsStride,
+    int* res_, Index resStride, int alpha)
+  {
+    typedef const_blas_data_mapper<LhsScalar, Index, LhsStorageOrder> LhsMapper;
+    typedef const_blas_data_mapper<RhsScalar, Index, RhsStorageOrder> RhsMapper;
+    typedef blas_data_mapper<int, Index, ColMajor> ResMapper;
+    LhsMapper lhs(lhs_, lhsStride);
+    RhsMapper rhs(rhs_, rhsStride);
+    ResMapper res(res_, resStride);
+
+    Index kc = depth, mc = rows, nc = cols;
+    computeProductBlockingSizes<numext::int16_t,numext::int16_t,1,Index>(kc, mc, nc, 1);
+    kc = numext::mini<Index>(depth, 2*Traits::pairs(kc));
+    mc = numext::mini<Index>(rows, ((mc+Traits::mr-1)/Traits::mr)*Traits::mr);
+    nc = numext::mini<Index>(cols, ((nc+Traits::nr-1)/Traits::nr)*Traits::nr);
+
+    int8_gemm_pack_lhs<Index, LhsMapper> pack_lhs;
+    int8_gemm_pack_rhs<Index, RhsMapper> pack_rhs;
+    int8_gebp_kernel<Index, ResMapper> gebp;
+
+    const Index sizeA = Traits::pairs(kc) * (((mc+Traits::mr-1)/Traits::mr)*Traits::mr);
+    const Index sizeB = Traits::pairs(kc) * (((nc+Traits::nr-1)/Traits::nr)*Traits::nr);
+    ei_declare_aligned_stack_constructed_variable(int, blockA, sizeA, 0);
+    ei_declare_aligned_stack_constructed_variable(int, blockB, sizeB, 0);
+
+    const bool pack_rhs_once = mc!=rows && kc==depth && nc==cols;
+
+    for(Index i2=0; i2<rows; i2+=mc)
+    {
+      const Index actual_mc = (std::min)(i2+mc,rows)-i2;
+
+      for(Index k2=0; k2<depth; k2+=kc)
+      {
+        const Index actual_kc = (std::min)(k2+kc,depth)-k2;
+
+        pack_lhs(blockA, lhs.getSubMapper(i2,k2), actual_kc, actual_mc);
+
+        for(Index j2=0; j2<cols; j2+=nc)
+        {
+          const Index actual_nc = (std::min)(j2+nc,cols)-j2;
+
+          if((!pack_rhs_once) || i2==0)
+            pack_rhs(blockB, rhs.getSubMapper(k2,j2), actual_kc, actual_nc);
+
+          gebp(res.getSubMapper(i2, j2), blockA, blockB, actual_mc, actual_kc, actual_nc, alpha);
+        }
+      }
+    }
+  }
+};
+
+template<typename Lhs, typename Rhs, typename Dest, bool Transpose>
+struct int8_gemm_functor
+{
+  typedef int8_gemm_traits Traits;
+
+  int8_gemm_functor(const Lhs& lhs, const Rhs& rhs, Dest& dest, int alpha)
+    : m_lhs(lhs), m_rhs(rhs), m_dest(dest), m_alpha(alpha)
+  {}
+
+  void initParallelSession(Index /*num_threads*/) const {}
+
+  void operator() (Index row, Index rows, Index col=0, Index cols=-1, GemmParallelInfo<Index>* /*info*/=0) const
+  {
+    // Each thread packs its own blocks of the lhs.
+    if(cols==-1)
+      cols = m_rhs.cols();
+    // A row-major destination is handled as the column-major destination of the transposed product.
+    if(Transpose)
+      general_matrix_matrix_product_int8<Index,
+          typename Rhs::Scalar, (Rhs::Flags&RowMajorBit) ? ColMajor : RowMajor,
+          typename Lhs::Scalar, (Lhs::Flags&RowMajorBit) ? ColMajor : RowMajor>
+        ::run(cols, rows, m_lhs.cols(),
+              &m_rhs.coeffRef(0,col), m_rhs.outerStride(),
+              &m_lhs.coeffRef(row,0), m_lhs.outerStride(),
+              &m_dest.coeffRef(row,col), m_dest.outerStride(), m_alpha);
+    else
+      general_matrix_matrix_product_int8<Index,
+          typename Lhs::Scalar, (Lhs::Flags&RowMajorBit) ? RowMajor : ColMajor,
+          typename Rhs::Scalar, (Rhs::Flags&RowMajorBit) ? RowMajor : ColMajor>
+        ::run(rows, cols, m_lhs.cols(),
+              &m_lhs.coeffRef(row,0), m_lhs.outerStride(),
+              &m_rhs.coeffRef(0,col), m_rhs.outerStride(),
+              &m_dest.coeffRef(row,col), m_dest.outerStride(), m_alpha);
+  }
+
+  protected:
+    const Lhs& m_lhs;
+    const Rhs& m_rhs;
+    Dest& m_dest;
+    int m_alpha;
+};
+
+/* Large products of 8-bit matrices cast to int. The operands are read as 8-bit
+ * integers (they are evaluated into 8-bit temporaries if they do not have a direct
+ * access), and the products go through the int8 kernels above. */
+template<typename Lhs, typename Rhs>
+struct int8_gemm_product_impl
+  : generic_product_impl_base<Lhs,Rhs,int8_gemm_product_impl<Lhs,Rhs> >
+{
+  typedef int Scalar;
+  typedef typename Lhs::NestedExpression LhsArg;
+  typedef typename Rhs::NestedExpression RhsArg;
+  typedef typename LhsArg::Scalar LhsScalar;
+  typedef typename RhsArg::Scalar RhsScalar;
+  typedef Ref<const Matrix<LhsScalar,Dynamic,Dynamic,(LhsArg::Flags&RowMajorBit) ? RowMajor : ColMajor>,0,OuterStride<> > ActualLhsType;
+  typedef Ref<const Matrix<RhsScalar,Dynamic,Dynamic,(RhsArg::Flags&RowMajorBit) ? RowMajor : ColMajor>,0,OuterStride<> > ActualRhsType;
+
+  typedef generic_product_impl<Lhs,Rhs,DenseShape,DenseShape,CoeffBasedProductMode> lazyproduct;
+
+  template<typename Dst>
+  static void evalTo(Dst& dst, const Lhs& lhs, const Rhs& rhs)
+  {
+    if((rhs.rows()+dst.rows()+dst.cols())<EIGEN_GEMM_TO_COEFFBASED_THRESHOLD && rhs.rows()>0)
+      lazyproduct::eval_dynamic(dst, lhs, rhs, assign_op<typename Dst::Scalar,Scalar>());
+    else
+    {
+      dst.setZero();
+      scaleAndAddTo(dst, lhs, rhs, Scalar(1));
+    }
+  }
+
+  template<typename Dst>
+  static void addTo(Dst& dst, const Lhs& lhs, const Rhs& rhs)
+  {
+    if((rhs.rows()+dst.rows()+dst.cols())<EIGEN_GEMM_TO_COEFFBASED_THRESHOLD && rhs.rows()>0)
+      lazyproduct::eval_dynamic(dst, lhs, rhs, add_assign_op<typename Dst::Scalar,Scalar>());
+    else
+      scaleAndAddTo(dst, lhs, rhs, Scalar(1));
+  }
+
+  template<typename Dst>
+  static void subTo(Dst& dst, const Lhs& lhs, const Rhs& rhs)
+  {
+    if((rhs.rows()+dst.rows()+dst.cols())<EIGEN_GEMM_TO_COEFFBASED_THRESHOLD && rhs.rows()>0)
+      lazyproduct::eval_dynamic(dst, lhs, rhs, sub_assign_op<typename Dst::Scalar,Scalar>());
+    else
+      scaleAndAddTo(dst, lhs, rhs, Scalar(-1));
+  }
+
+  template<typename Dest>
+  static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs, const Scalar& alpha)
+  {
+    eigen_assert(dst.rows()==lhs.rows() && dst.cols()==rhs.cols());
+    if(lhs.cols()==0 || lhs.rows()==0 || rhs.cols()==0)
+      return;
+
+    if (dst.cols() == 1)
+    {
+      typename Dest::ColXpr dst_vec(dst.col(0));
+      return generic_product_impl<Lhs,typename Rhs::ConstColXpr,DenseShape,DenseShape,GemvProduct>
+        ::scaleAndAddTo(dst_vec, lhs, rhs.col(0), alpha);
+    }
+    else if (dst.rows() == 1)
+    {
+      typename Dest::RowXpr dst_vec(dst.row(0));
+      return generic_product_impl<typename Lhs::ConstRowXpr,Rhs,DenseShape,DenseShape,GemvProduct>
+        ::scaleAndAddTo(dst_vec, lhs.row(0), rhs, alpha);
+    }
+
+    if(Dest::InnerStrideAtCompileTime!=1)
+    {
+      Matrix<int,Dynamic,Dynamic> tmp(Matrix<int,Dynamic,Dynamic>::Zero(dst.rows(), dst.cols()));
+      scaleAndAddTo(tmp, lhs, rhs, alpha);
+      dst += tmp;
+      return;
+    }
+
+    ActualLhsType actualLhs(lhs.nestedExpression());
+    ActualRhsType actualRhs(rhs.nestedExpression());
+
+    enum { Transpose = (Dest::Flags&RowMajorBit) ? 1 : 0 };
+    typedef int8_gemm_functor<ActualLhsType,ActualRhsType,Dest,bool(Transpose)> Functor;
+    parallelize_gemm<(Dest::MaxRowsAtCompileTime>32 || Dest::MaxRowsAtCompileTime==Dynamic)>
+        (Functor(actualLhs, actualRhs, dst, alpha), lhs.rows(), rhs.cols(), lhs.cols(), bool(Transpose));
+  }
+};
+
+#define EIGEN_INT8_GEMM_PRODUCT(LHS,RHS) \
+template<typename LhsArg, typename RhsArg> \
+struct generic_product_impl<CwiseUnaryOp<scalar_cast_op<LHS,int>,LhsArg>,CwiseUnaryOp<scalar_cast_op<RHS,int>,RhsArg>,DenseShape,DenseShape,GemmProduct> \
+  : int8_gemm_product_impl<CwiseUnaryOp<scalar_cast_op<LHS,int>,LhsArg>,CwiseUnaryOp<scalar_cast_op<RHS,int>,RhsArg> > \
+{};
+
+EIGEN_INT8_GEMM_PRODUCT(numext::int8_t,  numext::int8_t)
+EIGEN_INT8_GEMM_PRODUCT(numext::int8_t,  numext::uint8_t)
+EIGEN_INT8_GEMM_PRODUCT(numext::uint8_t, numext::int8_t)
+EIGEN_INT8_GEMM_PRODUCT(numext::uint8_t, numext::uint8_t)
+
+#undef EIGEN_INT8_GEMM_PRODUCT
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_GENERAL_MATRIX_MATRIX_INT8_H
@@ -12,10 +12,57 @@
 
 #if EIGEN_HAS_CXX11_ATOMIC
 #include <atomic>
+#include <thread>
+#endif
+
+#if defined(EIGEN_HAS_OPENMP) && defined(EIGEN_HAS_GEMM_THREADPOOL)
+#error EIGEN_GEMM_THREADPOOL cannot be used together with OpenMP, define EIGEN_DONT_PARALLELIZE or disable OpenMP
 #endif
 
 namespace Eigen {
 
+#ifdef EIGEN_HAS_GEMM_THREADPOOL
+namespace internal {
+
+/** \internal */
+inline std::atomic<ThreadPoolInterface*>& gemm_thread_pool()
+{
+  static std::atomic<ThreadPoolInterface*> pool(0);
+  return pool;
+}
+
+/** \internal Set while a parallel session owns the thread pool. The GEMM tasks
+  * busy-wait on each other, hence they must all be running at the same time,
+  * which cannot be guaranteed if several sessions share the pool. */
+inline std::atomic<bool>& gemm_thread_pool_busy()
+{
+  static std::atomic<bool> busy(false);
+  return busy;
+}
+
+}
+
+/** Sets the thread pool used by %Eigen to run its parallel algorithms.
+  *
+  * Passing a null pointer restores the sequential behavior. The pool is not owned by %Eigen,
+  * and must outlive all the operations started while it is registered.
+  * This function must not be called while a parallel operation is running.
+  *
+  * This function is only available when \c EIGEN_GEMM_THREADPOOL is defined.
+  * \sa getGemmThreadPool, setNbThreads */
+inline void setGemmThreadPool(ThreadPoolInterface* pool)
+{
+  internal::gemm_thread_pool().store(pool);
+}
+
+/** \returns the thread pool used by %Eigen to run its parallel algorithms, or a null pointer if none
+  * \sa setGemmThreadPool */
+inline ThreadPoolInterface* getGemmThreadPool()
+{
+  return internal::gemm_thread_pool().load();
+}
+#endif // EIGEN_HAS_GEMM_THREADPOOL
+
 namespace internal {
 
 /** \internal */
@@ -32,11 +79,16 @@ inline void manage_multi_threading(Action action, int* v)
   else if(action==GetAction)
   {
     eigen_internal_assert(v!=0);
-    #ifdef EIGEN_HAS_OPENMP
+    #if defined(EIGEN_HAS_OPENMP)
     if(m_maxThreads>0)
       *v = m_maxThreads;
     else
       *v = omp_get_max_threads();
+    #elif defined(EIGEN_HAS_GEMM_THREADPOOL)
+    // The calling thread takes part in the computation, hence at most NumThreads()+1 threads are used.
+    ThreadPoolInterface* pool = getGemmThreadPool();
+    int pool_threads = pool ? pool->NumThreads()+1 : 1;
+    *v = m_maxThreads>0 ? (std::min)(m_maxThreads, pool_threads) : pool_threads;
     #else
     *v = 1;
     #endif
@@ -76,9 +128,9 @@ inline void setNbThreads(int v)
 
 namespace internal {
 
-template<typename Index> struct GemmParallelInfo
+template<typename Index> struct GemmParallelTaskInfo
 {
-  GemmParallelInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
+  GemmParallelTaskInfo() : sync(-1), users(0), lhs_start(0), lhs_length(0) {}
 
   // volatile is not enough on all architectures (see bug 1572)
   // to guarantee that when thread A says to thread B that it is
@@ -96,6 +148,33 @@ template<typename Index> struct GemmParallelInfo
   Index lhs_length;
 };
 
+/** \internal Describes the share of a parallel product assigned to one thread:
+  * its logical id, the number of threads taking part in the product,
+  * and the per-thread synchronization data shared by all of them. */
+template<typename Index> struct GemmParallelInfo
+{
+  GemmParallelInfo(int logical_thread_id_, int num_threads_, GemmParallelTaskInfo<Index>* task_info_)
+    : logical_thread_id(logical_thread_id_), num_threads(num_threads_), task_info(task_info_) {}
+
+  const int logical_thread_id;
+  const int num_threads;
+  GemmParallelTaskInfo<Index>* task_info;
+};
+
+#ifdef EIGEN_HAS_GEMM_THREADPOOL
+/** \internal Runs \a func(i) for i in [0,n): the first n-1 calls are scheduled on \a pool,
+  * the last one is executed by the calling thread, and the function returns once all of them completed. */
+template<typename Func>
+void run_on_thread_pool(ThreadPoolInterface* pool, int n, const Func& func)
+{
+  Barrier barrier(static_cast<unsigned int>(n-1));
+  for(int i=0; i<n-1; ++i)
+    pool->Schedule([&func, &barrier, i]() { func(i); barrier.Notify(); });
+  func(n-1);
+  barrier.Wait();
+}
+#endif
+
 template<bool Condition, typename Functor, typename Index>
 void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth, bool transpose)
 {
@@ -104,7 +183,7 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   // Without C++11, we have to disable GEMM's parallelization on
   // non x86 architectures because there volatile is not enough for our purpose.
   // See bug 1572.
-#if (! defined(EIGEN_HAS_OPENMP)) || defined(EIGEN_USE_BLAS) || ((!EIGEN_HAS_CXX11_ATOMIC) && !(EIGEN_ARCH_i386_OR_x86_64))
+#if (!defined(EIGEN_HAS_OPENMP) && !defined(EIGEN_HAS_GEMM_THREADPOOL)) || defined(EIGEN_USE_BLAS) || ((!EIGEN_HAS_CXX11_ATOMIC) && !(EIGEN_ARCH_i386_OR_x86_64))
   // FIXME the transpose variable is only needed to properly split
   // the matrix product when multithreading is enabled. This is a temporary
   // fix to support row-major destination matrices. This whole
@@ -114,7 +193,7 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   func(0,rows, 0,cols);
 #else
 
-  // Dynamically check whether we should enable or disable OpenMP.
+  // Dynamically check whether we should enable or disable multi-threading.
   // The conditions are:
   // - the max number of threads we can create is greater than 1
   // - we are not already in a parallel code
@@ -136,9 +215,19 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
 
   // if multi-threading is explicitly disabled, not useful, or if we already are in a parallel session,
   // then abort multi-threading
-  // FIXME omp_get_num_threads()>1 only works for openmp, what if the user does not use openmp?
-  if((!Condition) || (threads==1) || (omp_get_num_threads()>1))
+  if((!Condition) || (threads==1))
+    return func(0,rows, 0,cols);
+#if defined(EIGEN_HAS_OPENMP)
+  if(omp_get_num_threads()>1)
     return func(0,rows, 0,cols);
+#else
+  // Nested parallelism is not allowed: a product issued from a thread of the pool
+  // would wait for tasks queued behind itself. Likewise, only one parallel product
+  // at a time may own the pool.
+  ThreadPoolInterface* pool = getGemmThreadPool();
+  if(pool==0 || pool->CurrentThreadId()!=-1 || gemm_thread_pool_busy().exchange(true))
+    return func(0,rows, 0,cols);
+#endif
 
   Eigen::initParallel();
   func.initParallelSession(threads);
@@ -146,13 +235,21 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
   if(transpose)
     std::swap(rows,cols);
 
-  ei_declare_aligned_stack_constructed_variable(GemmParallelInfo<Index>,info,threads,0);
+  ei_declare_aligned_stack_constructed_variable(GemmParallelTaskInfo<Index>,task_info,threads,0);
 
+#if defined(EIGEN_HAS_OPENMP)
   #pragma omp parallel num_threads(threads)
   {
     Index i = omp_get_thread_num();
     // Note that the actual number of threads might be lower than the number of request ones.
     Index actual_threads = omp_get_num_threads();
+    GemmParallelInfo<Index> info(internal::convert_index<int>(i), internal::convert_index<int>(actual_threads), task_info);
+#else
+  run_on_thread_pool(pool, internal::convert_index<int>(threads), [&](int i)
+  {
+    Index actual_threads = threads;
+    GemmParallelInfo<Index> info(i, internal::convert_index<int>(actual_threads), task_info);
+#endif
 
     Index blockCols = (cols / actual_threads) & ~Index(0x3);
     Index blockRows = (rows / actual_threads);
@@ -164,13 +261,77 @@ void parallelize_gemm(const Functor& func, Index rows, Index cols, Index depth,
     Index c0 = i*blockCols;
     Index actualBlockCols = (i+1==actual_threads) ? cols-c0 : blockCols;
 
-    info[i].lhs_start = r0;
-    info[i].lhs_length = actualBlockRows;
+    task_info[i].lhs_start = r0;
+    task_info[i].lhs_length = actualBlockRows;
 
-    if(transpose) func(c0, actualBlockCols, 0, rows, info);
-    else          func(0, rows, c0, actualBlockCols, info);
+    if(transpose) func(c0, actualBlockCols, 0, rows, &info);
+    else          func(0, rows, c0, actualBlockCols, &info);
+#if defined(EIGEN_HAS_OPENMP)
+  }
+#else
+  });
+  gemm_thread_pool_busy().store(false);
+#endif
+#endif
+}
+
+/** \internal \returns the number of threads parallelize_tasks() would use for \a num_tasks tasks if it were
+  * called now, or 1 if it would run them sequentially: because multi-threading is disabled, or because we are
+  * already in a parallel session. Callers can check it to avoid setting up per-thread buffers for nothing.
+  */
+inline Index parallelize_tasks_threads(Index num_tasks)
+{
+#if defined(EIGEN_HAS_OPENMP)
+  Index threads = std::min<Index>(nbThreads(), num_tasks);
+  return (threads>1 && omp_get_num_threads()==1) ? threads : 1;
+#elif defined(EIGEN_HAS_GEMM_THREADPOOL)
+  Index threads = std::min<Index>(nbThreads(), num_tasks);
+  ThreadPoolInterface* pool = getGemmThreadPool();
+  return (threads>1 && pool!=0 && pool->CurrentThreadId()==-1 && !gemm_thread_pool_busy().load()) ? threads : 1;
+#else
+  EIGEN_UNUSED_VARIABLE(num_tasks);
+  return 1;
+#endif
+}
+
+/** \internal Calls \a func(i) for each i in [0,num_tasks) and returns once all calls completed.
+  *
+  * The tasks must be independent from each other. They are dynamically distributed over at most
+  * nbThreads() threads, in increasing order of \a i, so that the most expensive ones should come first.
+  * The tasks are executed sequentially by the calling thread if multi-threading is disabled, or if
+  * we already are in a parallel session. In the latter case, nested products are sequential too.
+  *
+  * \sa parallelize_tasks_threads()
+  */
+template<typename Func>
+void parallelize_tasks(Index num_tasks, const Func& func)
+{
+#if defined(EIGEN_HAS_OPENMP)
+  Index threads = parallelize_tasks_threads(num_tasks);
+  if(threads>1)
+  {
+    #pragma omp parallel for schedule(dynamic,1) num_threads(threads)
+    for(Index i=0; i<num_tasks; ++i)
+      func(i);
+    return;
+  }
+#elif defined(EIGEN_HAS_GEMM_THREADPOOL)
+  Index threads = parallelize_tasks_threads(num_tasks);
+  ThreadPoolInterface* pool = getGemmThreadPool();
+  if(threads>1 && !gemm_thread_pool_busy().exchange(true))
+  {
+    std::atomic<Index> next(0);
+    run_on_thread_pool(pool, internal::convert_index<int>(threads), [&](int)
+    {
+      for(Index i=next++; i<num_tasks; i=next++)
+        func(i);
+    });
+    gemm_thread_pool_busy().store(false);
+    return;
   }
 #endif
+  for(Index i=0; i<num_tasks; ++i)
+    func(i);
 }
 
 } // end namespace internal
@@ -10,8 +10,8 @@
 // Barrier is an object that allows one or more threads to wait until
 // Notify has been called a specified number of times.
 
-#ifndef EIGEN_CXX11_THREADPOOL_BARRIER_H
-#define EIGEN_CXX11_THREADPOOL_BARRIER_H
+#ifndef EIGEN_BARRIER_H
+#define EIGEN_BARRIER_H
 
 namespace Eigen {
 
@@ -64,4 +64,4 @@ struct Notification : Barrier {
 
 }  // namespace Eigen
 
-#endif  // EIGEN_CXX11_THREADPOOL_BARRIER_H
+#endif  // EIGEN_BARRIER_H
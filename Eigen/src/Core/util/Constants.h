@@ -415,7 +415,10 @@ enum DecompositionOptions {
     * solve the generalized eigenproblem \f$ BAx = \lambda x \f$. */
   BAx_lx              = 0x400,
   /** \internal */
-  GenEigMask = Ax_lBx | ABx_lx | BAx_lx
+  GenEigMask = Ax_lBx | ABx_lx | BAx_lx,
+  /** Used in SelfAdjointEigenSolver and GeneralizedSelfAdjointEigenSolver to compute the eigenvectors
+    * of the tridiagonal matrix with the divide-and-conquer algorithm instead of the implicit QR algorithm. */
+  DivideAndConquer    = 0x800
 };
 
 /** \ingroup enums
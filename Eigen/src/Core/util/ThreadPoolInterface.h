@@ -7,8 +7,8 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
-#ifndef EIGEN_CXX11_THREADPOOL_THREAD_POOL_INTERFACE_H
-#define EIGEN_CXX11_THREADPOOL_THREAD_POOL_INTERFACE_H
+#ifndef EIGEN_THREAD_POOL_INTERFACE_H
+#define EIGEN_THREAD_POOL_INTERFACE_H
 
 namespace Eigen {
 
@@ -45,4 +45,4 @@ class ThreadPoolInterface {
 
 }  // namespace Eigen
 
-#endif  // EIGEN_CXX11_THREADPOOL_THREAD_POOL_INTERFACE_H
+#endif  // EIGEN_THREAD_POOL_INTERFACE_H
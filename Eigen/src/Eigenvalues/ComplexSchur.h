@@ -13,11 +13,13 @@
 #define EIGEN_COMPLEX_SCHUR_H
 
 #include "./HessenbergDecomposition.h"
+#include "./RealSchur.h"
 
 namespace Eigen { 
 
 namespace internal {
 template<typename MatrixType, bool IsComplex> struct complex_schur_reduce_to_hessenberg;
+template<typename MatrixType, bool UseRealSchur> struct complex_schur_compute;
 }
 
 /** \eigenvalues_module \ingroup Eigenvalues_Module
@@ -182,6 +184,11 @@ template<typename _MatrixType> class ComplexSchur
       * to be \f$25n^3\f$ complex flops, or \f$10n^3\f$ complex flops
       * if \a computeU is false.
       *
+      * Real dynamic-size matrices are first brought to real Schur form
+      * with RealSchur, which runs in real arithmetic and uses the
+      * multishift QR algorithm for large matrices. Its 2x2 diagonal
+      * blocks are then triangularized by complex Givens rotations.
+      *
       * Example: \include ComplexSchur_compute.cpp
       * Output: \verbinclude ComplexSchur_compute.out
       *
@@ -257,6 +264,7 @@ template<typename _MatrixType> class ComplexSchur
     ComplexScalar computeShift(Index iu, Index iter);
     void reduceToTriangularForm(bool computeU);
     friend struct internal::complex_schur_reduce_to_hessenberg<MatrixType, NumTraits<Scalar>::IsComplex>;
+    friend struct internal::complex_schur_compute<MatrixType, !NumTraits<Scalar>::IsComplex && MatrixType::ColsAtCompileTime==Dynamic>;
 };
 
 /** If m_matT(i+1,i) is neglegible in floating point arithmetic
@@ -334,8 +342,7 @@ ComplexSchur<MatrixType>& ComplexSchur<MatrixType>::compute(const EigenBase<Inpu
     return *this;
   }
 
-  internal::complex_schur_reduce_to_hessenberg<MatrixType, NumTraits<Scalar>::IsComplex>::run(*this, matrix.derived(), computeU);
-  computeFromHessenberg(m_matT, m_matU, computeU);
+  internal::complex_schur_compute<MatrixType, !NumTraits<Scalar>::IsComplex && MatrixType::ColsAtCompileTime==Dynamic>::run(*this, matrix.derived(), computeU);
   return *this;
 }
 
@@ -383,6 +390,66 @@ struct complex_schur_reduce_to_hessenberg<MatrixType, false>
   }
 };
 
+template<typename MatrixType, bool UseRealSchur>
+struct complex_schur_compute
+{
+  static void run(ComplexSchur<MatrixType>& _this, const MatrixType& matrix, bool computeU)
+  {
+    complex_schur_reduce_to_hessenberg<MatrixType, NumTraits<typename MatrixType::Scalar>::IsComplex>::run(_this, matrix, computeU);
+    _this.computeFromHessenberg(_this.m_matT, _this.m_matU, computeU);
+  }
+};
+
+/* Compute the complex Schur decomposition from the real one */
+template<typename MatrixType>
+struct complex_schur_compute<MatrixType, true>
+{
+  static void run(ComplexSchur<MatrixType>& _this, const MatrixType& matrix, bool computeU)
+  {
+    typedef typename ComplexSchur<MatrixType>::ComplexScalar ComplexScalar;
+    typedef typename ComplexSchur<MatrixType>::RealScalar RealScalar;
+
+    _this.m_hess.compute(matrix);
+    RealSchur<MatrixType> realSchur(matrix.rows());
+    if(_this.m_maxIters != -1)
+      realSchur.setMaxIterations(_this.m_maxIters);
+    MatrixType Q;
+    if(computeU)
+      Q = _this.m_hess.matrixQ();
+    realSchur.computeFromHessenberg(_this.m_hess.matrixH(), Q, computeU);
+    _this.m_matT = realSchur.matrixT().template cast<ComplexScalar>();
+    if(computeU)
+      _this.m_matU = realSchur.matrixU().template cast<ComplexScalar>();
+
+    if(realSchur.info() == Success)
+    {
+      // triangularize the 2x2 diagonal blocks; the first column of the rotation is an eigenvector of the block
+      const Index n = _this.m_matT.cols();
+      for(Index i = 0; i+1 < n; ++i)
+      {
+        if(_this.m_matT.coeff(i+1,i) == ComplexScalar(0))
+          continue;
+        ComplexScalar a = _this.m_matT.coeff(i,i),   b = _this.m_matT.coeff(i,i+1);
+        ComplexScalar c = _this.m_matT.coeff(i+1,i), d = _this.m_matT.coeff(i+1,i+1);
+        ComplexScalar p = RealScalar(0.5) * (a - d);
+        ComplexScalar lambda = d + p + sqrt(p*p + b*c);
+        JacobiRotation<ComplexScalar> rot;
+        rot.makeGivens(b, lambda - a);
+        _this.m_matT.rightCols(n-i).applyOnTheLeft(i, i+1, rot.adjoint());
+        _this.m_matT.topRows(i+2).applyOnTheRight(i, i+1, rot);
+        if(computeU)
+          _this.m_matU.applyOnTheRight(i, i+1, rot);
+        _this.m_matT.coeffRef(i+1,i) = ComplexScalar(0);
+        ++i;
+      }
+    }
+
+    _this.m_info = realSchur.info();
+    _this.m_isInitialized = true;
+    _this.m_matUisUptodate = computeU;
+  }
+};
+
 } // end namespace internal
 
 // Reduce the Hessenberg matrix m_matT to triangular form by QR iteration.
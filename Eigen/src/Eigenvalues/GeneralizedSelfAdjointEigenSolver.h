@@ -84,7 +84,8 @@ class GeneralizedSelfAdjointEigenSolver : public SelfAdjointEigenSolver<_MatrixT
       * \param[in]  matB  Positive-definite matrix in matrix pencil.
       *                   Only the lower triangular part of the matrix is referenced.
       * \param[in]  options A or-ed set of flags {#ComputeEigenvectors,#EigenvaluesOnly} | {#Ax_lBx,#ABx_lx,#BAx_lx}.
-      *                     Default is #ComputeEigenvectors|#Ax_lBx.
+      *                     Default is #ComputeEigenvectors|#Ax_lBx. #DivideAndConquer can be added
+      *                     to use the divide-and-conquer algorithm, see SelfAdjointEigenSolver::compute().
       *
       * This constructor calls compute(const MatrixType&, const MatrixType&, int)
       * to compute the eigenvalues and (if requested) the eigenvectors of the
@@ -117,7 +118,8 @@ class GeneralizedSelfAdjointEigenSolver : public SelfAdjointEigenSolver<_MatrixT
       * \param[in]  matB  Positive-definite matrix in matrix pencil.
       *                   Only the lower triangular part of the matrix is referenced.
       * \param[in]  options A or-ed set of flags {#ComputeEigenvectors,#EigenvaluesOnly} | {#Ax_lBx,#ABx_lx,#BAx_lx}.
-      *                     Default is #ComputeEigenvectors|#Ax_lBx.
+      *                     Default is #ComputeEigenvectors|#Ax_lBx. #DivideAndConquer can be added
+      *                     to use the divide-and-conquer algorithm, see SelfAdjointEigenSolver::compute().
       *
       * \returns    Reference to \c *this
       *
@@ -163,13 +165,14 @@ GeneralizedSelfAdjointEigenSolver<MatrixType>& GeneralizedSelfAdjointEigenSolver
 compute(const MatrixType& matA, const MatrixType& matB, int options)
 {
   eigen_assert(matA.cols()==matA.rows() && matB.rows()==matA.rows() && matB.cols()==matB.rows());
-  eigen_assert((options&~(EigVecMask|GenEigMask))==0
+  eigen_assert((options&~(EigVecMask|GenEigMask|DivideAndConquer))==0
           && (options&EigVecMask)!=EigVecMask
           && ((options&GenEigMask)==0 || (options&GenEigMask)==Ax_lBx
            || (options&GenEigMask)==ABx_lx || (options&GenEigMask)==BAx_lx)
           && "invalid option parameter");
 
   bool computeEigVecs = ((options&EigVecMask)==0) || ((options&EigVecMask)==ComputeEigenvectors);
+  int solverOptions = (computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly) | (options&DivideAndConquer);
 
   // Compute the cholesky decomposition of matB = L L' = U'U
   LLT<MatrixType> cholB(matB);
@@ -185,7 +188,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     cholB.matrixL().template solveInPlace<OnTheLeft>(matC);
     cholB.matrixU().template solveInPlace<OnTheRight>(matC);
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly );
+    Base::compute(matC, solverOptions);
 
     // transform back the eigen vectors: evecs = inv(U) * evecs
     if(computeEigVecs)
@@ -198,7 +201,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     matC = matC * cholB.matrixL();
     matC = cholB.matrixU() * matC;
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly);
+    Base::compute(matC, solverOptions);
 
     // transform back the eigen vectors: evecs = inv(U) * evecs
     if(computeEigVecs)
@@ -211,7 +214,7 @@ compute(const MatrixType& matA, const MatrixType& matB, int options)
     matC = matC * cholB.matrixL();
     matC = cholB.matrixU() * matC;
 
-    Base::compute(matC, computeEigVecs ? ComputeEigenvectors : EigenvaluesOnly);
+    Base::compute(matC, solverOptions);
 
     // transform back the eigen vectors: evecs = L * evecs
     if(computeEigVecs)
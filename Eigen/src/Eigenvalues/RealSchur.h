@@ -161,6 +161,11 @@ template<typename _MatrixType> class RealSchur
       * may be taken to be \f$25n^3\f$ flops if \a computeU is true and
       * \f$10n^3\f$ flops if \a computeU is false.
       *
+      * For large dynamic-size matrices, the QR iterations use many shifts at
+      * once and aggressive early deflation, as in LAPACK's xHSEQR: the shifts
+      * are chased down the diagonal as a chain of small bulges whose
+      * transformations are accumulated and applied with matrix-matrix products.
+      *
       * Example: \include RealSchur_compute.cpp
       * Output: \verbinclude RealSchur_compute.out
       *
@@ -234,6 +239,12 @@ template<typename _MatrixType> class RealSchur
     Index m_maxIters;
 
     typedef Matrix<Scalar,3,1> Vector3s;
+    typedef Matrix<Scalar,Dynamic,Dynamic> WorkMatrixType;
+    // Each row holds the trace and the determinant of a pair of shifts
+    typedef Matrix<Scalar,Dynamic,2> ShiftsType;
+
+    // Active submatrices smaller than this are reduced with the double-shift QR algorithm
+    enum { MultishiftMinSize = 75 };
 
     Scalar computeNormOfT();
     Index findSmallSubdiagEntry(Index iu, const Scalar& considerAsZero);
@@ -241,6 +252,11 @@ template<typename _MatrixType> class RealSchur
     void computeShift(Index iu, Index iter, Scalar& exshift, Vector3s& shiftInfo);
     void initFrancisQRStep(Index il, Index iu, const Vector3s& shiftInfo, Index& im, Vector3s& firstHouseholderVector);
     void performFrancisQRStep(Index il, Index im, Index iu, bool computeU, const Vector3s& firstHouseholderVector, Scalar* workspace);
+    void performMultishiftQRIteration(Index il, Index iu, Index iter, bool computeU);
+    Index aggressiveEarlyDeflation(Index il, Index iu, Index nw, bool computeU, ShiftsType& shifts);
+    void performMultishiftQRSweep(Index il, Index iu, const ShiftsType& shifts, bool computeU);
+    static bool moveSchurBlock(WorkMatrixType& T, WorkMatrixType& Q, Index from, Index size, Index to);
+    static bool swapSchurBlocks(WorkMatrixType& T, WorkMatrixType& Q, Index j, Index p, Index q);
 };
 
 
@@ -333,6 +349,13 @@ RealSchur<MatrixType>& RealSchur<MatrixType>::computeFromHessenberg(const HessMa
         iu -= 2;
         iter = 0;
       }
+      else if (ColsAtCompileTime==Dynamic && iu-il+1 >= Index(MultishiftMinSize))
+      {
+        iter = iter + 1;
+        totalIter = totalIter + 1;
+        if (totalIter > maxIters) break;
+        performMultishiftQRIteration(il, iu, iter, computeU);
+      }
       else // No convergence yet
       {
         // The firstHouseholderVector vector has to be initialized to something to get rid of a silly GCC warning (-O1 -Wall -DNDEBUG )
@@ -553,6 +576,377 @@ inline void RealSchur<MatrixType>::performFrancisQRStep(Index il, Index im, Inde
   }
 }
 
+/** \internal Perform an aggressive early deflation followed, if it did not deflate enough eigenvalues,
+  * by a multishift QR sweep on rows il:iu. The parameters follow LAPACK's xLAQR0 and IPARMQ. */
+template<typename MatrixType>
+void RealSchur<MatrixType>::performMultishiftQRIteration(Index il, Index iu, Index iter, bool computeU)
+{
+  using std::abs;
+  const Index nh = iu - il + 1;
+
+  // number of shifts and size of the deflation window
+  Index ns;
+  if (nh < 150)       ns = 10;
+  else if (nh < 590)  ns = numext::maxi<Index>(10, nh / Index(std::log(double(nh)) / std::log(2.0) + 0.5));
+  else if (nh < 3000) ns = 64;
+  else if (nh < 6000) ns = 128;
+  else                ns = 256;
+  ns -= ns % 2;
+  Index nw = nh <= 500 ? ns : 3*ns/2;
+  nw = (std::min)(nw, nh/3);
+
+  ShiftsType shifts;
+  Index nd = aggressiveEarlyDeflation(il, iu, nw, computeU, shifts);
+
+  // skip the sweep if enough eigenvalues were deflated (14% in LAPACK)
+  if (nd > 0 && 100*nd > 14*nw)
+    return;
+
+  iu -= nd;
+  if (iu - il + 1 < 3)
+    return;
+
+  if (iter % 6 == 0)
+  {
+    // exceptional shifts
+    shifts.resize(ns/2, 2);
+    for (Index j = 0; j < ns/2; ++j)
+    {
+      Index i = (std::max)(iu - 2*j, il + 2);
+      Scalar s = abs(m_matT.coeff(i,i-1)) + abs(m_matT.coeff(i-1,i-2));
+      Scalar a = Scalar(0.75) * s + m_matT.coeff(i,i);
+      shifts.coeffRef(j,0) = Scalar(2) * a;
+      shifts.coeffRef(j,1) = a * a + Scalar(0.4375) * s * s;
+    }
+  }
+  else if (shifts.rows() == 0)
+  {
+    // use the eigenvalues of the trailing 2x2 block
+    shifts.resize(1, 2);
+    shifts.coeffRef(0,0) = m_matT.coeff(iu-1,iu-1) + m_matT.coeff(iu,iu);
+    shifts.coeffRef(0,1) = m_matT.coeff(iu-1,iu-1) * m_matT.coeff(iu,iu) - m_matT.coeff(iu-1,iu) * m_matT.coeff(iu,iu-1);
+  }
+
+  // keep the shifts at the bottom of the deflation window, and at most one bulge per six rows
+  Index nbulges = (std::min)(shifts.rows(), (std::max)(Index(1), (iu - il + 1) / 6));
+  performMultishiftQRSweep(il, iu, shifts.bottomRows(nbulges), computeU);
+}
+
+/** \internal Aggressive early deflation on the nw x nw trailing window of rows il:iu, see LAPACK's xLAQR3.
+  *
+  * The window is reduced to real Schur form. Its eigenvalues whose component of the spike, i.e.,
+  * the coupling with the rest of the matrix, is negligible are deflated and moved to the bottom of
+  * the window, the others are returned in \a shifts. Returns the number of deflated eigenvalues.
+  */
+template<typename MatrixType>
+Index RealSchur<MatrixType>::aggressiveEarlyDeflation(Index il, Index iu, Index nw, bool computeU, ShiftsType& shifts)
+{
+  using std::abs;
+  using std::sqrt;
+  const Index size = m_matT.cols();
+  const Scalar ulp = NumTraits<Scalar>::epsilon();
+  const Scalar smlnum = (std::numeric_limits<Scalar>::min)() * (Scalar(iu - il + 1) / ulp);
+  const Index kwtop = iu - nw + 1;
+  const Scalar s = kwtop > il ? m_matT.coeff(kwtop, kwtop-1) : Scalar(0);
+
+  shifts.resize(0, 2);
+  RealSchur<WorkMatrixType> schur(nw);
+  WorkMatrixType tw = m_matT.block(kwtop, kwtop, nw, nw);
+  WorkMatrixType V = WorkMatrixType::Identity(nw, nw);
+  schur.computeFromHessenberg(tw, V, true);
+  if (schur.info() != Success)
+    return 0;
+  tw = schur.matrixT();
+  V = schur.matrixU();
+
+  // Look for deflations from the bottom of the window; move the undeflatable blocks to its top.
+  Index ns = nw;   // rows 0,...,ns-1 are not deflated
+  Index ilst = 0;  // rows 0,...,ilst-1 hold undeflatable blocks
+  while (ilst < ns)
+  {
+    bool isPair = ns > 1 && tw.coeff(ns-1, ns-2) != Scalar(0);
+    if (!isPair)
+    {
+      Scalar foo = abs(tw.coeff(ns-1, ns-1));
+      if (foo == Scalar(0)) foo = abs(s);
+      if (abs(s * V.coeff(0, ns-1)) <= numext::maxi(smlnum, ulp * foo))
+        --ns;
+      else if (moveSchurBlock(tw, V, ns-1, 1, ilst))
+        ++ilst;
+      else
+        ilst = ns;  // the block cannot be moved: consider all the remaining ones as undeflatable
+    }
+    else
+    {
+      Scalar foo = abs(tw.coeff(ns-1, ns-1)) + sqrt(abs(tw.coeff(ns-1, ns-2))) * sqrt(abs(tw.coeff(ns-2, ns-1)));
+      if (foo == Scalar(0)) foo = abs(s);
+      if (numext::maxi(abs(s * V.coeff(0, ns-1)), abs(s * V.coeff(0, ns-2))) <= numext::maxi(smlnum, ulp * foo))
+        ns -= 2;
+      else if (moveSchurBlock(tw, V, ns-2, 2, ilst))
+        ilst += 2;
+      else
+        ilst = ns;
+    }
+  }
+
+  // The undeflated eigenvalues are the shifts of the next sweep. Real shifts are paired in order.
+  shifts.resize(ns/2 + 1, 2);
+  Index nshifts = 0;
+  bool pendingReal = false;
+  Scalar previousReal(0);
+  for (Index i = 0; i < ns; )
+  {
+    if (i+1 < ns && tw.coeff(i+1, i) != Scalar(0))
+    {
+      shifts.coeffRef(nshifts, 0) = tw.coeff(i, i) + tw.coeff(i+1, i+1);
+      shifts.coeffRef(nshifts, 1) = tw.coeff(i, i) * tw.coeff(i+1, i+1) - tw.coeff(i, i+1) * tw.coeff(i+1, i);
+      ++nshifts;
+      i += 2;
+    }
+    else
+    {
+      if (pendingReal)
+      {
+        shifts.coeffRef(nshifts, 0) = previousReal + tw.coeff(i, i);
+        shifts.coeffRef(nshifts, 1) = previousReal * tw.coeff(i, i);
+        ++nshifts;
+      }
+      else
+        previousReal = tw.coeff(i, i);
+      pendingReal = !pendingReal;
+      ++i;
+    }
+  }
+  shifts.conservativeResize(nshifts, 2);
+
+  // Restore the Hessenberg form of the undeflated part: map the spike onto a multiple of e_1,
+  // then reduce the window.
+  if (ns > 1 && s != Scalar(0))
+  {
+    Matrix<Scalar,Dynamic,1> spike = V.row(0).head(ns).transpose();
+    Matrix<Scalar,Dynamic,1> ess(ns-1), work(nw);
+    Scalar tau, beta;
+    spike.makeHouseholder(ess, tau, beta);
+    tw.topRows(ns).applyHouseholderOnTheLeft(ess, tau, work.data());
+    tw.topLeftCorner(ns, ns).applyHouseholderOnTheRight(ess, tau, work.data());
+    V.leftCols(ns).applyHouseholderOnTheRight(ess, tau, work.data());
+
+    HessenbergDecomposition<WorkMatrixType> hess(tw.topLeftCorner(ns, ns));
+    WorkMatrixType Qh = hess.matrixQ();
+    tw.topLeftCorner(ns, ns) = hess.matrixH();
+    tw.topRightCorner(ns, nw-ns) = Qh.transpose() * tw.topRightCorner(ns, nw-ns);
+    V.leftCols(ns) = V.leftCols(ns) * Qh;
+  }
+
+  m_matT.block(kwtop, kwtop, nw, nw) = tw;
+  if (kwtop > il)
+  {
+    m_matT.col(kwtop-1).segment(kwtop, nw).setZero();
+    if (ns > 0)
+      m_matT.coeffRef(kwtop, kwtop-1) = s * V.coeff(0, 0);
+  }
+
+  // apply the transformation of the window to the rest of the matrix
+  if (iu+1 < size)
+    m_matT.block(kwtop, iu+1, nw, size-iu-1) = V.transpose() * m_matT.block(kwtop, iu+1, nw, size-iu-1);
+  if (kwtop > 0)
+    m_matT.block(0, kwtop, kwtop, nw) = m_matT.block(0, kwtop, kwtop, nw) * V;
+  if (computeU)
+    m_matU.middleCols(kwtop, nw) = m_matU.middleCols(kwtop, nw) * V;
+
+  return nw - ns;
+}
+
+/** \internal Perform a multishift QR sweep on rows il:iu, see LAPACK's xLAQR5.
+  *
+  * Each pair of shifts introduces a bulge at the top of the active submatrix. The bulges are chased
+  * down the diagonal as a chain, three rows apart, the deepest first. The reflectors are applied to a
+  * window enclosing the chain while it moves down by a few rows; their product is accumulated and
+  * applied to the rest of the matrix with matrix-matrix products.
+  */
+template<typename MatrixType>
+void RealSchur<MatrixType>::performMultishiftQRSweep(Index il, Index iu, const ShiftsType& shifts, bool computeU)
+{
+  const Index size = m_matT.cols();
+  const Index nbulges = shifts.rows();
+  // bulge j is at row il + t - 3*j at time t, and leaves the matrix after row iu-1
+  const Index nsteps = (iu - il) + 3*(nbulges-1);
+  const Index chunk = numext::maxi<Index>(3*nbulges, 6);
+  Scalar* workspace = &m_workspaceVector.coeffRef(0);
+
+  WorkMatrixType Z;
+  for (Index t0 = 0; t0 < nsteps; t0 += chunk)
+  {
+    const Index t1 = (std::min)(nsteps, t0 + chunk) - 1;
+    const Index w0 = (std::max)(il, il + t0 - 3*(nbulges-1));
+    const Index w1 = (std::min)(iu, il + t1 + 3);
+    const Index ws = w1 - w0 + 1;
+    Z.setIdentity(ws, ws);
+
+    for (Index t = t0; t <= t1; ++t)
+    {
+      for (Index j = 0; j < nbulges; ++j)
+      {
+        const Index k = il + t - 3*j;
+        if (k < il) break;
+        if (k > iu-1) continue;
+
+        if (k <= iu-2)
+        {
+          Vector3s v;
+          if (k == il)
+          {
+            // first column of (T - s_1 I)(T - s_2 I)
+            const Scalar h11 = m_matT.coeff(il,il),   h12 = m_matT.coeff(il,il+1);
+            const Scalar h21 = m_matT.coeff(il+1,il), h22 = m_matT.coeff(il+1,il+1);
+            v.coeffRef(0) = h11 * (h11 - shifts.coeff(j,0)) + h12 * h21 + shifts.coeff(j,1);
+            v.coeffRef(1) = h21 * (h11 + h22 - shifts.coeff(j,0));
+            v.coeffRef(2) = h21 * m_matT.coeff(il+2,il+1);
+          }
+          else
+            v = m_matT.template block<3,1>(k,k-1);
+
+          Scalar tau, beta;
+          Matrix<Scalar, 2, 1> ess;
+          v.makeHouseholder(ess, tau, beta);
+          if (beta != Scalar(0)) // if v is not zero
+          {
+            if (k > il)
+            {
+              m_matT.coeffRef(k,k-1) = beta;
+              m_matT.coeffRef(k+1,k-1) = Scalar(0);
+              m_matT.coeffRef(k+2,k-1) = Scalar(0);
+            }
+            m_matT.block(k, k, 3, w1-k+1).applyHouseholderOnTheLeft(ess, tau, workspace);
+            m_matT.block(w0, k, (std::min)(iu,k+3)-w0+1, 3).applyHouseholderOnTheRight(ess, tau, workspace);
+            Z.block(0, k-w0, ws, 3).applyHouseholderOnTheRight(ess, tau, workspace);
+          }
+        }
+        else
+        {
+          Matrix<Scalar, 2, 1> v = m_matT.template block<2,1>(iu-1, iu-2);
+          Scalar tau, beta;
+          Matrix<Scalar, 1, 1> ess;
+          v.makeHouseholder(ess, tau, beta);
+          if (beta != Scalar(0)) // if v is not zero
+          {
+            m_matT.coeffRef(iu-1, iu-2) = beta;
+            m_matT.coeffRef(iu, iu-2) = Scalar(0);
+            m_matT.block(iu-1, iu-1, 2, w1-iu+2).applyHouseholderOnTheLeft(ess, tau, workspace);
+            m_matT.block(w0, iu-1, iu-w0+1, 2).applyHouseholderOnTheRight(ess, tau, workspace);
+            Z.block(0, iu-1-w0, ws, 2).applyHouseholderOnTheRight(ess, tau, workspace);
+          }
+        }
+      }
+    }
+
+    // These matrix-matrix products form the O(n^3) part of the algorithm
+    if (w1+1 < size)
+      m_matT.block(w0, w1+1, ws, size-w1-1) = Z.transpose() * m_matT.block(w0, w1+1, ws, size-w1-1);
+    if (w0 > 0)
+      m_matT.block(0, w0, w0, ws) = m_matT.block(0, w0, w0, ws) * Z;
+    if (computeU)
+      m_matU.middleCols(w0, ws) = m_matU.middleCols(w0, ws) * Z;
+  }
+
+  // clean up pollution due to round-off errors
+  for (Index i = il+2; i <= iu; ++i)
+  {
+    m_matT.coeffRef(i,i-2) = Scalar(0);
+    if (i > il+2)
+      m_matT.coeffRef(i,i-3) = Scalar(0);
+  }
+}
+
+/** \internal Move the diagonal block of \a size rows starting at row \a from of the quasi-triangular matrix
+  * \a T up to row \a to, accumulating the transformations in \a Q.
+  * \returns false if a swap was rejected, in which case the block stopped on its way up. */
+template<typename MatrixType>
+bool RealSchur<MatrixType>::moveSchurBlock(WorkMatrixType& T, WorkMatrixType& Q, Index from, Index size, Index to)
+{
+  Index here = from;
+  while (here > to)
+  {
+    Index sizeAbove = (here-2 >= to && T.coeff(here-1, here-2) != Scalar(0)) ? 2 : 1;
+    if (!swapSchurBlocks(T, Q, here-sizeAbove, sizeAbove, size))
+      return false;
+    here -= sizeAbove;
+  }
+  return true;
+}
+
+/** \internal Swap the adjacent diagonal blocks T11 (p x p) and T22 (q x q) of the quasi-triangular matrix \a T
+  * starting at row \a j, and accumulate the orthogonal transformation in \a Q, see LAPACK's xLAEXC.
+  * \returns false, leaving \a T and \a Q unchanged, if the swap is rejected because the eigenvalues of the blocks
+  * are too close for the swapped matrix to be quasi-triangular up to round-off errors. */
+template<typename MatrixType>
+bool RealSchur<MatrixType>::swapSchurBlocks(WorkMatrixType& T, WorkMatrixType& Q, Index j, Index p, Index q)
+{
+  const Index n = T.cols();
+  const Index m = p + q;
+  if (p == 1 && q == 1)
+  {
+    // the first column of the rotation is the eigenvector of T22
+    const Scalar t11 = T.coeff(j,j), t22 = T.coeff(j+1,j+1);
+    JacobiRotation<Scalar> rot;
+    rot.makeGivens(T.coeff(j,j+1), t22 - t11);
+    T.rightCols(n-j).applyOnTheLeft(j, j+1, rot.adjoint());
+    T.topRows(j+2).applyOnTheRight(j, j+1, rot);
+    Q.applyOnTheRight(j, j+1, rot);
+    T.coeffRef(j,j) = t22;
+    T.coeffRef(j+1,j+1) = t11;
+    T.coeffRef(j+1,j) = Scalar(0);
+    return true;
+  }
+
+  // The columns of [-X; I] span the invariant subspace of T22, with T11 X - X T22 = T12.
+  typedef Matrix<Scalar,Dynamic,Dynamic,0,4,4> SmallMatrixType;
+  SmallMatrixType K = SmallMatrixType::Zero(p*q, p*q);
+  for (Index c = 0; c < q; ++c)
+    for (Index r = 0; r < q; ++r)
+    {
+      if (r == c)
+        K.block(c*p, c*p, p, p) += T.block(j, j, p, p);
+      K.block(c*p, r*p, p, p).diagonal().array() -= T.coeff(j+p+r, j+p+c);
+    }
+  Matrix<Scalar,Dynamic,1,0,4,1> rhs(p*q);
+  for (Index c = 0; c < q; ++c)
+    rhs.segment(c*p, p) = T.block(j, j+p+c, p, 1);
+  Matrix<Scalar,Dynamic,1,0,4,1> x = K.fullPivLu().solve(rhs);
+
+  // QR factorization of [-X; I]
+  Matrix<Scalar,Dynamic,Dynamic,0,4,2> basis(m, q);
+  for (Index c = 0; c < q; ++c)
+    basis.col(c).head(p) = -x.segment(c*p, p);
+  basis.bottomRows(q).setIdentity();
+  SmallMatrixType H = SmallMatrixType::Identity(m, m);
+  Scalar workspace[4];
+  for (Index c = 0; c < q; ++c)
+  {
+    Matrix<Scalar,Dynamic,1,0,3,1> ess(m-c-1);
+    Scalar tau, beta;
+    basis.col(c).tail(m-c).makeHouseholder(ess, tau, beta);
+    basis.bottomRightCorner(m-c, q-c-1).applyHouseholderOnTheLeft(ess, tau, workspace);
+    H.rightCols(m-c).applyHouseholderOnTheRight(ess, tau, workspace);
+  }
+
+  // Reject the swap if the block which should vanish is not negligible, as the weak stability test of xLAEXC.
+  // The negated comparison also rejects the non finite solutions of a singular Sylvester equation.
+  SmallMatrixType D = T.block(j, j, m, m);
+  const Scalar dnorm = D.cwiseAbs().maxCoeff();
+  D = H.transpose() * D * H;
+  const Scalar thresh = numext::maxi<Scalar>(Scalar(10) * NumTraits<Scalar>::epsilon() * dnorm,
+                                             (std::numeric_limits<Scalar>::min)() / NumTraits<Scalar>::epsilon());
+  if (!(D.block(q, 0, p, q).cwiseAbs().maxCoeff() <= thresh))
+    return false;
+
+  T.block(j, j, m, n-j) = H.transpose() * T.block(j, j, m, n-j);
+  T.block(0, j, j+m, m) = T.block(0, j, j+m, m) * H;
+  Q.middleCols(j, m) = Q.middleCols(j, m) * H;
+  T.block(j+q, j, p, q).setZero();
+  return true;
+}
+
 } // end namespace Eigen
 
 #endif // EIGEN_REAL_SCHUR_H
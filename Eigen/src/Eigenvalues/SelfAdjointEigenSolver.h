@@ -12,6 +12,7 @@
 #define EIGEN_SELFADJOINTEIGENSOLVER_H
 
 #include "./Tridiagonalization.h"
+#include "./TridiagonalDivideAndConquer.h"
 
 namespace Eigen { 
 
@@ -20,6 +21,7 @@ class GeneralizedSelfAdjointEigenSolver;
 
 namespace internal {
 template<typename SolverType,int Size,bool IsComplex> struct direct_selfadjoint_eigenvalues;
+template<typename SolverType,bool IsDynamic> struct selfadjoint_divide_and_conquer;
 
 template<typename MatrixType, typename DiagType, typename SubDiagType>
 EIGEN_DEVICE_FUNC
@@ -100,6 +102,7 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
     typedef typename NumTraits<Scalar>::Real RealScalar;
     
     friend struct internal::direct_selfadjoint_eigenvalues<SelfAdjointEigenSolver,Size,NumTraits<Scalar>::IsComplex>;
+    friend struct internal::selfadjoint_divide_and_conquer<SelfAdjointEigenSolver,MaxColsAtCompileTime==Dynamic>;
 
     /** \brief Type for vector of eigenvalues as returned by eigenvalues().
       *
@@ -185,7 +188,8 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       *
       * \param[in]  matrix  Selfadjoint matrix whose eigendecomposition is to
       *    be computed. Only the lower triangular part of the matrix is referenced.
-      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly.
+      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly,
+      *    optionally or-ed with #DivideAndConquer.
       * \returns    Reference to \c *this
       *
       * This function computes the eigenvalues of \p matrix.  The eigenvalues()
@@ -202,6 +206,14 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       * The cost of the computation is about \f$ 9n^3 \f$ if the eigenvectors
       * are required and \f$ 4n^3/3 \f$ if they are not required.
       *
+      * If \p options contains #DivideAndConquer and the eigenvectors are required, the
+      * eigendecomposition of the tridiagonal matrix is computed with Cuppen's
+      * divide-and-conquer algorithm instead, and the eigenvectors of \p matrix are
+      * obtained by applying the Householder reflectors of the tridiagonalization in
+      * blocks. Both steps are dominated by matrix-matrix products, which makes this
+      * option several times faster for large matrices. It is ignored for fixed-size
+      * matrices.
+      *
       * This method reuses the memory in the SelfAdjointEigenSolver object that
       * was allocated when the object was constructed, if the size of the
       * matrix does not change.
@@ -214,6 +226,32 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
     template<typename InputType>
     EIGEN_DEVICE_FUNC
     SelfAdjointEigenSolver& compute(const EigenBase<InputType>& matrix, int options = ComputeEigenvectors);
+
+    /** \brief Computes the largest eigenvalues and eigenvectors of given matrix.
+      *
+      * \param[in]  matrix  Selfadjoint matrix whose eigendecomposition is to
+      *    be computed. Only the lower triangular part of the matrix is referenced.
+      * \param[in]  k  Number of eigenvalues to compute, between 0 and the size of \p matrix.
+      * \param[in]  options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly.
+      * \returns    Reference to \c *this
+      *
+      * This function computes the \p k largest eigenvalues of \p matrix, and the
+      * corresponding eigenvectors if \p options equals #ComputeEigenvectors.
+      * Afterwards, eigenvalues() is a vector of size \p k whose entries are sorted
+      * in increasing order, and eigenvectors() is a n-by-\p k matrix.
+      *
+      * After the reduction to tridiagonal form, the eigenvalues are computed by
+      * bisection and the eigenvectors by inverse iteration, so that the tridiagonal
+      * step only costs \f$ O(nk) \f$ (plus a reorthogonalization within clusters of close
+      * eigenvalues), and the back-transformation \f$ O(n^2k) \f$. This is much faster
+      * than compute() when \p k is small compared to \p n.
+      *
+      * \note For fixed-size matrices, \p k must be equal to the size of \p matrix.
+      *
+      * \sa compute(const EigenBase<InputType>&, int)
+      */
+    template<typename InputType>
+    SelfAdjointEigenSolver& computeLargest(const EigenBase<InputType>& matrix, Index k, int options = ComputeEigenvectors);
     
     /** \brief Computes eigendecomposition of given matrix using a closed-form algorithm
       *
@@ -241,7 +279,8 @@ template<typename _MatrixType> class SelfAdjointEigenSolver
       *
       * \param[in] diag The vector containing the diagonal of the matrix.
       * \param[in] subdiag The subdiagonal of the matrix.
-      * \param[in] options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly.
+      * \param[in] options Can be #ComputeEigenvectors (default) or #EigenvaluesOnly,
+      *    optionally or-ed with #DivideAndConquer.
       * \returns Reference to \c *this
       *
       * This function assumes that the matrix has been reduced to tridiagonal form.
@@ -425,10 +464,11 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
   
   EIGEN_USING_STD(abs);
   eigen_assert(matrix.cols() == matrix.rows());
-  eigen_assert((options&~(EigVecMask|GenEigMask))==0
+  eigen_assert((options&~(EigVecMask|GenEigMask|DivideAndConquer))==0
           && (options&EigVecMask)!=EigVecMask
           && "invalid option parameter");
   bool computeEigenvectors = (options&ComputeEigenvectors)==ComputeEigenvectors;
+  bool divideAndConquer = computeEigenvectors && (options&DivideAndConquer)==DivideAndConquer;
   Index n = matrix.cols();
   m_eivalues.resize(n,1);
 
@@ -455,9 +495,11 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
   mat.template triangularView<Lower>() /= scale;
   m_subdiag.resize(n-1);
   m_hcoeffs.resize(n-1);
-  internal::tridiagonalization_inplace(mat, diag, m_subdiag, m_hcoeffs, computeEigenvectors);
-
-  m_info = internal::computeFromTridiagonal_impl(diag, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
+  if(!(divideAndConquer && internal::selfadjoint_divide_and_conquer<SelfAdjointEigenSolver,MaxColsAtCompileTime==Dynamic>::run(*this)))
+  {
+    internal::tridiagonalization_inplace(mat, diag, m_subdiag, m_hcoeffs, computeEigenvectors);
+    m_info = internal::computeFromTridiagonal_impl(diag, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
+  }
   
   // scale back the eigen values
   m_eivalues *= scale;
@@ -467,6 +509,56 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
   return *this;
 }
 
+template<typename MatrixType>
+template<typename InputType>
+SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
+::computeLargest(const EigenBase<InputType>& a_matrix, Index k, int options)
+{
+  check_template_parameters();
+
+  const InputType &matrix(a_matrix.derived());
+
+  eigen_assert(matrix.cols() == matrix.rows());
+  eigen_assert(k>=0 && k<=matrix.cols());
+  eigen_assert((options&~EigVecMask)==0
+          && (options&EigVecMask)!=EigVecMask
+          && "invalid option parameter");
+  bool computeEigenvectors = (options&ComputeEigenvectors)==ComputeEigenvectors;
+  Index n = matrix.cols();
+
+  EigenvectorsType& mat = m_eivec;
+
+  // map the matrix coefficients to [-1:1] to avoid over- and underflow.
+  mat = matrix.template triangularView<Lower>();
+  RealScalar scale = mat.cwiseAbs().maxCoeff();
+  if(scale==RealScalar(0)) scale = RealScalar(1);
+  mat.template triangularView<Lower>() /= scale;
+  Matrix<RealScalar,Dynamic,1> diag(n);
+  m_subdiag.resize(n > 1 ? n-1 : 0);
+  m_hcoeffs.resize(n > 1 ? n-1 : 0);
+  internal::tridiagonalization_inplace(mat, diag, m_subdiag, m_hcoeffs, false);
+
+  Matrix<RealScalar,Dynamic,Dynamic> eivec;
+  m_info = internal::computeFromTridiagonal_largest(diag, m_subdiag, k, computeEigenvectors, m_eivalues, eivec);
+
+  if(computeEigenvectors)
+  {
+    // back-transformation by blocks of Householder reflectors
+    Matrix<Scalar,Dynamic,Dynamic> V = eivec.template cast<Scalar>();
+    if(n>1)
+      HouseholderSequence<EigenvectorsType,typename internal::remove_all<typename TridiagonalizationType::CoeffVectorType::ConjugateReturnType>::type>
+        (mat, m_hcoeffs.conjugate()).setLength(n-1).setShift(1).applyThisOnTheLeft(V);
+    m_eivec = V;
+  }
+
+  // scale back the eigen values
+  m_eivalues *= scale;
+
+  m_isInitialized = true;
+  m_eigenvectorsOk = computeEigenvectors;
+  return *this;
+}
+
 template<typename MatrixType>
 SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
 ::computeFromTridiagonal(const RealVectorType& diag, const SubDiagonalType& subdiag , int options)
@@ -476,11 +568,20 @@ SelfAdjointEigenSolver<MatrixType>& SelfAdjointEigenSolver<MatrixType>
 
   m_eivalues = diag;
   m_subdiag = subdiag;
-  if (computeEigenvectors)
+  if (computeEigenvectors && (options&DivideAndConquer)==DivideAndConquer)
   {
-    m_eivec.setIdentity(diag.size(), diag.size());
+    Matrix<RealScalar,Dynamic,Dynamic> eivec;
+    m_info = internal::computeFromTridiagonal_dc(m_eivalues, m_subdiag, m_maxIterations, eivec);
+    m_eivec = eivec.template cast<Scalar>();
+  }
+  else
+  {
+    if (computeEigenvectors)
+    {
+      m_eivec.setIdentity(diag.size(), diag.size());
+    }
+    m_info = internal::computeFromTridiagonal_impl(m_eivalues, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
   }
-  m_info = internal::computeFromTridiagonal_impl(m_eivalues, m_subdiag, m_maxIterations, computeEigenvectors, m_eivec);
 
   m_isInitialized = true;
   m_eigenvectorsOk = computeEigenvectors;
@@ -572,6 +673,41 @@ ComputationInfo computeFromTridiagonal_impl(DiagType& diag, SubDiagType& subdiag
   return info;
 }
   
+/** \internal
+  * Divide-and-conquer path of SelfAdjointEigenSolver::compute(). It is only enabled for dynamic-size
+  * matrices, in which case run() performs the tridiagonalization and the eigendecomposition and returns true.
+  */
+template<typename SolverType,bool IsDynamic> struct selfadjoint_divide_and_conquer
+{
+  EIGEN_DEVICE_FUNC
+  static inline bool run(SolverType&) { return false; }
+};
+
+template<typename SolverType> struct selfadjoint_divide_and_conquer<SolverType,true>
+{
+  typedef typename SolverType::Scalar Scalar;
+  typedef typename SolverType::RealScalar RealScalar;
+  typedef typename SolverType::EigenvectorsType EigenvectorsType;
+  typedef typename SolverType::TridiagonalizationType::CoeffVectorType CoeffVectorType;
+  typedef HouseholderSequence<EigenvectorsType,typename remove_all<typename CoeffVectorType::ConjugateReturnType>::type> HouseholderSequenceType;
+
+  static bool run(SolverType& eig)
+  {
+    EigenvectorsType& mat = eig.m_eivec;
+    Index n = mat.cols();
+    tridiagonalization_inplace(mat, eig.m_eivalues, eig.m_subdiag, eig.m_hcoeffs, false);
+
+    Matrix<RealScalar,Dynamic,Dynamic> eivec;
+    eig.m_info = computeFromTridiagonal_dc(eig.m_eivalues, eig.m_subdiag, SolverType::m_maxIterations, eivec);
+
+    // Q * eivec, without forming Q
+    EigenvectorsType V = eivec.template cast<Scalar>();
+    HouseholderSequenceType(mat, eig.m_hcoeffs.conjugate()).setLength(n-1).setShift(1).applyThisOnTheLeft(V);
+    mat.swap(V);
+    return true;
+  }
+};
+
 template<typename SolverType,int Size,bool IsComplex> struct direct_selfadjoint_eigenvalues
 {
   EIGEN_DEVICE_FUNC
@@ -0,0 +1,678 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// The algorithm follows Cuppen's divide-and-conquer method with the deflation
+// of Dongarra and Sorensen and the eigenvector computation of Gu and Eisenstat,
+// "A divide-and-conquer algorithm for the symmetric tridiagonal eigenproblem",
+// SIAM J. Matrix Anal. Appl., 16 (1995), as implemented in LAPACK's xSTEDC.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
+#define EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
+
+namespace Eigen {
+
+namespace internal {
+
+template<typename MatrixType, typename DiagType, typename SubDiagType>
+EIGEN_DEVICE_FUNC
+ComputationInfo computeFromTridiagonal_impl(DiagType& diag, SubDiagType& subdiag, const Index maxIterations, bool computeEigenvectors, MatrixType& eivec);
+
+/** \internal
+  *
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * \brief Divide-and-conquer eigensolver for real symmetric tridiagonal matrices
+  *
+  * The tridiagonal matrix T is recursively split as \f$ T = diag(T_1, T_2) + \rho u u^T \f$.
+  * Given the eigendecompositions \f$ T_i = Q_i D_i Q_i^T \f$ of the two halves, the eigenvalues
+  * of T are those of the rank-one modification \f$ D + \rho z z^T \f$, \f$ z = diag(Q_1,Q_2)^T u \f$.
+  * They are the roots of the secular equation \f$ 1 + \rho \sum_j z_j^2/(d_j-\lambda) = 0 \f$, and
+  * its eigenvectors are obtained in closed form from the roots. The eigenvectors of T are then
+  * given by a matrix-matrix product with \f$ diag(Q_1,Q_2) \f$.
+  *
+  * Components of z that are negligible, and poles that are too close to each other, are
+  * deflated beforehand. Deflation is frequent in practice, which makes the merge steps much
+  * cheaper than their \f$ O(n^3) \f$ worst case. Blocks smaller than the switch size are
+  * diagonalized with the implicit symmetric QR algorithm.
+  *
+  * This is used by SelfAdjointEigenSolver with the #DivideAndConquer option.
+  *
+  * \sa tridiagonal_largest_eigenpairs
+  */
+template<typename _RealScalar>
+class tridiagonal_divide_and_conquer
+{
+  public:
+    typedef _RealScalar RealScalar;
+    typedef Matrix<RealScalar,Dynamic,Dynamic> MatrixType;
+    typedef Matrix<RealScalar,Dynamic,1> VectorType;
+    typedef Matrix<Index,Dynamic,1> IndicesType;
+
+    explicit tridiagonal_divide_and_conquer(Index maxIterations, Index switchSize = 25)
+      : m_maxIterations(maxIterations), m_switchSize((std::max)(switchSize, Index(2))), m_info(Success)
+    {}
+
+    /** Computes the eigenvalues (in increasing order) and the eigenvectors of the tridiagonal matrix
+      * given by \a diag and \a subdiag. On output, \a diag holds the eigenvalues and \a subdiag is destroyed. */
+    ComputationInfo compute(VectorType& diag, VectorType& subdiag, MatrixType& eivec)
+    {
+      Index n = diag.size();
+      m_info = Success;
+      eivec.setZero(n,n);
+      if(n>0)
+        divide(diag, subdiag, eivec, 0, n);
+      return m_info;
+    }
+
+  protected:
+    void divide(VectorType& diag, VectorType& subdiag, MatrixType& eivec, Index start, Index size);
+    void merge(VectorType& diag, MatrixType& eivec, Index start, Index size, Index size1, RealScalar beta);
+    static void secularRoot(const VectorType& d, const VectorType& z, RealScalar rho, Index i,
+                            Index& shift, RealScalar& mu);
+
+    // Sorts indices according to a vector of values.
+    struct IndexLess
+    {
+      IndexLess(const VectorType& values) : m_values(values) {}
+      bool operator()(Index a, Index b) const { return m_values.coeff(a) < m_values.coeff(b); }
+      const VectorType& m_values;
+    };
+
+    Index m_maxIterations;
+    Index m_switchSize;
+    ComputationInfo m_info;
+};
+
+template<typename RealScalar>
+void tridiagonal_divide_and_conquer<RealScalar>::divide(VectorType& diag, VectorType& subdiag, MatrixType& eivec, Index start, Index size)
+{
+  if(size<=m_switchSize)
+  {
+    VectorType d = diag.segment(start,size);
+    VectorType e = subdiag.segment(start,size-1);
+    MatrixType Z = MatrixType::Identity(size,size);
+    ComputationInfo info = computeFromTridiagonal_impl(d, e, m_maxIterations, true, Z);
+    if(info!=Success)
+      m_info = info;
+    diag.segment(start,size) = d;
+    eivec.block(start,start,size,size) = Z;
+    return;
+  }
+
+  // T = diag(T1, T2) + beta * u u^T with u = e_{size1-1} + e_{size1}
+  Index size1 = size/2;
+  RealScalar beta = subdiag.coeff(start+size1-1);
+  RealScalar rho = numext::abs(beta);
+  diag.coeffRef(start+size1-1) -= rho;
+  diag.coeffRef(start+size1) -= rho;
+
+  divide(diag, subdiag, eivec, start, size1);
+  divide(diag, subdiag, eivec, start+size1, size-size1);
+  merge(diag, eivec, start, size, size1, beta);
+}
+
+template<typename RealScalar>
+void tridiagonal_divide_and_conquer<RealScalar>::merge(VectorType& diag, MatrixType& eivec, Index start, Index size, Index size1, RealScalar beta)
+{
+  using std::sqrt;
+  const Index size2 = size-size1;
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+  Block<MatrixType> Q = eivec.block(start,start,size,size);
+
+  // z = diag(Q1,Q2)^T u, normalized so that the modification reads rho * z z^T with |z|=1
+  VectorType z(size);
+  z.head(size1) = Q.row(size1-1).head(size1).transpose();
+  z.tail(size2) = Q.row(size1).tail(size2).transpose();
+  if(beta<RealScalar(0))
+    z.tail(size2) = -z.tail(size2);
+  z *= RealScalar(1)/sqrt(RealScalar(2));
+  RealScalar rho = RealScalar(2)*numext::abs(beta);
+
+  // Merge the two sorted halves. The columns of Q1 only live in the first size1 rows, those of Q2 in
+  // the last size2 ones, and the columns mixed by a deflating rotation in both: these groups are
+  // kept track of to skip the zero blocks in the final product.
+  enum { Top = 1, Both = 2, Bottom = 3 };
+  IndicesType perm(size);
+  {
+    Index i = 0, j = size1, k = 0;
+    while(i<size1 && j<size)
+      perm(k++) = diag.coeff(start+j) < diag.coeff(start+i) ? j++ : i++;
+    while(i<size1) perm(k++) = i++;
+    while(j<size)  perm(k++) = j++;
+  }
+  VectorType d(size), zs(size);
+  MatrixType Qs(size,size);
+  IndicesType group(size);
+  for(Index k=0; k<size; ++k)
+  {
+    d.coeffRef(k) = diag.coeff(start+perm(k));
+    zs.coeffRef(k) = z.coeff(perm(k));
+    Qs.col(k) = Q.col(perm(k));
+    group(k) = perm(k)<size1 ? Top : Bottom;
+  }
+
+  // Deflation
+  const RealScalar tol = RealScalar(8)*eps*numext::maxi(d.cwiseAbs().maxCoeff(), zs.cwiseAbs().maxCoeff());
+  IndicesType kept(size), deflated(size);
+  Index nbKept = 0, nbDeflated = 0;
+  Index pj = -1;
+  for(Index j=0; j<size; ++j)
+  {
+    if(rho*numext::abs(zs.coeff(j)) <= tol)
+    {
+      deflated(nbDeflated++) = j;
+      continue;
+    }
+    if(pj<0)
+    {
+      pj = j;
+      continue;
+    }
+    // two close poles: rotate z(pj) into z(j) if the resulting perturbation is negligible
+    RealScalar s = zs.coeff(pj);
+    RealScalar c = zs.coeff(j);
+    RealScalar tau = numext::hypot(c,s);
+    RealScalar t = d.coeff(j) - d.coeff(pj);
+    c /= tau;
+    s = -s/tau;
+    if(numext::abs(t*c*s) <= tol)
+    {
+      zs.coeffRef(j) = tau;
+      zs.coeffRef(pj) = 0;
+      VectorType tmp = c*Qs.col(pj) + s*Qs.col(j);
+      Qs.col(j) = c*Qs.col(j) - s*Qs.col(pj);
+      Qs.col(pj) = tmp;
+      if(group(pj)!=group(j))
+        group(pj) = group(j) = Both;
+      RealScalar dpj = d.coeff(pj)*c*c + d.coeff(j)*s*s;
+      d.coeffRef(j) = d.coeff(pj)*s*s + d.coeff(j)*c*c;
+      d.coeffRef(pj) = dpj;
+      deflated(nbDeflated++) = pj;
+    }
+    else
+    {
+      kept(nbKept++) = pj;
+    }
+    pj = j;
+  }
+  if(pj>=0)
+    kept(nbKept++) = pj;
+
+  // Solve the secular equation of the non-deflated part
+  const Index k = nbKept;
+  VectorType lambda(size);
+  MatrixType U(size,k);
+  if(k>0)
+  {
+    VectorType dk(k), zk(k);
+    for(Index i=0; i<k; ++i)
+    {
+      dk.coeffRef(i) = d.coeff(kept(i));
+      zk.coeffRef(i) = zs.coeff(kept(i));
+    }
+
+    MatrixType W(k,k);
+    if(k==1)
+    {
+      lambda.coeffRef(0) = dk.coeff(0) + rho*zk.coeff(0)*zk.coeff(0);
+      W.setOnes();
+    }
+    else
+    {
+      // delta(j,i) = d_j - lambda_i, computed from the shifted roots to retain relative accuracy
+      MatrixType delta(k,k);
+      for(Index i=0; i<k; ++i)
+      {
+        Index shift;
+        RealScalar mu;
+        secularRoot(dk, zk, rho, i, shift, mu);
+        lambda.coeffRef(i) = dk.coeff(shift) + mu;
+        delta.col(i) = (dk.array() - dk.coeff(shift)).matrix() - VectorType::Constant(k,mu);
+      }
+
+      // Recompute z from the computed roots (Loewner's theorem), which makes the eigenvectors
+      // numerically orthogonal.
+      VectorType zhat(k);
+      for(Index j=0; j<k; ++j)
+      {
+        RealScalar prod = -delta.coeff(j,j)/rho;
+        for(Index i=0; i<k; ++i)
+          if(i!=j)
+            prod *= delta.coeff(j,i)/(dk.coeff(j)-dk.coeff(i));
+        RealScalar tmp = sqrt(numext::maxi(prod, RealScalar(0)));
+        zhat.coeffRef(j) = zk.coeff(j)<RealScalar(0) ? -tmp : tmp;
+      }
+      for(Index i=0; i<k; ++i)
+      {
+        W.col(i) = zhat.cwiseQuotient(delta.col(i));
+        W.col(i).normalize();
+      }
+    }
+
+    // Back-transformation, skipping the zero blocks of diag(Q1,Q2)
+    Index nbTop = 0, nbBottom = 0;
+    for(Index i=0; i<k; ++i)
+    {
+      if(group(kept(i))!=Bottom) ++nbTop;
+      if(group(kept(i))!=Top)    ++nbBottom;
+    }
+    MatrixType Qtop(size1,nbTop), Wtop(nbTop,k), Qbottom(size2,nbBottom), Wbottom(nbBottom,k);
+    for(Index i=0, it=0, ib=0; i<k; ++i)
+    {
+      Index col = kept(i);
+      if(group(col)!=Bottom)
+      {
+        Qtop.col(it) = Qs.col(col).head(size1);
+        Wtop.row(it++) = W.row(i);
+      }
+      if(group(col)!=Top)
+      {
+        Qbottom.col(ib) = Qs.col(col).tail(size2);
+        Wbottom.row(ib++) = W.row(i);
+      }
+    }
+    U.topRows(size1).noalias() = Qtop * Wtop;
+    U.bottomRows(size2).noalias() = Qbottom * Wbottom;
+  }
+
+  // Sort the eigenvalues of both the non-deflated and deflated parts in increasing order
+  for(Index i=0; i<nbDeflated; ++i)
+    lambda.coeffRef(k+i) = d.coeff(deflated(i));
+  IndicesType order(size);
+  for(Index i=0; i<size; ++i)
+    order(i) = i;
+  std::stable_sort(order.data(), order.data()+size, IndexLess(lambda));
+  for(Index i=0; i<size; ++i)
+  {
+    Index src = order(i);
+    diag.coeffRef(start+i) = lambda.coeff(src);
+    if(src<k)
+      Q.col(i) = U.col(src);
+    else
+      Q.col(i) = Qs.col(deflated(src-k));
+  }
+}
+
+/** \internal
+  * Computes the \a i-th root (in increasing order) of \f$ 1 + \rho \sum_j z_j^2/(d_j-\lambda) \f$, for sorted and
+  * distinct \a d, and \f$ \rho > 0 \f$. The root is returned as \f$ d_{shift} + \mu \f$, with the closest pole as
+  * the origin. Each step solves a rational model of the function that interpolates the two neighbouring poles
+  * exactly (the "middle way" of LAPACK's xLAED4), safeguarded by bisection.
+  */
+template<typename RealScalar>
+void tridiagonal_divide_and_conquer<RealScalar>::secularRoot(const VectorType& d, const VectorType& z, RealScalar rho, Index i,
+                                                               Index& shift, RealScalar& mu)
+{
+  using std::sqrt;
+  const Index k = d.size();
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+  const bool last = (i==k-1);
+
+  RealScalar lo, hi;
+  if(last)
+  {
+    // the last root lies in (d_{k-1}, d_{k-1} + rho |z|^2]
+    shift = k-1;
+    lo = 0;
+    hi = rho*z.squaredNorm();
+  }
+  else
+  {
+    // take the closest pole as origin, depending on the sign of the function at the middle of the interval
+    RealScalar mid = (d.coeff(i+1)-d.coeff(i))/RealScalar(2);
+    RealScalar f = RealScalar(1);
+    for(Index j=0; j<k; ++j)
+      f += rho*z.coeff(j)*z.coeff(j)/((d.coeff(j)-d.coeff(i))-mid);
+    if(f>=RealScalar(0)) { shift = i;   lo = 0;    hi = mid; }
+    else                 { shift = i+1; lo = -mid; hi = 0;   }
+  }
+  VectorType delta = (d.array() - d.coeff(shift)).matrix();
+
+  mu = (lo+hi)/RealScalar(2);
+  for(Index iter=0; iter<200; ++iter)
+  {
+    // f = 1 + rho*(psi + phi), with psi (resp. phi) the sum over the poles on the left (resp. right)
+    RealScalar psi = 0, dpsi = 0, phi = 0, dphi = 0, absSum = 0;
+    for(Index j=0; j<k; ++j)
+    {
+      RealScalar inv = RealScalar(1)/(delta.coeff(j)-mu);
+      RealScalar term = z.coeff(j)*z.coeff(j)*inv;
+      absSum += numext::abs(term);
+      if(j<=i) { psi += term; dpsi += term*inv; }
+      else     { phi += term; dphi += term*inv; }
+    }
+    RealScalar f = RealScalar(1) + rho*(psi+phi);
+    if(numext::abs(f) <= RealScalar(8)*eps*RealScalar(k)*(RealScalar(1)+rho*absSum))
+      break;
+    if(f<RealScalar(0)) lo = mu;
+    else                hi = mu;
+    if(hi-lo <= RealScalar(2)*eps*numext::maxi(numext::abs(lo),numext::abs(hi)))
+      break;
+
+    // Rational model c + rho*s/(a-x) + rho*S/(b-x) matching the value and the left and right derivatives.
+    // In terms of the step eta = x-mu, a root of: c*eta^2 - B*eta + C = 0.
+    RealScalar eta;
+    bool ok = false;
+    RealScalar a = delta.coeff(i)-mu;
+    RealScalar s = dpsi*a*a;
+    if(last)
+    {
+      RealScalar c = f - rho*s/a;
+      if(c>RealScalar(0))
+      {
+        eta = a + rho*s/c;
+        ok = true;
+      }
+    }
+    else
+    {
+      RealScalar b = delta.coeff(i+1)-mu;
+      RealScalar S = dphi*b*b;
+      RealScalar c = f - rho*(s/a + S/b);
+      RealScalar B = c*(a+b) + rho*(s+S);
+      RealScalar C = a*b*f;
+      RealScalar disc = B*B - RealScalar(4)*c*C;
+      if(disc>=RealScalar(0))
+      {
+        // stable formulas for both roots, then keep the one inside the bracket
+        RealScalar q = (B + (B<RealScalar(0) ? -sqrt(disc) : sqrt(disc)))/RealScalar(2);
+        RealScalar eta1 = q!=RealScalar(0) ? C/q : RealScalar(0);
+        RealScalar eta2 = c!=RealScalar(0) ? q/c : eta1;
+        if(mu+eta1>lo && mu+eta1<hi)      { eta = eta1; ok = true; }
+        else if(mu+eta2>lo && mu+eta2<hi) { eta = eta2; ok = true; }
+      }
+    }
+    RealScalar next = ok ? mu+eta : lo;
+    if(!ok || !(next>lo && next<hi))
+      next = (lo+hi)/RealScalar(2);
+    mu = next;
+  }
+}
+
+/** \internal
+  * Computes the eigendecomposition of the tridiagonal matrix given by \a diag and \a subdiag with the
+  * divide-and-conquer algorithm. On output, \a diag holds the eigenvalues in increasing order and the
+  * columns of \a eivec the corresponding eigenvectors.
+  */
+template<typename DiagType, typename SubDiagType, typename RealMatrixType>
+ComputationInfo computeFromTridiagonal_dc(DiagType& diag, SubDiagType& subdiag, const Index maxIterations, RealMatrixType& eivec)
+{
+  typedef typename DiagType::RealScalar RealScalar;
+  typedef tridiagonal_divide_and_conquer<RealScalar> SolverType;
+  typename SolverType::VectorType d = diag;
+  typename SolverType::VectorType e = subdiag;
+  typename SolverType::MatrixType Z;
+  SolverType solver(maxIterations);
+  ComputationInfo info = solver.compute(d, e, Z);
+  diag = d;
+  eivec = Z;
+  return info;
+}
+
+/** \internal
+  *
+  * \eigenvalues_module \ingroup Eigenvalues_Module
+  *
+  * \brief Computes a few of the largest eigenpairs of a real symmetric tridiagonal matrix
+  *
+  * The eigenvalues are located one by one by bisection on the Sturm sequence of \f$ T - \sigma I \f$,
+  * whose negative pivots count the eigenvalues smaller than \f$ \sigma \f$, as in LAPACK's xSTEBZ.
+  * The eigenvectors are then obtained by inverse iteration on a pivoted LU factorization of
+  * \f$ T - \lambda I \f$, and reorthogonalized against the previous vectors of the same cluster of close
+  * eigenvalues, as in LAPACK's xSTEIN. Both steps cost \f$ O(n) \f$ per eigenpair and iteration, so that
+  * only \f$ O(nk) \f$ operations are spent on the tridiagonal problem, plus \f$ O(nk^2) \f$ for the
+  * reorthogonalization of clustered eigenvalues.
+  *
+  * This is used by SelfAdjointEigenSolver::computeLargest().
+  *
+  * \sa tridiagonal_divide_and_conquer
+  */
+template<typename _RealScalar>
+class tridiagonal_largest_eigenpairs
+{
+  public:
+    typedef _RealScalar RealScalar;
+    typedef Matrix<RealScalar,Dynamic,Dynamic> MatrixType;
+    typedef Matrix<RealScalar,Dynamic,1> VectorType;
+
+    tridiagonal_largest_eigenpairs(const VectorType& diag, const VectorType& subdiag)
+      : m_diag(diag), m_subdiag(subdiag), m_info(Success)
+    {
+      Index n = m_diag.size();
+      // Gershgorin interval and one-norm of T
+      m_lower = m_upper = n>0 ? m_diag.coeff(0) : RealScalar(0);
+      m_norm = 0;
+      for(Index i=0; i<n; ++i)
+      {
+        RealScalar off = (i>0 ? numext::abs(m_subdiag.coeff(i-1)) : RealScalar(0))
+                       + (i<n-1 ? numext::abs(m_subdiag.coeff(i)) : RealScalar(0));
+        m_lower = numext::mini(m_lower, m_diag.coeff(i)-off);
+        m_upper = numext::maxi(m_upper, m_diag.coeff(i)+off);
+        m_norm = numext::maxi(m_norm, numext::abs(m_diag.coeff(i))+off);
+      }
+      m_pivmin = numext::maxi(NumTraits<RealScalar>::epsilon()*m_norm, (std::numeric_limits<RealScalar>::min)());
+    }
+
+    /** Computes the \a k largest eigenvalues in increasing order and, if \a computeEigenvectors is true,
+      * the corresponding eigenvectors in the columns of \a eivec. */
+    ComputationInfo compute(Index k, bool computeEigenvectors, VectorType& eivals, MatrixType& eivec)
+    {
+      const Index n = m_diag.size();
+      eigen_assert(k>=0 && k<=n);
+      m_info = Success;
+      eivals.resize(k);
+      if(!(numext::isfinite)(m_norm))
+        return m_info = NoConvergence;
+      for(Index i=0; i<k; ++i)
+        eivals.coeffRef(i) = bisect(n-k+i);
+      if(computeEigenvectors)
+        inverseIteration(eivals, eivec);
+      return m_info;
+    }
+
+  protected:
+    Index countBelow(RealScalar sigma) const;
+    RealScalar bisect(Index i) const;
+    void inverseIteration(const VectorType& eivals, MatrixType& eivec);
+
+    VectorType m_diag;
+    VectorType m_subdiag;
+    RealScalar m_lower, m_upper, m_norm, m_pivmin;
+    ComputationInfo m_info;
+};
+
+/** \internal Returns the number of eigenvalues smaller than \a sigma */
+template<typename RealScalar>
+Index tridiagonal_largest_eigenpairs<RealScalar>::countBelow(RealScalar sigma) const
+{
+  const Index n = m_diag.size();
+  Index count = 0;
+  RealScalar q = m_diag.coeff(0) - sigma;
+  for(Index i=0; ; ++i)
+  {
+    if(numext::abs(q) < m_pivmin)
+      q = -m_pivmin;
+    if(q<RealScalar(0))
+      ++count;
+    if(i+1==n)
+      break;
+    q = m_diag.coeff(i+1) - sigma - m_subdiag.coeff(i)*m_subdiag.coeff(i)/q;
+  }
+  return count;
+}
+
+/** \internal Returns the \a i-th smallest eigenvalue */
+template<typename RealScalar>
+RealScalar tridiagonal_largest_eigenpairs<RealScalar>::bisect(Index i) const
+{
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+  RealScalar slack = RealScalar(2)*m_pivmin + RealScalar(2)*eps*numext::maxi(numext::abs(m_lower),numext::abs(m_upper));
+  RealScalar lo = m_lower - slack;
+  RealScalar hi = m_upper + slack;
+  // the number of iterations is bounded by the number of bits of RealScalar
+  for(int iter=0; iter<4*std::numeric_limits<RealScalar>::digits; ++iter)
+  {
+    RealScalar mid = (lo+hi)/RealScalar(2);
+    if(hi-lo <= RealScalar(2)*eps*numext::maxi(numext::abs(lo),numext::abs(hi)) + m_pivmin || mid<=lo || mid>=hi)
+      break;
+    if(countBelow(mid)>i) hi = mid;
+    else                  lo = mid;
+  }
+  return (lo+hi)/RealScalar(2);
+}
+
+template<typename RealScalar>
+void tridiagonal_largest_eigenpairs<RealScalar>::inverseIteration(const VectorType& eivals, MatrixType& eivec)
+{
+  using std::sqrt;
+  const Index n = m_diag.size();
+  const Index k = eivals.size();
+  const RealScalar eps = NumTraits<RealScalar>::epsilon();
+  const RealScalar ortol = RealScalar(1e-3)*m_norm;
+  const RealScalar dtpcrt = sqrt(RealScalar(0.1)/RealScalar(n));
+  const int maxIts = 5, extraIts = 2;
+  eivec.resize(n,k);
+
+  // Pivoted LU factorization of T - lambda I (as xGTTRF): U has two superdiagonals, and the
+  // unit lower factor is stored as its multipliers with the row interchanges.
+  VectorType d(n), du(n), du2(n), dl(n), b(n);
+  Matrix<bool,Dynamic,1> swapped(n);
+
+  // deterministic, well spread starting vectors
+  unsigned int seed = 1u;
+
+  Index clusterStart = 0;
+  RealScalar prev = 0;
+  for(Index j=0; j<k; ++j)
+  {
+    RealScalar lambda = eivals.coeff(j);
+    if(j>0)
+    {
+      if(lambda-eivals.coeff(j-1) > ortol)
+        clusterStart = j;
+      // separate equal eigenvalues so that they give different factorizations
+      if(lambda-prev < RealScalar(10)*eps*numext::abs(prev))
+        lambda = prev + RealScalar(10)*eps*numext::abs(prev);
+    }
+    prev = lambda;
+
+    for(Index i=0; i<n; ++i)
+    {
+      d.coeffRef(i) = m_diag.coeff(i) - lambda;
+      du.coeffRef(i) = i<n-1 ? m_subdiag.coeff(i) : RealScalar(0);
+      dl.coeffRef(i) = du.coeff(i);
+      du2.coeffRef(i) = 0;
+      swapped.coeffRef(i) = false;
+    }
+    for(Index i=0; i<n-1; ++i)
+    {
+      if(numext::abs(d.coeff(i)) >= numext::abs(dl.coeff(i)))
+      {
+        if(d.coeff(i)!=RealScalar(0))
+        {
+          RealScalar fact = dl.coeff(i)/d.coeff(i);
+          dl.coeffRef(i) = fact;
+          d.coeffRef(i+1) -= fact*du.coeff(i);
+        }
+      }
+      else
+      {
+        RealScalar fact = d.coeff(i)/dl.coeff(i);
+        d.coeffRef(i) = dl.coeff(i);
+        dl.coeffRef(i) = fact;
+        RealScalar tmp = du.coeff(i);
+        du.coeffRef(i) = d.coeff(i+1);
+        d.coeffRef(i+1) = tmp - fact*d.coeff(i+1);
+        du2.coeffRef(i) = du.coeff(i+1);
+        du.coeffRef(i+1) = -fact*du.coeff(i+1);
+        swapped.coeffRef(i) = true;
+      }
+    }
+    // perturb the negligible pivots
+    for(Index i=0; i<n; ++i)
+      if(numext::abs(d.coeff(i)) < m_pivmin)
+        d.coeffRef(i) = d.coeff(i)<RealScalar(0) ? -m_pivmin : m_pivmin;
+
+    for(Index i=0; i<n; ++i)
+    {
+      seed = seed*1103515245u + 12345u;
+      b.coeffRef(i) = RealScalar(int((seed>>8)&0xffff)-0x8000)/RealScalar(0x8000);
+    }
+
+    int extra = 0;
+    bool converged = false;
+    for(int iter=0; iter<maxIts+extraIts && !converged; ++iter)
+    {
+      // Scale b so that the solution is O(1) only for an accurate eigenvector
+      RealScalar bnorm = b.template lpNorm<1>();
+      if(bnorm==RealScalar(0))
+        b.setOnes();
+      b *= RealScalar(n)*m_norm*numext::maxi(eps, numext::abs(d.coeff(n-1)))/b.template lpNorm<1>();
+
+      // Solve (T - lambda I) x = b
+      for(Index i=0; i<n-1; ++i)
+      {
+        if(!swapped.coeff(i))
+          b.coeffRef(i+1) -= dl.coeff(i)*b.coeff(i);
+        else
+        {
+          RealScalar tmp = b.coeff(i);
+          b.coeffRef(i) = b.coeff(i+1);
+          b.coeffRef(i+1) = tmp - dl.coeff(i)*b.coeff(i);
+        }
+      }
+      for(Index i=n-1; i>=0; --i)
+      {
+        RealScalar tmp = b.coeff(i);
+        if(i+1<n) tmp -= du.coeff(i)*b.coeff(i+1);
+        if(i+2<n) tmp -= du2.coeff(i)*b.coeff(i+2);
+        b.coeffRef(i) = tmp/d.coeff(i);
+      }
+
+      // Modified Gram-Schmidt against the previous vectors of the cluster
+      for(Index i=clusterStart; i<j; ++i)
+        b -= eivec.col(i).dot(b) * eivec.col(i);
+
+      if(b.cwiseAbs().maxCoeff() >= dtpcrt)
+      {
+        ++extra;
+        converged = extra>extraIts;
+      }
+    }
+    if(!converged)
+      m_info = NoConvergence;
+    eivec.col(j) = b.normalized();
+  }
+}
+
+/** \internal
+  * Computes the \a k largest eigenvalues of the tridiagonal matrix given by \a diag and \a subdiag, in
+  * increasing order, and the corresponding eigenvectors if \a computeEigenvectors is true.
+  */
+template<typename DiagType, typename SubDiagType, typename RealVectorType, typename RealMatrixType>
+ComputationInfo computeFromTridiagonal_largest(const DiagType& diag, const SubDiagType& subdiag, Index k, bool computeEigenvectors,
+                                               RealVectorType& eivals, RealMatrixType& eivec)
+{
+  typedef typename DiagType::RealScalar RealScalar;
+  typedef tridiagonal_largest_eigenpairs<RealScalar> SolverType;
+  typename SolverType::VectorType d = diag;
+  typename SolverType::VectorType e = subdiag;
+  typename SolverType::VectorType lambda;
+  typename SolverType::MatrixType Z;
+  SolverType solver(d, e);
+  ComputationInfo info = solver.compute(k, computeEigenvectors, lambda, Z);
+  eivals = lambda;
+  if(computeEigenvectors)
+    eivec = Z;
+  return info;
+}
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_TRIDIAGONAL_DIVIDE_AND_CONQUER_H
@@ -322,31 +322,12 @@ Tridiagonalization<MatrixType>::subDiagonal() const
 namespace internal {
 
 /** \internal
-  * Performs a tridiagonal decomposition of the selfadjoint matrix \a matA in-place.
-  *
-  * \param[in,out] matA On input the selfadjoint matrix. Only the \b lower triangular part is referenced.
-  *                     On output, the strict upper part is left unchanged, and the lower triangular part
-  *                     represents the T and Q matrices in packed format has detailed below.
-  * \param[out]    hCoeffs returned Householder coefficients (see below)
-  *
-  * On output, the tridiagonal selfadjoint matrix T is stored in the diagonal
-  * and lower sub-diagonal of the matrix \a matA.
-  * The unitary matrix Q is represented in a compact way as a product of
-  * Householder reflectors \f$ H_i \f$ such that:
-  *       \f$ Q = H_{N-1} \ldots H_1 H_0 \f$.
-  * The Householder reflectors are defined as
-  *       \f$ H_i = (I - h_i v_i v_i^T) \f$
-  * where \f$ h_i = hCoeffs[i]\f$ is the \f$ i \f$th Householder coefficient and
-  * \f$ v_i \f$ is the Householder vector defined by
-  *       \f$ v_i = [ 0, \ldots, 0, 1, matA(i+2,i), \ldots, matA(N-1,i) ]^T \f$.
-  *
-  * Implemented from Golub's "Matrix Computations", algorithm 8.3.1.
-  *
-  * \sa Tridiagonalization::packedMatrix()
+  * Unblocked tridiagonalization, see tridiagonalization_inplace(MatrixType&, CoeffVectorType&).
+  * Every column costs a selfadjoint matrix-vector product and a rank-2 update of the trailing matrix.
   */
 template<typename MatrixType, typename CoeffVectorType>
 EIGEN_DEVICE_FUNC
-void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
+void tridiagonalization_inplace_unblocked(MatrixType& matA, CoeffVectorType& hCoeffs)
 {
   using numext::conj;
   typedef typename MatrixType::Scalar Scalar;
@@ -379,6 +360,158 @@ void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
   }
 }
 
+/** \internal
+  * Reduces the first \a bs columns of the selfadjoint matrix \a matA (lower part) and accumulates
+  * in \a W the matrix such that the similarity transformation of the trailing part by the \a bs
+  * reflectors reads \f$ A_{22} - V W^* - W V^* \f$, with V the Householder vectors stored
+  * in \a matA. This is LAPACK's xLATRD. The trailing part of \a matA is not modified, and the
+  * unit entries of the Householder vectors are left in place; \a betas receives the subdiagonal.
+  */
+template<typename MatrixType, typename CoeffVectorType, typename WorkType, typename BetaVectorType>
+void tridiagonalization_panel(MatrixType& matA, CoeffVectorType& hCoeffs, WorkType& W, BetaVectorType& betas, Index bs)
+{
+  using numext::conj;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index n = matA.rows();
+
+  for (Index j = 0; j<bs; ++j)
+  {
+    Index remainingSize = n-j-1;
+
+    // Apply the previous reflectors of the panel to the current column.
+    if(j>0)
+    {
+      matA.col(j).tail(n-j).noalias() -= matA.block(j,0,n-j,j) * W.row(j).head(j).adjoint();
+      matA.col(j).tail(n-j).noalias() -= W.block(j,0,n-j,j) * matA.row(j).head(j).adjoint();
+      matA.coeffRef(j,j) = numext::real(matA.coeff(j,j));
+    }
+
+    RealScalar beta;
+    Scalar h;
+    matA.col(j).tail(remainingSize).makeHouseholderInPlace(h, beta);
+    matA.coeffRef(j+1,j) = 1;
+    betas.coeffRef(j) = beta;
+    hCoeffs.coeffRef(j) = h;
+
+    // w = conj(h) * (A - V W^* - W V^*) v for the not yet updated trailing part A.
+    typename MatrixType::ColXpr::SegmentReturnType v = matA.col(j).tail(remainingSize);
+    typename WorkType::ColXpr::SegmentReturnType w = W.col(j).tail(remainingSize);
+    w.noalias() = matA.bottomRightCorner(remainingSize,remainingSize).template selfadjointView<Lower>() * v;
+    if(j>0)
+    {
+      // the first j entries of the j-th column of W are unused and serve as workspace
+      W.col(j).head(j).noalias() = W.block(j+1,0,remainingSize,j).adjoint() * v;
+      w.noalias() -= matA.block(j+1,0,remainingSize,j) * W.col(j).head(j);
+      W.col(j).head(j).noalias() = matA.block(j+1,0,remainingSize,j).adjoint() * v;
+      w.noalias() -= W.block(j+1,0,remainingSize,j) * W.col(j).head(j);
+    }
+    w *= conj(h);
+    w += (conj(h)*RealScalar(-0.5)*(w.dot(v))) * v;
+  }
+}
+
+/** \internal
+  * Blocked tridiagonalization, see tridiagonalization_inplace(MatrixType&, CoeffVectorType&).
+  */
+template<typename MatrixType, typename CoeffVectorType>
+void tridiagonalization_inplace_blocked(MatrixType& matA, CoeffVectorType& hCoeffs, Index maxBlockSize=32)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> WorkType;
+  typedef Block<MatrixType,Dynamic,Dynamic> BlockType;
+  Index n = matA.rows();
+  eigen_assert(n==matA.cols());
+  eigen_assert(n==hCoeffs.size()+1 || n==1);
+
+  // Below this size, the cost of the trailing updates does not justify the panel overhead.
+  const Index unblockedSize = (std::max)(Index(128), 4*maxBlockSize);
+
+  WorkType W(n, maxBlockSize), VW, WV;
+  Matrix<RealScalar,Dynamic,1> betas(maxBlockSize);
+  Index k = 0;
+  for (; n-k > unblockedSize; k += maxBlockSize)
+  {
+    Index bs = maxBlockSize;
+    Index size = n-k;
+    Index tsize = size-bs;
+    BlockType A = matA.bottomRightCorner(size,size);
+    Block<WorkType,Dynamic,Dynamic> Wk = W.topRows(size);
+    typename CoeffVectorType::SegmentReturnType hCoeffsSegment = hCoeffs.segment(k,bs);
+    tridiagonalization_panel(A, hCoeffsSegment, Wk, betas, bs);
+
+    // A22 -= V W^* + W V^* as a single product [V W] [W V]^* of depth 2*bs
+    VW.resize(tsize, 2*bs);
+    WV.resize(tsize, 2*bs);
+    VW.leftCols(bs) = WV.rightCols(bs) = A.bottomLeftCorner(tsize, bs);
+    VW.rightCols(bs) = WV.leftCols(bs) = Wk.bottomRows(tsize);
+    A.bottomRightCorner(tsize,tsize).template triangularView<Lower>() -= VW * WV.adjoint();
+
+    for (Index j = 0; j<bs; ++j)
+      A.coeffRef(j+1,j) = betas.coeff(j);
+  }
+
+  if(k==0)
+  {
+    tridiagonalization_inplace_unblocked(matA, hCoeffs);
+    return;
+  }
+  BlockType A = matA.bottomRightCorner(n-k,n-k);
+  typename CoeffVectorType::SegmentReturnType hCoeffsTail = hCoeffs.tail(n-k-1);
+  tridiagonalization_inplace_unblocked(A, hCoeffsTail);
+}
+
+template<typename MatrixType, typename CoeffVectorType, bool Blocked = (MatrixType::MaxColsAtCompileTime==Dynamic)>
+struct tridiagonalization_inplace_impl
+{
+  static EIGEN_DEVICE_FUNC void run(MatrixType& matA, CoeffVectorType& hCoeffs)
+  {
+    tridiagonalization_inplace_unblocked(matA, hCoeffs);
+  }
+};
+
+template<typename MatrixType, typename CoeffVectorType>
+struct tridiagonalization_inplace_impl<MatrixType,CoeffVectorType,true>
+{
+  static void run(MatrixType& matA, CoeffVectorType& hCoeffs)
+  {
+    tridiagonalization_inplace_blocked(matA, hCoeffs);
+  }
+};
+
+/** \internal
+  * Performs a tridiagonal decomposition of the selfadjoint matrix \a matA in-place.
+  *
+  * \param[in,out] matA On input the selfadjoint matrix. Only the \b lower triangular part is referenced.
+  *                     On output, the strict upper part is left unchanged, and the lower triangular part
+  *                     represents the T and Q matrices in packed format has detailed below.
+  * \param[out]    hCoeffs returned Householder coefficients (see below)
+  *
+  * On output, the tridiagonal selfadjoint matrix T is stored in the diagonal
+  * and lower sub-diagonal of the matrix \a matA.
+  * The unitary matrix Q is represented in a compact way as a product of
+  * Householder reflectors \f$ H_i \f$ such that:
+  *       \f$ Q = H_{N-1} \ldots H_1 H_0 \f$.
+  * The Householder reflectors are defined as
+  *       \f$ H_i = (I - h_i v_i v_i^T) \f$
+  * where \f$ h_i = hCoeffs[i]\f$ is the \f$ i \f$th Householder coefficient and
+  * \f$ v_i \f$ is the Householder vector defined by
+  *       \f$ v_i = [ 0, \ldots, 0, 1, matA(i+2,i), \ldots, matA(N-1,i) ]^T \f$.
+  *
+  * Implemented from Golub's "Matrix Computations", algorithm 8.3.1. Large dynamic-size
+  * matrices are reduced by panels of columns whose reflectors are applied to the trailing
+  * matrix with a single rank-2k update, as in LAPACK's xSYTRD.
+  *
+  * \sa Tridiagonalization::packedMatrix()
+  */
+template<typename MatrixType, typename CoeffVectorType>
+EIGEN_DEVICE_FUNC
+void tridiagonalization_inplace(MatrixType& matA, CoeffVectorType& hCoeffs)
+{
+  tridiagonalization_inplace_impl<MatrixType,CoeffVectorType>::run(matA, hCoeffs);
+}
+
 // forward declaration, implementation at the end of this file
 template<typename MatrixType,
          int Size=MatrixType::ColsAtCompileTime,
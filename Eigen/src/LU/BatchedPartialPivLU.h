@@ -0,0 +1,343 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_BATCHED_PARTIALLU_H
+#define EIGEN_BATCHED_PARTIALLU_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal Swaps the rows \a k and \a piv of the first \a cols columns, where \a piv holds a row index per lane.
+  * The distinct pivot rows are gathered first, so that row \a k is read and written once per column.
+  */
+template<typename Packet, typename View>
+EIGEN_STRONG_INLINE void batched_swap_rows(const View& m, Index first, const Packet& piv, Index k, Index cols)
+{
+  typedef typename unpacket_traits<Packet>::type Scalar;
+  enum { PacketSize = unpacket_traits<Packet>::size };
+  Scalar pivots[PacketSize];
+  pstoreu<Scalar>(pivots, piv);
+  Index rows[PacketSize];
+  Packet masks[PacketSize];
+  Index count = 0;
+  for(Index l = 0; l < PacketSize; ++l)
+  {
+    bool done = pivots[l] == Scalar(k);
+    for(Index l2 = 0; l2 < l && !done; ++l2)
+      done = pivots[l2] == pivots[l];
+    if(done)
+      continue;
+    rows[count] = Index(pivots[l]);
+    masks[count] = pcmp_eq(piv, pset1<Packet>(pivots[l]));
+    ++count;
+  }
+  if(count == 0)
+    return;
+  for(Index j = 0; j < cols; ++j)
+  {
+    const Packet ak = m.template load<Packet>(first, k, j);
+    Packet swapped = ak;
+    for(Index t = 0; t < count; ++t)
+    {
+      Packet ai = m.template load<Packet>(first, rows[t], j);
+      swapped = pselect(masks[t], ai, swapped);
+      m.store(first, rows[t], j, pselect(masks[t], ak, ai));
+    }
+    m.store(first, k, j, swapped);
+  }
+}
+
+/** \internal LU factorization with partial pivoting, in place, of the problems starting at \a first */
+template<typename Scalar, int Size>
+struct batched_partial_lu_factor_kernel
+{
+  batched_partial_lu_factor_kernel(const batched_view<Scalar,Size>& matrix, const batched_view<Scalar,1>& pivots)
+    : m_matrix(matrix), m_pivots(pivots)
+  {}
+
+  template<typename Packet, int Packets>
+  void run(Index first) const
+  {
+    enum { PacketSize = unpacket_traits<Packet>::size, Width = Packets * PacketSize };
+    const Index n = m_matrix.rows();
+    ei_declare_aligned_stack_constructed_variable(Scalar, data, n*n*Width, 0);
+    const batched_view<Scalar,Size,Width> a(data, Width, n);
+    batched_copy<Packet,Packets>(m_matrix, first, a, 0, n);
+    for(Index p = 0; p < Packets; ++p)
+      factor<Packet>(a, p*PacketSize, m_pivots, first + p*PacketSize);
+    batched_copy<Packet,Packets>(a, 0, m_matrix, first, n);
+  }
+
+  template<typename Packet, typename View>
+  static void factor(const View& a, Index first, const batched_view<Scalar,1>& pivots, Index pivotsFirst)
+  {
+    const Index n = a.rows();
+    const Packet zero = pset1<Packet>(Scalar(0));
+    const Packet one = pset1<Packet>(Scalar(1));
+    for(Index k = 0; k < n; ++k)
+    {
+      // lane-wise search of the pivot, the row indices are stored as scalars
+      Packet biggest = pabs(a.template load<Packet>(first, k, k));
+      Packet piv = pset1<Packet>(Scalar(k));
+      for(Index i = k+1; i < n; ++i)
+      {
+        Packet aik = pabs(a.template load<Packet>(first, i, k));
+        Packet isBigger = pcmp_lt(biggest, aik);
+        biggest = pselect(isBigger, aik, biggest);
+        piv = pselect(isBigger, pset1<Packet>(Scalar(i)), piv);
+      }
+      pivots.store(pivotsFirst, 0, k, piv);
+      batched_swap_rows(a, first, piv, k, n);
+
+      // a zero pivot means the whole column is zero: skip the division as PartialPivLU does
+      Packet pivot = a.template load<Packet>(first, k, k);
+      pivot = pselect(pcmp_eq(pivot, zero), one, pivot);
+      for(Index i = k+1; i < n; ++i)
+        a.store(first, i, k, pdiv(a.template load<Packet>(first, i, k), pivot));
+
+      for(Index j = k+1; j < n; ++j)
+      {
+        Packet u = a.template load<Packet>(first, k, j);
+        for(Index i = k+1; i < n; ++i)
+          a.store(first, i, j, psub(a.template load<Packet>(first, i, j), pmul(a.template load<Packet>(first, i, k), u)));
+      }
+    }
+  }
+
+  batched_view<Scalar,Size> m_matrix;
+  batched_view<Scalar,1> m_pivots;
+};
+
+/** \internal Solves P L U X = B in place in \a rhs, for the problems starting at \a first */
+template<typename Scalar, int Size>
+struct batched_partial_lu_solve_kernel
+{
+  batched_partial_lu_solve_kernel(const batched_view<const Scalar,Size>& matrix, const batched_view<const Scalar,1>& pivots,
+                                  const batched_view<Scalar,Size>& rhs, Index rhsCols)
+    : m_matrix(matrix), m_pivots(pivots), m_rhs(rhs), m_rhsCols(rhsCols)
+  {}
+
+  template<typename Packet, int Packets>
+  void run(Index first) const
+  {
+    enum { PacketSize = unpacket_traits<Packet>::size, Width = Packets * PacketSize };
+    const Index n = m_matrix.rows();
+    ei_declare_aligned_stack_constructed_variable(Scalar, data, n*n*Width, 0);
+    const batched_view<Scalar,Size,Width> lu(data, Width, n);
+    batched_copy<Packet,Packets>(m_matrix, first, lu, 0, n);
+    ei_declare_aligned_stack_constructed_variable(Scalar, rhsData, n*m_rhsCols*Width, 0);
+    const batched_view<Scalar,Size,Width> x(rhsData, Width, n);
+    batched_copy<Packet,Packets>(m_rhs, first, x, 0, m_rhsCols);
+    for(Index p = 0; p < Packets; ++p)
+    {
+      // P^T B
+      for(Index k = 0; k < n; ++k)
+        batched_swap_rows(x, p*PacketSize, m_pivots.template load<Packet>(first + p*PacketSize, 0, k), k, m_rhsCols);
+      solve<Packet>(lu, x, p*PacketSize, m_rhsCols);
+    }
+    batched_copy<Packet,Packets>(x, 0, m_rhs, first, m_rhsCols);
+  }
+
+  template<typename Packet, typename View>
+  static void solve(const View& lu, const View& x, Index first, Index rhsCols)
+  {
+    const Index n = lu.rows();
+    for(Index c = 0; c < rhsCols; ++c)
+    {
+      // L y = P^T b
+      for(Index k = 0; k < n; ++k)
+      {
+        Packet xk = x.template load<Packet>(first, k, c);
+        for(Index i = k+1; i < n; ++i)
+          x.store(first, i, c, psub(x.template load<Packet>(first, i, c), pmul(lu.template load<Packet>(first, i, k), xk)));
+      }
+      // U x = y
+      for(Index k = n-1; k >= 0; --k)
+      {
+        Packet xk = pdiv(x.template load<Packet>(first, k, c), lu.template load<Packet>(first, k, k));
+        x.store(first, k, c, xk);
+        for(Index i = 0; i < k; ++i)
+          x.store(first, i, c, psub(x.template load<Packet>(first, i, c), pmul(lu.template load<Packet>(first, i, k), xk)));
+      }
+    }
+  }
+
+  batched_view<const Scalar,Size> m_matrix;
+  batched_view<const Scalar,1> m_pivots;
+  batched_view<Scalar,Size> m_rhs;
+  Index m_rhsCols;
+};
+
+} // end namespace internal
+
+/** \ingroup LU_Module
+  *
+  * \class BatchedPartialPivLU
+  *
+  * \brief LU decompositions with partial pivoting of a batch of small matrices of the same size
+  *
+  * \tparam _MatrixType the type of one matrix of the batch, e.g. Matrix<double,8,8> or MatrixXd
+  *
+  * This class computes the decompositions A = PLU of many independent square invertible matrices at once,
+  * with the same pivoting strategy as PartialPivLU. The batch is stored in an interleaved ("structure of
+  * arrays") layout: it is a B x n<sup>2</sup> matrix of type BatchType, whose row \a b holds the coefficients
+  * of the \a b-th n x n matrix in column-major order. Hence, the same coefficient of consecutive matrices is
+  * contiguous in memory, and each SIMD lane of a packet factorizes its own matrix: the pivot search and the row
+  * interchanges are performed lane-wise with masks, and the B problems advance in lockstep. For matrices up to
+  * about 12x12 this is faster than decomposing them one after the other, beyond that the row interchanges of the
+  * different lanes dominate. The right hand sides of solve() use the same layout, with n x k matrices stored in
+  * B x (n*k) batches.
+  *
+  * When the size is not fixed at compile time, it is deduced from the number of columns of the batch. Large
+  * batches are split among the available threads (see \ref TopicMultiThreading).
+  *
+  * \code
+  * MatrixXd batch(1000, 8*8);           // row b: the 64 coefficients of the b-th 8x8 matrix
+  * BatchedPartialPivLU<Matrix<double,8,8> > lu(batch);
+  * MatrixXd x = lu.solve(rhs);          // rhs is a 1000 x 8 batch of vectors
+  * \endcode
+  *
+  * As for PartialPivLU, the matrices must be invertible, which is not checked. This class is restricted to
+  * real scalar types.
+  *
+  * \sa class PartialPivLU, class BatchedLLT
+  */
+template<typename _MatrixType> class BatchedPartialPivLU
+{
+  public:
+    typedef _MatrixType MatrixType;
+    typedef typename MatrixType::Scalar Scalar;
+    typedef Matrix<Scalar,Dynamic,Dynamic> BatchType;
+    enum { SizeAtCompileTime = MatrixType::RowsAtCompileTime };
+
+    /** \brief Default Constructor.
+      *
+      * The default constructor is useful in cases in which the user intends to
+      * perform decompositions via BatchedPartialPivLU::compute(const MatrixBase<InputType>&).
+      */
+    BatchedPartialPivLU() : m_size(0), m_isInitialized(false)
+    {
+      check_template_parameters();
+    }
+
+    /** \brief Constructor computing the decompositions of a batch of matrices
+      *
+      * \param batch the B x n<sup>2</sup> batch of matrices to decompose
+      */
+    template<typename InputType>
+    explicit BatchedPartialPivLU(const MatrixBase<InputType>& batch) : m_size(0), m_isInitialized(false)
+    {
+      check_template_parameters();
+      compute(batch.derived());
+    }
+
+    template<typename InputType>
+    BatchedPartialPivLU& compute(const MatrixBase<InputType>& batch);
+
+    /** \returns the number of matrices of the batch */
+    Index batchSize() const { return m_lu.rows(); }
+
+    /** \returns the size of each matrix of the batch */
+    Index size() const { return m_size; }
+
+    /** \returns the LU decompositions of the batch, in the layout of the input: the strictly lower parts store
+      * the unit-lower-triangular factors L, and the upper parts the factors U.
+      */
+    const BatchType& matrixLU() const
+    {
+      eigen_assert(m_isInitialized && "BatchedPartialPivLU is not initialized.");
+      return m_lu;
+    }
+
+    /** \returns the B x n batch of row transpositions: at step \a k, row \a k of the \a b-th matrix was swapped
+      * with row <tt>pivots()(b,k)</tt>. The indices are stored as scalars, as in TranspositionsBase::indices().
+      */
+    const BatchType& pivots() const
+    {
+      eigen_assert(m_isInitialized && "BatchedPartialPivLU is not initialized.");
+      return m_pivots;
+    }
+
+    /** \returns the solutions x<sub>b</sub> of A<sub>b</sub> x<sub>b</sub> = b<sub>b</sub>, using the current decompositions
+      *
+      * \param rhs the B x (n*k) batch of the n x k right hand sides
+      */
+    template<typename Rhs>
+    BatchType solve(const MatrixBase<Rhs>& rhs) const;
+
+    /** \returns the inverses of the matrices of the batch, in the same layout */
+    BatchType inverse() const
+    {
+      eigen_assert(m_isInitialized && "BatchedPartialPivLU is not initialized.");
+      BatchType id = BatchType::Zero(batchSize(), m_size*m_size);
+      for(Index i = 0; i < m_size; ++i)
+        id.col(i*(m_size+1)).setOnes();
+      return solve(id);
+    }
+
+  protected:
+
+    static void check_template_parameters()
+    {
+      EIGEN_STATIC_ASSERT_NON_INTEGER(Scalar);
+      EIGEN_STATIC_ASSERT(!NumTraits<Scalar>::IsComplex, NUMERIC_TYPE_MUST_BE_REAL);
+      EIGEN_STATIC_ASSERT(MatrixType::RowsAtCompileTime==MatrixType::ColsAtCompileTime, YOU_MIXED_MATRICES_OF_DIFFERENT_SIZES);
+    }
+
+    BatchType m_lu;
+    BatchType m_pivots;
+    Index m_size;
+    bool m_isInitialized;
+};
+
+/** Computes the LU decompositions of the matrices of \a batch, a B x n<sup>2</sup> batch of square invertible matrices.
+  *
+  * \returns a reference to *this
+  */
+template<typename MatrixType>
+template<typename InputType>
+BatchedPartialPivLU<MatrixType>& BatchedPartialPivLU<MatrixType>::compute(const MatrixBase<InputType>& batch)
+{
+  m_size = SizeAtCompileTime==Dynamic ? Index(std::sqrt(double(batch.cols())) + 0.5) : Index(SizeAtCompileTime);
+  eigen_assert(m_size*m_size == batch.cols() && "BatchedPartialPivLU: the batch must have n^2 columns");
+
+  m_lu = batch;
+  m_pivots.resize(m_lu.rows(), m_size);
+  internal::batched_run<Scalar>(
+      internal::batched_partial_lu_factor_kernel<Scalar,SizeAtCompileTime>(
+          internal::batched_view<Scalar,SizeAtCompileTime>(m_lu.data(), m_lu.rows(), m_size),
+          internal::batched_view<Scalar,1>(m_pivots.data(), m_lu.rows(), 1)),
+      m_lu.rows());
+
+  m_isInitialized = true;
+  return *this;
+}
+
+template<typename MatrixType>
+template<typename Rhs>
+typename BatchedPartialPivLU<MatrixType>::BatchType BatchedPartialPivLU<MatrixType>::solve(const MatrixBase<Rhs>& rhs) const
+{
+  eigen_assert(m_isInitialized && "BatchedPartialPivLU is not initialized.");
+  eigen_assert(rhs.rows() == batchSize() && "BatchedPartialPivLU::solve(): invalid number of rows of the right hand side batch");
+  eigen_assert((m_size == 0 || rhs.cols() % m_size == 0) && "BatchedPartialPivLU::solve(): invalid number of columns of the right hand side batch");
+
+  BatchType dst = rhs;
+  if(m_size == 0)
+    return dst;
+  internal::batched_run<Scalar>(
+      internal::batched_partial_lu_solve_kernel<Scalar,SizeAtCompileTime>(
+          internal::batched_view<const Scalar,SizeAtCompileTime>(m_lu.data(), batchSize(), m_size),
+          internal::batched_view<const Scalar,1>(m_pivots.data(), batchSize(), 1),
+          internal::batched_view<Scalar,SizeAtCompileTime>(dst.data(), batchSize(), m_size), dst.cols() / m_size),
+      batchSize());
+  return dst;
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_BATCHED_PARTIALLU_H
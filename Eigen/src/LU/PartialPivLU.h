@@ -69,6 +69,10 @@ struct enable_if_ref<Ref<T>,Derived> {
   *
   * The data of the LU decomposition can be directly accessed through the methods matrixLU(), permutationP().
   *
+  * When several threads are available (see \ref TopicMultiThreading), large matrices are factorized with
+  * a look-ahead: each panel of columns is factorized by a recursive algorithm while the remaining columns
+  * are concurrently updated with the previous panel. The pivoting strategy is the same as in the sequential case.
+  *
   * This class supports the \link InplaceDecomposition inplace decomposition \endlink mechanism.
   *
   * \sa MatrixBase::partialPivLu(), MatrixBase::determinant(), MatrixBase::inverse(), MatrixBase::computeInverse(), class FullPivLU
@@ -335,6 +339,8 @@ template<typename Scalar, int StorageOrder, typename PivIndex, int SizeAtCompile
 struct partial_lu_impl
 {
   static const int UnBlockedBound = 16;
+  // below this size, the blocked algorithm is always sequential
+  static const int ParallelBound = 256;
   static const bool UnBlockedAtCompileTime = SizeAtCompileTime!=Dynamic && SizeAtCompileTime<=UnBlockedBound;
   static const int ActualSizeAtCompileTime = UnBlockedAtCompileTime ? SizeAtCompileTime : Dynamic;
   // Remaining rows and columns at compile-time:
@@ -448,6 +454,9 @@ struct partial_lu_impl
       blockSize = (std::min)((std::max)(blockSize,Index(8)), maxBlockSize);
     }
 
+    if(size>=ParallelBound && nbThreads()>1)
+      return parallel_blocked_lu(rows, cols, lu_data, luStride, row_transpositions, nb_transpositions, blockSize);
+
     nb_transpositions = 0;
     Index first_zero_pivot = -1;
     for(Index k = 0; k < size; k+=blockSize)
@@ -497,6 +506,165 @@ struct partial_lu_impl
     }
     return first_zero_pivot;
   }
+
+  /** \internal performs the LU decomposition in-place of the tall panel represented by
+    * \a rows, \a cols, \a lu_data, and \a lu_stride by recursively splitting its columns in halves.
+    *
+    * Contrary to blocked_lu(), the row interchanges of each half are only applied to the columns
+    * of the panel, and most of the work is carried out by a triangular solve and a matrix product
+    * whose sizes grow with the width of the panel.
+    *
+    * \returns The index of the first pivot which is exactly zero if any, or a negative number otherwise.
+    */
+  static Index recursive_lu(Index rows, Index cols, Scalar* lu_data, Index luStride, PivIndex* row_transpositions, PivIndex& nb_transpositions)
+  {
+    MatrixTypeRef lu = MatrixType::Map(lu_data, rows, cols, OuterStride<>(luStride));
+    eigen_internal_assert(rows>=cols);
+
+    if(UnBlockedAtCompileTime || cols<=UnBlockedBound)
+      return unblocked_lu(lu, row_transpositions, nb_transpositions);
+
+    const Index n1 = cols/2;
+    const Index n2 = cols-n1;
+
+    // factorize the left half of the panel, and apply its row interchanges to the right half
+    PivIndex nb_transpositions_left;
+    Index first_zero_pivot = recursive_lu(rows, n1, lu_data, luStride, row_transpositions, nb_transpositions_left);
+    BlockType A_1 = lu.rightCols(n2);
+    for(Index i=0; i<n1; ++i)
+      A_1.row(i).swap(A_1.row(row_transpositions[i]));
+
+    //   A11 | A12
+    //   A21 | A22
+    BlockType A11 = lu.topLeftCorner(n1,n1);
+    BlockType A12 = lu.topRightCorner(n1,n2);
+    BlockType A21 = lu.bottomLeftCorner(rows-n1,n1);
+    BlockType A22 = lu.bottomRightCorner(rows-n1,n2);
+    A11.template triangularView<UnitLower>().solveInPlace(A12);
+    A22.noalias() -= A21 * A12;
+
+    // factorize the updated right half, and apply its row interchanges to the left half
+    PivIndex nb_transpositions_right;
+    Index ret = recursive_lu(rows-n1, n2, &lu.coeffRef(n1,n1), luStride, row_transpositions+n1, nb_transpositions_right);
+    if(ret>=0 && first_zero_pivot==-1)
+      first_zero_pivot = n1+ret;
+    BlockType A_0 = lu.leftCols(n1);
+    for(Index i=n1; i<cols; ++i)
+    {
+      Index piv = (row_transpositions[i] += internal::convert_index<PivIndex>(n1));
+      A_0.row(i).swap(A_0.row(piv));
+    }
+
+    nb_transpositions = nb_transpositions_left + nb_transpositions_right;
+    return first_zero_pivot;
+  }
+
+  /** \internal One step of parallel_blocked_lu(): once the panel starting at \a k has been factorized,
+    * it applies its row interchanges and its trailing update to the remaining columns. The columns are
+    * split in independent tasks:
+    *  - task 0 updates the next panel and immediately factorizes it,
+    *  - the following tasks update contiguous groups of the columns lying beyond the next panel,
+    *  - the last task applies the row interchanges of the current panel to the already factorized columns.
+    */
+  struct lookahead_task
+  {
+    lookahead_task(Index rows, Scalar* lu_data, Index luStride, PivIndex* row_transpositions,
+                   Index k, Index bs, Index nbs, Index tail, Index nb_chunks)
+      : m_rows(rows), m_data(lu_data), m_stride(luStride), m_transpositions(row_transpositions),
+        m_k(k), m_bs(bs), m_nbs(nbs), m_tail(tail), m_nb_chunks(nb_chunks),
+        m_panel_first_zero_pivot(-1), m_panel_nb_transpositions(0)
+    {}
+
+    Index num_tasks() const { return (m_nbs>0 ? 1 : 0) + m_nb_chunks + (m_k>0 ? 1 : 0); }
+
+    // applies the row interchanges and the update of the current panel to the columns [start,start+count)
+    void update(Index start, Index count) const
+    {
+      MatrixTypeRef lu = MatrixType::Map(m_data, m_rows, start+count, OuterStride<>(m_stride));
+      BlockType A_2 = lu.rightCols(count);
+      for(Index i=m_k; i<m_k+m_bs; ++i)
+        A_2.row(i).swap(A_2.row(m_transpositions[i]));
+
+      Index trows = m_rows-m_k-m_bs;
+      BlockType A11 = lu.block(m_k,m_k,m_bs,m_bs);
+      BlockType A12 = A_2.middleRows(m_k,m_bs);
+      A11.template triangularView<UnitLower>().solveInPlace(A12);
+      if(trows)
+        A_2.bottomRows(trows).noalias() -= lu.block(m_k+m_bs,m_k,trows,m_bs) * A12;
+    }
+
+    void operator()(Index i) const
+    {
+      const Index next = m_k+m_bs;
+      if(m_nbs>0 && i==0)
+      {
+        update(next, m_nbs);
+        m_panel_first_zero_pivot = recursive_lu(m_rows-next, m_nbs, m_data+next*(m_stride+1), m_stride,
+                                                m_transpositions+next, m_panel_nb_transpositions);
+        return;
+      }
+      if(m_nbs>0)
+        --i;
+      if(i<m_nb_chunks)
+      {
+        Index start = next + m_nbs + (m_tail*i)/m_nb_chunks;
+        Index end = next + m_nbs + (m_tail*(i+1))/m_nb_chunks;
+        update(start, end-start);
+        return;
+      }
+      MatrixTypeRef lu = MatrixType::Map(m_data, m_rows, m_k, OuterStride<>(m_stride));
+      for(Index j=m_k; j<next; ++j)
+        lu.row(j).swap(lu.row(m_transpositions[j]));
+    }
+
+    const Index m_rows;
+    Scalar* m_data;
+    const Index m_stride;
+    PivIndex* m_transpositions;
+    const Index m_k, m_bs, m_nbs, m_tail, m_nb_chunks;
+    mutable Index m_panel_first_zero_pivot;
+    mutable PivIndex m_panel_nb_transpositions;
+  };
+
+  /** \internal Multi-threaded variant of blocked_lu() with a look-ahead of one panel.
+    *
+    * The panels are factorized by recursive_lu(). While the trailing columns are updated with the
+    * current panel by concurrent tasks, one of them first updates the next panel and factorizes it,
+    * such that the factorization of the panels, which is hard to parallelize, is overlapped with
+    * the trailing updates instead of serializing the whole algorithm. This is still a partial
+    * pivoting: the pivot of each column is its largest entry at the time it is factorized.
+    */
+  static Index parallel_blocked_lu(Index rows, Index cols, Scalar* lu_data, Index luStride, PivIndex* row_transpositions, PivIndex& nb_transpositions, Index blockSize)
+  {
+    const Index size = (std::min)(rows,cols);
+    // Minimal number of columns of the groups of trailing columns updated by each task.
+    const Index minChunkSize = 32;
+    const Index maxChunks = 2*nbThreads();
+
+    Index bs = (std::min)(size,blockSize);
+    Index first_zero_pivot = recursive_lu(rows, bs, lu_data, luStride, row_transpositions, nb_transpositions);
+    for(Index k = 0; k < size; k+=bs)
+    {
+      bs = (std::min)(size-k,blockSize);
+      const Index next = k+bs;
+      const Index nbs = (std::min)(size-next,blockSize);
+      const Index tail = size-next-nbs;
+      const Index nb_chunks = (std::min)(maxChunks, (tail+minChunkSize-1)/minChunkSize);
+
+      lookahead_task task(rows, lu_data, luStride, row_transpositions, k, bs, nbs, tail, nb_chunks);
+      parallelize_tasks(task.num_tasks(), task);
+
+      if(nbs>0)
+      {
+        if(task.m_panel_first_zero_pivot>=0 && first_zero_pivot==-1)
+          first_zero_pivot = next+task.m_panel_first_zero_pivot;
+        nb_transpositions += task.m_panel_nb_transpositions;
+        for(Index i=next; i<next+nbs; ++i)
+          row_transpositions[i] += internal::convert_index<PivIndex>(next);
+      }
+    }
+    return first_zero_pivot;
+  }
 };
 
 /** \internal performs the LU decomposition with partial pivoting in-place.
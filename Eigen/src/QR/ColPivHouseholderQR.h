@@ -43,6 +43,8 @@ template<typename _MatrixType> struct traits<ColPivHouseholderQR<_MatrixType> >
   *
   * This decomposition performs column pivoting in order to be rank-revealing and improve
   * numerical stability. It is slower than HouseholderQR, and faster than FullPivHouseholderQR.
+  * Large matrices are factorized by panels, as in LAPACK's xGEQP3, so that half of the work is
+  * performed by matrix-matrix products.
   *
   * This class supports the \link InplaceDecomposition inplace decomposition \endlink mechanism.
   * 
@@ -432,6 +434,8 @@ template<typename _MatrixType> class ColPivHouseholderQR
     }
 
     void computeInPlace();
+    Index computePanelInPlace(Index k, Index blockSize, Index& number_of_transpositions,
+                              RealScalar threshold_helper, RealScalar norm_downdate_threshold);
 
     MatrixType m_qr;
     HCoeffsType m_hCoeffs;
@@ -514,7 +518,14 @@ void ColPivHouseholderQR<MatrixType>::computeInPlace()
   m_nonzero_pivots = size; // the generic case is that in which all pivots are nonzero (invertible case)
   m_maxpivot = RealScalar(0);
 
-  for(Index k = 0; k < size; ++k)
+  // Large matrices are processed by panels whose updates of the trailing matrix are deferred
+  // and applied by a single matrix-matrix product, the last columns by the unblocked algorithm.
+  const Index blockSize = 32;
+  Index k = 0;
+  while(size - k > blockSize && rows - k > blockSize)
+    k += computePanelInPlace(k, blockSize, number_of_transpositions, threshold_helper, norm_downdate_threshold);
+
+  for(; k < size; ++k)
   {
     // first, we look up in our table m_colNormsUpdated which column has the biggest norm
     Index biggest_col_index;
@@ -581,6 +592,116 @@ void ColPivHouseholderQR<MatrixType>::computeInPlace()
   m_isInitialized = true;
 }
 
+/** \internal Factorizes at most \a blockSize columns starting at \a k, in the spirit of LAPACK's xLAQPS.
+  *
+  * The Householder reflectors of the panel are only applied to the pivot column and to the pivot row when
+  * they are needed, while their effect on the trailing matrix is accumulated in a matrix \c F such that the
+  * trailing matrix eventually becomes \c A-V*F^*, which is applied once by a matrix-matrix product.
+  * The panel stops early when a downdated column norm becomes inaccurate, so that it can be recomputed from
+  * the updated trailing matrix.
+  *
+  * \returns the number of factorized columns
+  */
+template<typename MatrixType>
+Index ColPivHouseholderQR<MatrixType>::computePanelInPlace(Index k, Index blockSize, Index& number_of_transpositions,
+                                                           RealScalar threshold_helper, RealScalar norm_downdate_threshold)
+{
+  using std::abs;
+  typedef Matrix<Scalar,Dynamic,Dynamic> BlockType;
+  typedef Matrix<Scalar,Dynamic,1> VectorType;
+
+  const Index rows = m_qr.rows();
+  const Index cols = m_qr.cols();
+  const Index size = m_qr.diagonalSize();
+  const Index trailing = cols - k;
+  const Index panel = (std::min)(blockSize, size - k);
+
+  BlockType F = BlockType::Zero(trailing, panel);
+  VectorType auxv(panel);
+
+  Index j = 0;
+  bool recompute_norms = false;
+  while(j < panel && !recompute_norms)
+  {
+    const Index c = k + j;
+
+    Index biggest_col_index;
+    RealScalar biggest_col_sq_norm = numext::abs2(m_colNormsUpdated.tail(cols-c).maxCoeff(&biggest_col_index));
+    biggest_col_index += c;
+
+    if(m_nonzero_pivots==size && biggest_col_sq_norm < threshold_helper * RealScalar(rows-c))
+      m_nonzero_pivots = c;
+
+    m_colsTranspositions.coeffRef(c) = biggest_col_index;
+    if(c != biggest_col_index) {
+      m_qr.col(c).swap(m_qr.col(biggest_col_index));
+      F.row(j).swap(F.row(biggest_col_index-k));
+      std::swap(m_colNormsUpdated.coeffRef(c), m_colNormsUpdated.coeffRef(biggest_col_index));
+      std::swap(m_colNormsDirect.coeffRef(c), m_colNormsDirect.coeffRef(biggest_col_index));
+      ++number_of_transpositions;
+    }
+
+    // apply the previous reflectors of the panel to the pivot column
+    if(j > 0)
+      m_qr.col(c).tail(rows-c).noalias() -= m_qr.block(c, k, rows-c, j) * F.row(j).head(j).adjoint();
+
+    RealScalar beta;
+    m_qr.col(c).tail(rows-c).makeHouseholderInPlace(m_hCoeffs.coeffRef(c), beta);
+    if(abs(beta) > m_maxpivot) m_maxpivot = abs(beta);
+    const Scalar tau = numext::conj(m_hCoeffs.coeff(c));
+    m_qr.coeffRef(c,c) = Scalar(1);
+
+    // F(:,j) = conj(tau) * (A - V F^*)^* v, restricted to the columns after c
+    const Index remaining = cols - c - 1;
+    F.col(j).tail(remaining).noalias() = tau * (m_qr.block(c, c+1, rows-c, remaining).adjoint() * m_qr.col(c).tail(rows-c));
+    if(j > 0)
+    {
+      auxv.head(j).noalias() = -tau * (m_qr.block(c, k, rows-c, j).adjoint() * m_qr.col(c).tail(rows-c));
+      F.col(j).tail(remaining).noalias() += F.block(j+1, 0, remaining, j) * auxv.head(j);
+    }
+
+    // the pivot row is now final
+    m_qr.row(c).segment(c+1, remaining).noalias() -= m_qr.row(c).segment(k, j+1) * F.block(j+1, 0, remaining, j+1).adjoint();
+    m_qr.coeffRef(c,c) = beta;
+
+    // update our table of norms of the columns, see computeInPlace()
+    for(Index i = c + 1; i < cols; ++i) {
+      if (m_colNormsUpdated.coeffRef(i) != RealScalar(0)) {
+        RealScalar temp = abs(m_qr.coeffRef(c, i)) / m_colNormsUpdated.coeffRef(i);
+        temp = (RealScalar(1) + temp) * (RealScalar(1) - temp);
+        temp = temp <  RealScalar(0) ? RealScalar(0) : temp;
+        RealScalar temp2 = temp * numext::abs2<RealScalar>(m_colNormsUpdated.coeffRef(i) /
+                                                           m_colNormsDirect.coeffRef(i));
+        if (temp2 <= norm_downdate_threshold) {
+          // the norm is recomputed once the trailing matrix is up to date
+          m_colNormsDirect.coeffRef(i) = RealScalar(-1);
+          recompute_norms = true;
+        } else {
+          m_colNormsUpdated.coeffRef(i) *= numext::sqrt(temp);
+        }
+      }
+    }
+    ++j;
+  }
+
+  // apply the panel to the trailing matrix: A -= V * F^*
+  const Index next = k + j;
+  m_qr.bottomRightCorner(rows-next, cols-next).noalias()
+      -= m_qr.block(next, k, rows-next, j) * F.bottomLeftCorner(cols-next, j).adjoint();
+
+  if(recompute_norms)
+  {
+    for(Index i = next; i < cols; ++i) {
+      if(m_colNormsDirect.coeff(i) < RealScalar(0)) {
+        m_colNormsDirect.coeffRef(i) = m_qr.col(i).tail(rows-next).norm();
+        m_colNormsUpdated.coeffRef(i) = m_colNormsDirect.coeff(i);
+      }
+    }
+  }
+
+  return j;
+}
+
 #ifndef EIGEN_PARSED_BY_DOXYGEN
 template<typename _MatrixType>
 template<typename RhsType, typename DstType>
@@ -0,0 +1,425 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_TALLSKINNYQR_H
+#define EIGEN_TALLSKINNYQR_H
+
+namespace Eigen {
+
+template<typename MatrixType> class TallSkinnyQR;
+template<typename TallSkinnyQRType> struct TallSkinnyQRMatrixQReturnType;
+template<typename TallSkinnyQRType> struct TallSkinnyQRMatrixQAdjointReturnType;
+template<typename TallSkinnyQRType, typename Derived> struct TallSkinnyQR_QProduct;
+
+namespace internal {
+template<typename _MatrixType> struct traits<TallSkinnyQR<_MatrixType> >
+ : traits<_MatrixType>
+{
+  typedef MatrixXpr XprKind;
+  typedef SolverStorage StorageKind;
+  typedef int StorageIndex;
+  enum { Flags = 0 };
+};
+
+template<typename TallSkinnyQRType, typename Derived> struct traits<TallSkinnyQR_QProduct<TallSkinnyQRType, Derived> >
+{
+  typedef typename Derived::PlainObject ReturnType;
+};
+
+} // end namespace internal
+
+/** \ingroup QR_Module
+  *
+  *
+  * \class TallSkinnyQR
+  *
+  * \brief Communication-avoiding Householder QR decomposition of a tall and skinny matrix
+  *
+  * \tparam _MatrixType the type of the matrix of which we are computing the QR decomposition
+  *
+  * This class computes the same decomposition \f$ \mathbf{A} = \mathbf{Q} \, \mathbf{R} \f$ as HouseholderQR,
+  * for matrices having many more rows than columns, with the TSQR algorithm:
+  *  - the rows are split into chunks of chunkRows() rows which are factorized independently;
+  *  - the R factors of the chunks are then combined pairwise along a binary reduction tree, each node
+  *    computing the QR decomposition of two stacked R factors.
+  *
+  * The chunks, and then the nodes of each level of the tree, are processed concurrently when several threads
+  * are available (see \ref TopicMultiThreading). Since the chunking does not depend on the number of threads,
+  * neither does the result. Each chunk being factorized while it is in cache, the cost is dominated by a single
+  * pass over the matrix.
+  *
+  * The factor \b R is the upper triangular matrix returned by matrixR(). The factor \b Q is kept implicitly as
+  * the Householder sequences of the chunks and of the tree nodes; householderQ() returns an expression which can
+  * be used to perform products with \b Q or its adjoint.
+  *
+  * Like HouseholderQR, no pivoting is performed, and solve() assumes that \b A has full column rank.
+  *
+  * \sa class HouseholderQR
+  */
+template<typename _MatrixType> class TallSkinnyQR
+        : public SolverBase<TallSkinnyQR<_MatrixType> >
+{
+  public:
+
+    typedef _MatrixType MatrixType;
+    typedef SolverBase<TallSkinnyQR> Base;
+    friend class SolverBase<TallSkinnyQR>;
+
+    EIGEN_GENERIC_PUBLIC_INTERFACE(TallSkinnyQR)
+    typedef Matrix<Scalar,Dynamic,Dynamic> TreeType;
+    typedef Matrix<Scalar,Dynamic,1> HCoeffsType;
+    typedef TallSkinnyQRMatrixQReturnType<TallSkinnyQR> MatrixQReturnType;
+
+    /**
+      * \brief Default Constructor.
+      *
+      * The default constructor is useful in cases in which the user intends to
+      * perform decompositions via TallSkinnyQR::compute(const MatrixType&).
+      */
+    TallSkinnyQR() : m_chunkRows(0), m_chunks(0), m_isInitialized(false) {}
+
+    /** \brief Constructs a QR factorization from a given matrix
+      *
+      * This constructor computes the QR factorization of the matrix \a matrix by calling
+      * the method compute().
+      */
+    template<typename InputType>
+    explicit TallSkinnyQR(const EigenBase<InputType>& matrix)
+      : m_chunkRows(0), m_chunks(0), m_isInitialized(false)
+    {
+      compute(matrix.derived());
+    }
+
+    #ifdef EIGEN_PARSED_BY_DOXYGEN
+    /** This method finds the least-squares solution x of the equation Ax=b, where A is the matrix of which
+      * *this is the QR decomposition.
+      *
+      * \param b the right-hand-side of the equation to solve.
+      *
+      * \returns the solution minimizing the Euclidean norm \f$ \Vert A x - b \Vert \f$.
+      */
+    template<typename Rhs>
+    inline const Solve<TallSkinnyQR, Rhs>
+    solve(const MatrixBase<Rhs>& b) const;
+    #endif
+
+    /** \returns an expression of the unitary matrix Q.
+      *
+      * The returned expression can be used to perform products with \b Q and its adjoint, for instance
+      * the thin factor \b Q is obtained by:
+      * \code
+      * MatrixXd thinQ = tsqr.householderQ() * MatrixXd::Identity(A.rows(), A.cols());
+      * \endcode
+      */
+    MatrixQReturnType householderQ() const
+    {
+      eigen_assert(m_isInitialized && "TallSkinnyQR is not initialized.");
+      return MatrixQReturnType(*this);
+    }
+
+    /** \returns an expression of the upper triangular factor R */
+    TriangularView<const typename MatrixType::ConstRowsBlockXpr, Upper> matrixR() const
+    {
+      eigen_assert(m_isInitialized && "TallSkinnyQR is not initialized.");
+      return m_qr.topRows(m_qr.cols()).template triangularView<Upper>();
+    }
+
+    template<typename InputType>
+    TallSkinnyQR& compute(const EigenBase<InputType>& matrix) {
+      m_qr = matrix.derived();
+      computeInPlace();
+      return *this;
+    }
+
+    /** Sets the number of rows of the chunks factorized independently (default is 0, meaning max(256, 32*cols())).
+      * Smaller chunks expose more parallelism at the price of a larger reduction tree.
+      */
+    TallSkinnyQR& setChunkRows(Index rows)
+    {
+      eigen_assert(rows >= 0);
+      m_chunkRows = rows;
+      return *this;
+    }
+
+    /** \returns the number of rows of the chunks used by the last call to compute() */
+    Index chunkRows() const
+    {
+      eigen_assert(m_isInitialized && "TallSkinnyQR is not initialized.");
+      return actualChunkRows();
+    }
+
+    inline Index rows() const { return m_qr.rows(); }
+    inline Index cols() const { return m_qr.cols(); }
+
+    #ifndef EIGEN_PARSED_BY_DOXYGEN
+    template<typename RhsType, typename DstType>
+    void _solve_impl(const RhsType &rhs, DstType &dst) const;
+
+    template<typename Dest>
+    void applyQOnTheLeft(Dest& dst, bool adjoint) const;
+    #endif
+
+  protected:
+
+    static void check_template_parameters()
+    {
+      EIGEN_STATIC_ASSERT_NON_INTEGER(Scalar);
+    }
+
+    void computeInPlace();
+
+    Index actualChunkRows() const
+    {
+      return m_chunkRows > 0 ? (std::max)(m_chunkRows, m_qr.cols()) : (std::max)(Index(256), 32*m_qr.cols());
+    }
+    Index chunkStart(Index c) const { return c * actualChunkRows(); }
+    Index chunkSize(Index c) const { return c+1 < m_chunks ? actualChunkRows() : m_qr.rows() - chunkStart(c); }
+
+    /** \internal Applies the leaf reflectors of chunk \a c, or their adjoint, to the corresponding rows of \a dst */
+    template<typename Dest>
+    void applyLeaf(Index c, Dest& dst, bool adjoint) const
+    {
+      typename Dest::RowsBlockXpr block = dst.middleRows(chunkStart(c), chunkSize(c));
+      if(adjoint) block.applyOnTheLeft(householderSequence(m_qr.middleRows(chunkStart(c), chunkSize(c)),
+                                                          m_hCoeffs.segment(c*cols(), cols()).conjugate()).adjoint());
+      else        block.applyOnTheLeft(householderSequence(m_qr.middleRows(chunkStart(c), chunkSize(c)),
+                                                          m_hCoeffs.segment(c*cols(), cols()).conjugate()));
+    }
+
+    /** \internal Applies the reflectors of the tree \a node combining chunks \a a and \a b, or their adjoint,
+      * to the top rows of these chunks in \a dst */
+    template<typename Dest>
+    void applyNode(Index node, Index a, Index b, Dest& dst, bool adjoint) const
+    {
+      const Index n = cols();
+      Matrix<Scalar,Dynamic,Dynamic> tmp(2*n, dst.cols());
+      tmp.topRows(n) = dst.middleRows(chunkStart(a), n);
+      tmp.bottomRows(n) = dst.middleRows(chunkStart(b), n);
+      if(adjoint) tmp.applyOnTheLeft(householderSequence(m_tree.middleCols(node*n, n),
+                                                         m_treeHCoeffs.segment(node*n, n).conjugate()).adjoint());
+      else        tmp.applyOnTheLeft(householderSequence(m_tree.middleCols(node*n, n),
+                                                         m_treeHCoeffs.segment(node*n, n).conjugate()));
+      dst.middleRows(chunkStart(a), n) = tmp.topRows(n);
+      dst.middleRows(chunkStart(b), n) = tmp.bottomRows(n);
+    }
+
+    /** \internal Factorizes the chunks concurrently */
+    struct LeafTask
+    {
+      LeafTask(TallSkinnyQR& qr) : m_qr(qr) {}
+      void operator()(Index c) const
+      {
+        const Index n = m_qr.cols();
+        typename MatrixType::RowsBlockXpr chunk = m_qr.m_qr.middleRows(m_qr.chunkStart(c), m_qr.chunkSize(c));
+        Block<HCoeffsType,Dynamic,1> hCoeffs = m_qr.m_hCoeffs.segment(c*n, n);
+        internal::householder_qr_inplace_blocked<typename MatrixType::RowsBlockXpr, Block<HCoeffsType,Dynamic,1> >
+          ::run(chunk, hCoeffs, 48);
+      }
+      TallSkinnyQR& m_qr;
+    };
+
+    /** \internal Combines the R factors of the chunks \a a and \a b into the one of chunk \a a, for the nodes of a level */
+    struct NodeTask
+    {
+      NodeTask(TallSkinnyQR& qr, Index firstNode, Index stride) : m_qr(qr), m_firstNode(firstNode), m_stride(stride) {}
+      void operator()(Index i) const
+      {
+        const Index n = m_qr.cols();
+        const Index node = m_firstNode + i, a = 2*m_stride*i, b = a + m_stride;
+        typename TreeType::ColsBlockXpr stacked = m_qr.m_tree.middleCols(node*n, n);
+        Block<HCoeffsType,Dynamic,1> hCoeffs = m_qr.m_treeHCoeffs.segment(node*n, n);
+        stacked.topRows(n) = m_qr.m_qr.middleRows(m_qr.chunkStart(a), n).template triangularView<Upper>();
+        stacked.bottomRows(n) = m_qr.m_qr.middleRows(m_qr.chunkStart(b), n).template triangularView<Upper>();
+        internal::householder_qr_inplace_blocked<typename TreeType::ColsBlockXpr, Block<HCoeffsType,Dynamic,1> >
+          ::run(stacked, hCoeffs, 48);
+        m_qr.m_qr.middleRows(m_qr.chunkStart(a), n).template triangularView<Upper>() = stacked.topRows(n);
+      }
+      TallSkinnyQR& m_qr;
+      Index m_firstNode, m_stride;
+    };
+
+    /** \internal Applies the leaf reflectors, or their adjoint, concurrently */
+    template<typename Dest>
+    struct ApplyLeafTask
+    {
+      ApplyLeafTask(const TallSkinnyQR& qr, Dest& dst, bool adjoint) : m_qr(qr), m_dst(dst), m_adjoint(adjoint) {}
+      void operator()(Index c) const { m_qr.applyLeaf(c, m_dst, m_adjoint); }
+      const TallSkinnyQR& m_qr;
+      Dest& m_dst;
+      bool m_adjoint;
+    };
+
+    /** \internal Applies the reflectors of the nodes of a level, or their adjoint, concurrently */
+    template<typename Dest>
+    struct ApplyNodeTask
+    {
+      ApplyNodeTask(const TallSkinnyQR& qr, Dest& dst, bool adjoint, Index firstNode, Index stride)
+        : m_qr(qr), m_dst(dst), m_adjoint(adjoint), m_firstNode(firstNode), m_stride(stride) {}
+      void operator()(Index i) const
+      {
+        const Index a = 2*m_stride*i;
+        m_qr.applyNode(m_firstNode + i, a, a + m_stride, m_dst, m_adjoint);
+      }
+      const TallSkinnyQR& m_qr;
+      Dest& m_dst;
+      bool m_adjoint;
+      Index m_firstNode, m_stride;
+    };
+
+    /** \internal \returns the number of tree nodes at the level of the given \a stride */
+    Index levelSize(Index stride) const { return (m_chunks + stride - 1) / (2*stride); }
+
+    MatrixType m_qr;
+    HCoeffsType m_hCoeffs;
+    TreeType m_tree;
+    HCoeffsType m_treeHCoeffs;
+    Index m_chunkRows, m_chunks;
+    bool m_isInitialized;
+};
+
+/** Performs the QR factorization of the given matrix \a matrix. The result of
+  * the factorization is stored into \c *this, and a reference to \c *this
+  * is returned.
+  *
+  * \sa class TallSkinnyQR, TallSkinnyQR(const MatrixType&)
+  */
+template<typename MatrixType>
+void TallSkinnyQR<MatrixType>::computeInPlace()
+{
+  check_template_parameters();
+
+  const Index rows = m_qr.rows();
+  const Index cols = m_qr.cols();
+  eigen_assert(rows >= cols && "TallSkinnyQR requires at least as many rows as columns");
+
+  m_chunks = (std::max)(Index(1), rows / actualChunkRows());
+  m_hCoeffs.resize(m_chunks * cols);
+  m_tree.resize(2*cols, (m_chunks-1) * cols);
+  m_treeHCoeffs.resize((m_chunks-1) * cols);
+
+  internal::parallelize_tasks(m_chunks, LeafTask(*this));
+
+  // The nodes of a level combine the chunks a and a+stride, the R factor of the subtree ending up in chunk a.
+  Index node = 0;
+  for(Index stride = 1; stride < m_chunks; stride *= 2)
+  {
+    const Index count = levelSize(stride);
+    internal::parallelize_tasks(count, NodeTask(*this, node, stride));
+    node += count;
+  }
+
+  m_isInitialized = true;
+}
+
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+/** \internal Replaces \a dst by Q * dst, or by Q^* * dst if \a adjoint is true */
+template<typename MatrixType>
+template<typename Dest>
+void TallSkinnyQR<MatrixType>::applyQOnTheLeft(Dest& dst, bool adjoint) const
+{
+  eigen_assert(m_isInitialized && "TallSkinnyQR is not initialized.");
+  eigen_assert(dst.rows() == rows());
+
+  // the nodes are numbered level by level
+  Index levels = 0, nodes = 0;
+  for(Index stride = 1; stride < m_chunks; stride *= 2, ++levels)
+    nodes += levelSize(stride);
+
+  if(adjoint)
+  {
+    internal::parallelize_tasks(m_chunks, ApplyLeafTask<Dest>(*this, dst, true));
+    Index node = 0;
+    for(Index stride = 1; stride < m_chunks; stride *= 2)
+    {
+      const Index count = levelSize(stride);
+      internal::parallelize_tasks(count, ApplyNodeTask<Dest>(*this, dst, true, node, stride));
+      node += count;
+    }
+  }
+  else
+  {
+    Index node = nodes;
+    for(Index level = levels-1; level >= 0; --level)
+    {
+      const Index stride = Index(1) << level;
+      const Index count = levelSize(stride);
+      node -= count;
+      internal::parallelize_tasks(count, ApplyNodeTask<Dest>(*this, dst, false, node, stride));
+    }
+    internal::parallelize_tasks(m_chunks, ApplyLeafTask<Dest>(*this, dst, false));
+  }
+}
+
+template<typename _MatrixType>
+template<typename RhsType, typename DstType>
+void TallSkinnyQR<_MatrixType>::_solve_impl(const RhsType &rhs, DstType &dst) const
+{
+  typename RhsType::PlainObject c(rhs);
+  applyQOnTheLeft(c, true);
+  matrixR().solveInPlace(c.topRows(cols()));
+  dst = c.topRows(cols());
+}
+#endif
+
+/** \internal Product of the factor Q of a TallSkinnyQR, or of its adjoint, with a dense matrix */
+template<typename TallSkinnyQRType, typename Derived>
+struct TallSkinnyQR_QProduct : ReturnByValue<TallSkinnyQR_QProduct<TallSkinnyQRType, Derived> >
+{
+  TallSkinnyQR_QProduct(const TallSkinnyQRType& qr, const Derived& other, bool adjoint)
+    : m_qr(qr), m_other(other), m_adjoint(adjoint) {}
+  inline Index rows() const { return m_qr.rows(); }
+  inline Index cols() const { return m_other.cols(); }
+
+  template<typename Dest>
+  void evalTo(Dest& dst) const
+  {
+    dst = m_other;
+    m_qr.applyQOnTheLeft(dst, m_adjoint);
+  }
+
+  const TallSkinnyQRType& m_qr;
+  const Derived& m_other;
+  bool m_adjoint;
+};
+
+/** \internal Expression of the factor Q of a TallSkinnyQR */
+template<typename TallSkinnyQRType>
+struct TallSkinnyQRMatrixQReturnType
+{
+  explicit TallSkinnyQRMatrixQReturnType(const TallSkinnyQRType& qr) : m_qr(qr) {}
+  template<typename Derived>
+  TallSkinnyQR_QProduct<TallSkinnyQRType, Derived> operator*(const MatrixBase<Derived>& other) const
+  {
+    return TallSkinnyQR_QProduct<TallSkinnyQRType, Derived>(m_qr, other.derived(), false);
+  }
+  TallSkinnyQRMatrixQAdjointReturnType<TallSkinnyQRType> adjoint() const
+  {
+    return TallSkinnyQRMatrixQAdjointReturnType<TallSkinnyQRType>(m_qr);
+  }
+  inline Index rows() const { return m_qr.rows(); }
+  inline Index cols() const { return m_qr.rows(); }
+  const TallSkinnyQRType& m_qr;
+};
+
+/** \internal Expression of the adjoint of the factor Q of a TallSkinnyQR */
+template<typename TallSkinnyQRType>
+struct TallSkinnyQRMatrixQAdjointReturnType
+{
+  explicit TallSkinnyQRMatrixQAdjointReturnType(const TallSkinnyQRType& qr) : m_qr(qr) {}
+  template<typename Derived>
+  TallSkinnyQR_QProduct<TallSkinnyQRType, Derived> operator*(const MatrixBase<Derived>& other) const
+  {
+    return TallSkinnyQR_QProduct<TallSkinnyQRType, Derived>(m_qr, other.derived(), true);
+  }
+  inline Index rows() const { return m_qr.rows(); }
+  inline Index cols() const { return m_qr.rows(); }
+  const TallSkinnyQRType& m_qr;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_TALLSKINNYQR_H
@@ -66,6 +66,11 @@ struct traits<BDCSVD<_MatrixType> >
  * For small matrice (<16), it is thus preferable to directly use JacobiSVD. For larger ones, BDCSVD is highly
  * recommended and can several order of magnitude faster.
  *
+ * When several threads are available (see \ref TopicMultiThreading), the independent subproblems of the
+ * divide-and-conquer recursion, as well as the merges of the lower levels, are solved concurrently, and the
+ * matrix-vector products of the bidiagonalization are split across the threads. The result does not depend
+ * on the number of threads.
+ *
  * \warning this algorithm is unlikely to provide accurate result when compiled with unsafe math optimizations.
  * For instance, this concerns Intel's compiler (ICC), which performs such optimization by default unless
  * you compile with the \c -fp-model \c precise option. Likewise, the \c -ffast-math option of GCC or clang will
@@ -183,6 +188,8 @@ public:
 private:
   void allocate(Index rows, Index cols, unsigned int computationOptions);
   void divide(Index firstCol, Index lastCol, Index firstRowW, Index firstColW, Index shift);
+  void merge(Index firstCol, Index lastCol, Index firstRowW, Index firstColW, Index shift, RealScalar alphaK, RealScalar betaK);
+  void parallelDivide(Index threads);
   void computeSVDofM(Index firstCol, Index n, MatrixXr& U, VectorType& singVals, MatrixXr& V);
   void computeSingVals(const ArrayRef& col0, const ArrayRef& diag, const IndicesRef& perm, VectorType& singVals, ArrayRef shifts, ArrayRef mus);
   void perturbCol0(const ArrayRef& col0, const ArrayRef& diag, const IndicesRef& perm, const VectorType& singVals, const ArrayRef& shifts, const ArrayRef& mus, ArrayRef zhat);
@@ -195,6 +202,31 @@ private:
   void structured_update(Block<MatrixXr,Dynamic,Dynamic> A, const MatrixXr &B, Index n1);
   static RealScalar secularEq(RealScalar x, const ArrayRef& col0, const ArrayRef& diag, const IndicesRef &perm, const ArrayRef& diagShifted, RealScalar shift);
 
+  // A subproblem of the divide and conquer tree, see parallelDivide()
+  struct DivideNode
+  {
+    Index firstCol, lastCol, firstRowW, firstColW, shift;
+    RealScalar alphaK, betaK;
+    Index size() const { return lastCol - firstCol + 1; }
+  };
+  typedef BDCSVD<MatrixXr> SubproblemSolver;
+  template<typename> friend class BDCSVD;
+  void setupSubproblem(SubproblemSolver& sub, const DivideNode& node, bool merged) const;
+  void collectSubproblem(SubproblemSolver& sub, const DivideNode& node);
+  struct SubproblemTask
+  {
+    SubproblemTask(std::vector<SubproblemSolver>& subs, const DivideNode* nodes, bool merged) : m_subs(subs), m_nodes(nodes), m_merged(merged) {}
+    void operator()(Index i) const
+    {
+      const Index n = m_nodes[i].size();
+      if(m_merged) m_subs[i].merge(0, n - 1, 0, 0, 0, m_nodes[i].alphaK, m_nodes[i].betaK);
+      else         m_subs[i].divide(0, n - 1, 0, 0, 0);
+    }
+    std::vector<SubproblemSolver>& m_subs;
+    const DivideNode* m_nodes;
+    bool m_merged;
+  };
+
 protected:
   MatrixXr m_naiveU, m_naiveV;
   MatrixXr m_computed;
@@ -295,7 +327,7 @@ BDCSVD<MatrixType>& BDCSVD<MatrixType>::compute(const MatrixType& matrix, unsign
   // FIXME this line involves a temporary matrix
   m_computed.topRows(m_diagSize) = bid.bidiagonal().toDenseMatrix().transpose();
   m_computed.template bottomRows<1>().setZero();
-  divide(0, m_diagSize - 1, 0, 0, 0);
+  parallelDivide(nbThreads());
   if (m_info != Success && m_info != NoConvergence) {
     m_isInitialized = true;
     return *this;
@@ -420,12 +452,8 @@ void BDCSVD<MatrixType>::divide(Eigen::Index firstCol, Eigen::Index lastCol, Eig
   using std::abs;
   const Index n = lastCol - firstCol + 1;
   const Index k = n/2;
-  const RealScalar considerZero = (std::numeric_limits<RealScalar>::min)();
   RealScalar alphaK;
   RealScalar betaK; 
-  RealScalar r0; 
-  RealScalar lambda, phi, c0, s0;
-  VectorType l, f;
   // We use the other algorithm which is more efficient for small 
   // matrices.
   if (n < m_algoswap)
@@ -457,6 +485,24 @@ void BDCSVD<MatrixType>::divide(Eigen::Index firstCol, Eigen::Index lastCol, Eig
   divide(firstCol, k - 1 + firstCol, firstRowW, firstColW + 1, shift + 1);
   if (m_info != Success && m_info != NoConvergence) return;
 
+  merge(firstCol, lastCol, firstRowW, firstColW, shift, alphaK, betaK);
+}// end divide
+
+// Merges the SVDs of the two halves of the submatrix computed by divide(firstCol, lastCol, firstRowW, firstColW, shift),
+// where alphaK and betaK are the entries of the bidiagonal matrix coupling the two halves.
+template<typename MatrixType>
+void BDCSVD<MatrixType>::merge(Eigen::Index firstCol, Eigen::Index lastCol, Eigen::Index firstRowW, Eigen::Index firstColW, Eigen::Index shift,
+                               RealScalar alphaK, RealScalar betaK)
+{
+  using std::sqrt;
+  using std::abs;
+  const Index n = lastCol - firstCol + 1;
+  const Index k = n/2;
+  const RealScalar considerZero = (std::numeric_limits<RealScalar>::min)();
+  RealScalar r0; 
+  RealScalar lambda, phi, c0, s0;
+  VectorType l, f;
+
   if (m_compU)
   {
     lambda = m_naiveU(firstCol + k, firstCol + k);
@@ -585,7 +631,115 @@ void BDCSVD<MatrixType>::divide(Eigen::Index firstCol, Eigen::Index lastCol, Eig
   
   m_computed.block(firstCol + shift, firstCol + shift, n, n).setZero();
   m_computed.block(firstCol + shift, firstCol + shift, n, n).diagonal() = singVals;
-}// end divide
+}// end merge
+
+// Copies the data of the subproblem described by node into sub, which then solves it as a standalone
+// problem, that is with firstCol, firstRowW, firstColW and shift all equal to 0. If merged is true,
+// the two halves of the subproblem have already been solved and the subproblem only has to be merged,
+// otherwise the subproblem still holds its bidiagonal input.
+template<typename MatrixType>
+void BDCSVD<MatrixType>::setupSubproblem(SubproblemSolver& sub, const DivideNode& node, bool merged) const
+{
+  const Index n = node.size();
+  const Index start = merged ? node.firstCol + node.shift : node.firstCol;
+  sub.m_compU = m_compU;
+  sub.m_compV = m_compV;
+  sub.m_algoswap = m_algoswap;
+  sub.m_info = Success;
+  sub.m_numIters = 0;
+  sub.m_computed = m_computed.block(start, start, n + 1, n);
+  if (m_compU) sub.m_naiveU = m_naiveU.block(node.firstCol, node.firstCol, n + 1, n + 1);
+  else         sub.m_naiveU = m_naiveU.middleCols(node.firstCol, n + 1);
+  if (m_compV) sub.m_naiveV = m_naiveV.block(node.firstRowW, node.firstColW, n, n);
+  sub.m_workspace.resize((n+1)*(n+1)*3);
+  sub.m_workspaceI.resize(3*n);
+}
+
+// Copies back the results of a subproblem set up by setupSubproblem.
+template<typename MatrixType>
+void BDCSVD<MatrixType>::collectSubproblem(SubproblemSolver& sub, const DivideNode& node)
+{
+  const Index n = node.size();
+  m_computed.block(node.firstCol + node.shift, node.firstCol + node.shift, n + 1, n) = sub.m_computed;
+  if (m_compU) m_naiveU.block(node.firstCol, node.firstCol, n + 1, n + 1) = sub.m_naiveU;
+  else         m_naiveU.middleCols(node.firstCol, n + 1) = sub.m_naiveU;
+  if (m_compV) m_naiveV.block(node.firstRowW, node.firstColW, n, n) = sub.m_naiveV;
+  m_numIters += sub.m_numIters;
+  if (sub.m_info != Success && (m_info == Success || m_info == NoConvergence))
+    m_info = sub.m_info;
+}
+
+// Multi-threaded equivalent of divide(0, m_diagSize - 1, 0, 0, 0).
+//
+// The top levels of the recursion tree of divide() are unrolled such that the subproblems of the same level
+// can be processed concurrently. The leaves of this tree, and then the merges of each level, are solved in
+// parallel as standalone problems by distinct instances of BDCSVD having their own copy of the data and their
+// own workspace. This is possible because, when the input of all the leaves has been gathered beforehand,
+// the subproblems of the same level only write to disjoint parts of m_computed, m_naiveU, and m_naiveV.
+// The levels with fewer subproblems than threads are merged in place, one after the other, and rather rely on
+// the multi-threaded matrix products of structured_update().
+template<typename MatrixType>
+void BDCSVD<MatrixType>::parallelDivide(Index threads)
+{
+  // we do not split the subproblems below this size
+  const Index minSubproblemSize = (std::max)(Index(64), Index(2*m_algoswap));
+  const Index maxDepth = 6;
+  Index depth = 0;
+  while(depth<maxDepth && (Index(1)<<depth) < 2*threads && (m_diagSize>>(depth+1)) >= minSubproblemSize)
+    ++depth;
+  if(threads<=1 || depth==0)
+  {
+    divide(0, m_diagSize - 1, 0, 0, 0);
+    return;
+  }
+
+  // the nodes of the level l of the tree are nodes[2^l-1], ..., nodes[2^(l+1)-2], from right to left
+  const Index nbNodes = (Index(1)<<(depth+1)) - 1;
+  DivideNode nodes[(1<<(maxDepth+1)) - 1];
+  nodes[0].firstCol = 0;
+  nodes[0].lastCol = m_diagSize - 1;
+  nodes[0].firstRowW = nodes[0].firstColW = nodes[0].shift = 0;
+  for(Index i=0; 2*i+2<nbNodes; ++i)
+  {
+    // same splitting as divide()
+    DivideNode& node = nodes[i];
+    const Index k = node.size()/2;
+    node.alphaK = m_computed(node.firstCol + k, node.firstCol + k);
+    node.betaK = m_computed(node.firstCol + k + 1, node.firstCol + k);
+    DivideNode& right = nodes[2*i+1];
+    right.firstCol = node.firstCol + k + 1;
+    right.lastCol = node.lastCol;
+    right.firstRowW = node.firstRowW + k + 1;
+    right.firstColW = node.firstColW + k + 1;
+    right.shift = node.shift;
+    DivideNode& left = nodes[2*i+2];
+    left.firstCol = node.firstCol;
+    left.lastCol = node.firstCol + k - 1;
+    left.firstRowW = node.firstRowW;
+    left.firstColW = node.firstColW + 1;
+    left.shift = node.shift + 1;
+  }
+
+  const Index nbLeaves = Index(1)<<depth;
+  std::vector<SubproblemSolver> subs(nbLeaves);
+  for(Index level=depth; level>=0 && (m_info==Success || m_info==NoConvergence); --level)
+  {
+    const Index first = (Index(1)<<level) - 1;
+    const Index count = Index(1)<<level;
+    const bool merged = level<depth;
+    if(merged && count<threads)
+    {
+      for(Index i=first; i<first+count; ++i)
+        merge(nodes[i].firstCol, nodes[i].lastCol, nodes[i].firstRowW, nodes[i].firstColW, nodes[i].shift, nodes[i].alphaK, nodes[i].betaK);
+      continue;
+    }
+    for(Index i=0; i<count; ++i)
+      setupSubproblem(subs[i], nodes[first+i], merged);
+    internal::parallelize_tasks(count, SubproblemTask(subs, nodes+first, merged));
+    for(Index i=0; i<count; ++i)
+      collectSubproblem(subs[i], nodes[first+i]);
+  }
+}
 
 // Compute SVD of m_computed.block(firstCol, firstCol, n + 1, n); this block only has non-zeros in
 // the first column and on the diagonal and has undergone deflation, so diagonal is in increasing
@@ -0,0 +1,262 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_RANDOMIZEDSVD_H
+#define EIGEN_RANDOMIZEDSVD_H
+
+namespace Eigen {
+
+template<typename _MatrixType> class RandomizedSVD;
+
+namespace internal {
+
+template<typename _MatrixType>
+struct traits<RandomizedSVD<_MatrixType> >
+        : traits<_MatrixType>
+{
+  typedef _MatrixType MatrixType;
+};
+
+} // end namespace internal
+
+/** \ingroup SVD_Module
+ *
+ *
+ * \class RandomizedSVD
+ *
+ * \brief Truncated SVD computed by a randomized range finder
+ *
+ * \tparam _MatrixType the dense matrix type used to store the factors, it must have a dynamic number of rows and columns
+ *
+ * This class computes an approximation of the \a k largest singular values of a n-by-p matrix \a A, and of the
+ * corresponding singular vectors, without ever forming a full decomposition:
+ *  -# a random p-by-l matrix \f$ \Omega \f$, with \f$ l = k + \f$ oversampling(), is applied to \a A and the
+ *     product is orthonormalized by HouseholderQR, yielding a basis \a Q of the dominant range of \a A;
+ *  -# this basis is refined by powerIterations() steps of orthonormalized subspace iterations with \a A and \f$ A^* \f$;
+ *  -# the small p-by-l matrix \f$ A^* Q \f$ is decomposed with BDCSVD, and its factors are mapped back to \a A.
+ *
+ * Only products of \a A and \f$ A^* \f$ with l columns are involved, so the workspace is O((n+p)l) and the cost
+ * is dominated by matrix-matrix products (which are multi-threaded, see \ref TopicMultiThreading). Besides dense
+ * matrices, Map and Ref objects, the input of compute() can therefore be a sparse matrix, or any abstract operator
+ * \c op providing \c op.rows(), \c op.cols(), as well as the products <tt>op * X</tt> and <tt>op.adjoint() * X</tt>
+ * with a dense matrix \c X of type \a _MatrixType, both returning an object assignable to \a _MatrixType.
+ *
+ * The accuracy depends on the decay of the singular values: the relative error on the leading singular values
+ * shrinks like \f$ (\sigma_{l+1}/\sigma_i)^{2q+1} \f$ where \a q is the number of power iterations. The default of
+ * 10 oversampling vectors and 2 power iterations gives accurate results for spectra with a moderate gap.
+ *
+ * Only thin unitaries can be computed: matrixU() is n-by-k and matrixV() is p-by-k. The solve() method computes the
+ * minimal norm solution of the least-squares problem restricted to the rank-k approximation of \a A.
+ *
+ * \code
+ * MatrixXd A = ...;
+ * RandomizedSVD<MatrixXd> svd(A, 50, ComputeThinU | ComputeThinV);
+ * VectorXd sigma = svd.singularValues();
+ * \endcode
+ *
+ * The random matrix \f$ \Omega \f$ is drawn with DenseBase::Random(), hence the result depends on the state of the
+ * generator of \c std::rand().
+ *
+ * \sa class BDCSVD, class JacobiSVD
+ */
+template<typename _MatrixType>
+class RandomizedSVD : public SVDBase<RandomizedSVD<_MatrixType> >
+{
+  typedef SVDBase<RandomizedSVD> Base;
+
+public:
+  using Base::rows;
+  using Base::cols;
+  using Base::computeU;
+  using Base::computeV;
+
+  typedef _MatrixType MatrixType;
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<typename MatrixType::Scalar>::Real RealScalar;
+
+  /** \brief Default Constructor.
+   *
+   * The default constructor is useful in cases in which the user intends to
+   * perform decompositions via RandomizedSVD::compute().
+   */
+  RandomizedSVD() : m_targetRank(0), m_oversampling(10), m_powerIterations(2)
+  {
+    check_template_parameters();
+  }
+
+  /** \brief Constructor performing the decomposition of the given matrix or operator.
+   *
+   * \param op the matrix or abstract operator to decompose
+   * \param k the number of singular triplets to compute
+   * \param computationOptions optional parameter allowing to specify if you want thin U or V unitaries to be computed.
+   *                           By default, none is computed. This is a bit - field, the possible bits are #ComputeThinU
+   *                           and #ComputeThinV.
+   */
+  template<typename OperatorType>
+  RandomizedSVD(const OperatorType& op, Index k, unsigned int computationOptions = 0)
+    : m_targetRank(0), m_oversampling(10), m_powerIterations(2)
+  {
+    check_template_parameters();
+    compute(op, k, computationOptions);
+  }
+
+  /** \brief Method computing the \a k leading singular triplets of the given matrix or operator.
+   *
+   * \param op the matrix or abstract operator to decompose
+   * \param k the number of singular triplets to compute, it is reduced to the smallest dimension of \a op if needed
+   * \param computationOptions optional parameter allowing to specify if you want thin U or V unitaries to be computed.
+   *                           By default, none is computed. This is a bit - field, the possible bits are #ComputeThinU
+   *                           and #ComputeThinV.
+   */
+  template<typename OperatorType>
+  RandomizedSVD& compute(const OperatorType& op, Index k, unsigned int computationOptions);
+
+  /** \brief Method computing the \a k leading singular triplets of the given matrix or operator using the current options.
+   *
+   * This method uses the current \a computationOptions, as already passed to the constructor or to compute(const OperatorType&, Index, unsigned int).
+   */
+  template<typename OperatorType>
+  RandomizedSVD& compute(const OperatorType& op, Index k)
+  {
+    return compute(op, k, this->m_computationOptions);
+  }
+
+  /** \returns the number of singular triplets computed by the last call to compute() */
+  Index targetRank() const
+  {
+    this->_check_compute_assertions();
+    return m_targetRank;
+  }
+
+  /** Sets the number of random vectors added to the \a k requested ones (default is 10). */
+  RandomizedSVD& setOversampling(Index p)
+  {
+    eigen_assert(p>=0 && "RandomizedSVD: the oversampling must be non-negative");
+    m_oversampling = p;
+    return *this;
+  }
+
+  /** \returns the number of random vectors added to the requested ones */
+  Index oversampling() const { return m_oversampling; }
+
+  /** Sets the number of power iterations refining the range of \a A (default is 2). */
+  RandomizedSVD& setPowerIterations(Index q)
+  {
+    eigen_assert(q>=0 && "RandomizedSVD: the number of power iterations must be non-negative");
+    m_powerIterations = q;
+    return *this;
+  }
+
+  /** \returns the number of power iterations refining the range of \a A */
+  Index powerIterations() const { return m_powerIterations; }
+
+protected:
+
+  static void check_template_parameters()
+  {
+    EIGEN_STATIC_ASSERT(MatrixType::RowsAtCompileTime==Dynamic && MatrixType::ColsAtCompileTime==Dynamic,
+                        THIS_METHOD_IS_ONLY_FOR_MATRICES_OF_A_SPECIFIC_SIZE);
+  }
+
+  void orthonormalize(MatrixType& Y);
+
+  Index m_targetRank, m_oversampling, m_powerIterations;
+  HouseholderQR<MatrixType> m_qr;
+  BDCSVD<MatrixType> m_svd;
+  MatrixType m_basis, m_work;
+
+  using Base::m_matrixU;
+  using Base::m_matrixV;
+  using Base::m_singularValues;
+  using Base::m_info;
+  using Base::m_isInitialized;
+  using Base::m_isAllocated;
+  using Base::m_computeFullU;
+  using Base::m_computeThinU;
+  using Base::m_computeFullV;
+  using Base::m_computeThinV;
+  using Base::m_computationOptions;
+  using Base::m_nonzeroSingularValues;
+  using Base::m_rows;
+  using Base::m_cols;
+  using Base::m_diagSize;
+};
+
+/** \internal Replaces the columns of \a Y by an orthonormal basis of their span */
+template<typename MatrixType>
+void RandomizedSVD<MatrixType>::orthonormalize(MatrixType& Y)
+{
+  m_qr.compute(Y);
+  Y.setIdentity();
+  Y.applyOnTheLeft(m_qr.householderQ());
+}
+
+template<typename MatrixType>
+template<typename OperatorType>
+RandomizedSVD<MatrixType>&
+RandomizedSVD<MatrixType>::compute(const OperatorType& op, Index k, unsigned int computationOptions)
+{
+  eigen_assert(k >= 0 && "RandomizedSVD: the number of singular values must be non-negative");
+  eigen_assert(!(computationOptions & (ComputeFullU|ComputeFullV)) && "RandomizedSVD: only thin U and V can be computed");
+
+  m_rows = op.rows();
+  m_cols = op.cols();
+  m_diagSize = (std::min)(m_rows, m_cols);
+  m_targetRank = (std::min)(k, m_diagSize);
+  m_info = Success;
+  m_isAllocated = true;
+  m_computationOptions = computationOptions;
+  m_computeFullU = m_computeFullV = false;
+  m_computeThinU = (computationOptions & ComputeThinU) != 0;
+  m_computeThinV = (computationOptions & ComputeThinV) != 0;
+
+  // the sketch never needs more columns than the smallest dimension
+  const Index l = (std::min)(m_targetRank + m_oversampling, m_diagSize);
+
+  // Range finder: Q = orth(A * Omega), refined by subspace iterations Q = orth(A * orth(A^* Q)).
+  m_work = MatrixType::Random(m_cols, l);
+  m_basis.noalias() = op * m_work;
+  orthonormalize(m_basis);
+  for(Index it = 0; it < m_powerIterations; ++it)
+  {
+    m_work.noalias() = op.adjoint() * m_basis;
+    orthonormalize(m_work);
+    m_basis.noalias() = op * m_work;
+    orthonormalize(m_basis);
+  }
+
+  // A ~ Q Q^* A, and with A^* Q = W S Z^* this gives A ~ (Q Z) S W^*.
+  m_work.noalias() = op.adjoint() * m_basis;
+  m_svd.compute(m_work, (m_computeThinU ? ComputeThinV : 0) | (m_computeThinV ? ComputeThinU : 0));
+  m_info = m_svd.info();
+  if(m_info != Success)
+  {
+    m_isInitialized = true;
+    return *this;
+  }
+
+  m_singularValues = m_svd.singularValues().head(m_targetRank);
+  if(m_computeThinU)
+    m_matrixU.noalias() = m_basis * m_svd.matrixV().leftCols(m_targetRank);
+  else
+    m_matrixU.resize(m_rows, 0);
+  if(m_computeThinV)
+    m_matrixV = m_svd.matrixU().leftCols(m_targetRank);
+  else
+    m_matrixV.resize(m_cols, 0);
+
+  m_nonzeroSingularValues = m_targetRank;
+  while(m_nonzeroSingularValues > 0 && m_singularValues.coeff(m_nonzeroSingularValues-1) == RealScalar(0))
+    --m_nonzeroSingularValues;
+
+  m_isInitialized = true;
+  return *this;
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_RANDOMIZEDSVD_H
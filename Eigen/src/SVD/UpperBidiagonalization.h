@@ -131,6 +131,47 @@ void upperbidiagonalization_inplace_unblocked(MatrixType& mat,
   }
 }
 
+/** \internal Computes \a dst = \a mat * \a rhs, or \a dst = \a mat^* * \a rhs if \a Adjoint is true, by splitting
+  * \a dst into \a tasks contiguous parts computed independently. */
+template<bool Adjoint, typename MatType, typename RhsType, typename DstType>
+struct bidiagonalization_gemv_task
+{
+  bidiagonalization_gemv_task(const MatType& mat, const RhsType& rhs, DstType& dst, Index tasks)
+    : m_mat(mat), m_rhs(rhs), m_dst(dst), m_tasks(tasks)
+  {}
+
+  void operator()(Index i) const
+  {
+    const Index start = (i*m_dst.size())/m_tasks;
+    const Index length = ((i+1)*m_dst.size())/m_tasks - start;
+    if(Adjoint) m_dst.segment(start, length).noalias() = m_mat.middleCols(start, length).adjoint() * m_rhs;
+    else        m_dst.segment(start, length).noalias() = m_mat.middleRows(start, length) * m_rhs;
+  }
+
+  const MatType& m_mat;
+  const RhsType& m_rhs;
+  DstType& m_dst;
+  Index m_tasks;
+};
+
+/** \internal Matrix-vector products of the panel reduction, which are the bottleneck of the bidiagonalization.
+  * They are memory bound, and split over the available threads when the matrix is large enough. */
+template<bool Adjoint, typename MatType, typename RhsType, typename DstType>
+void bidiagonalization_gemv(const MatType& mat, const RhsType& rhs, DstType& dst)
+{
+  // minimal number of coefficients of mat per thread
+  const Index minTaskSize = 32768;
+  Index tasks = (std::min)(Index(nbThreads()), mat.size()/minTaskSize);
+  tasks = (std::min)(tasks, dst.size()/16);
+  if(tasks<=1)
+  {
+    if(Adjoint) dst.noalias() = mat.adjoint() * rhs;
+    else        dst.noalias() = mat * rhs;
+    return;
+  }
+  parallelize_tasks(tasks, bidiagonalization_gemv_task<Adjoint,MatType,RhsType,DstType>(mat, rhs, dst, tasks));
+}
+
 /** \internal
   * Helper routine for the block reduction to upper bidiagonal form.
   *
@@ -204,7 +245,7 @@ void upperbidiagonalization_blocked_helper(MatrixType& A,
         
         // let's use the beginning of column k of Y as a temporary vector
         SubColumnType tmp( Y.col(k).head(k) );
-        y_k.noalias()  = A.block(k,k+1, remainingRows,remainingCols).adjoint() * v_k; // bottleneck
+        bidiagonalization_gemv<true>(SubMatType(A.block(k,k+1, remainingRows,remainingCols)), v_k, y_k); // bottleneck
         tmp.noalias()  = V_k1.adjoint()  * v_k;
         y_k.noalias() -= Y_k.leftCols(k) * tmp;
         tmp.noalias()  = X_k1.adjoint()  * v_k;
@@ -236,7 +277,7 @@ void upperbidiagonalization_blocked_helper(MatrixType& A,
         SubColumnType tmp0 ( X.col(k).head(k) ),
                       tmp1 ( X.col(k).head(k+1) );
                     
-        x_k.noalias()   = A.block(k+1,k+1, remainingRows-1,remainingCols) * u_k.transpose(); // bottleneck
+        bidiagonalization_gemv<false>(SubMatType(A.block(k+1,k+1, remainingRows-1,remainingCols)), u_k.transpose(), x_k); // bottleneck
         tmp0.noalias()  = U_k1 * u_k.transpose();
         x_k.noalias()  -= X_k1.bottomRows(remainingRows-1) * tmp0;
         tmp1.noalias()  = Y_k.adjoint() * u_k.transpose();
@@ -0,0 +1,613 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SUPERNODAL_LLT_H
+#define EIGEN_SUPERNODAL_LLT_H
+
+namespace Eigen {
+
+template<typename _MatrixType, int _UpLo = Lower, typename _Ordering = AMDOrdering<typename _MatrixType::StorageIndex> > class SupernodalLLT;
+
+/** \ingroup SparseCholesky_Module
+  * \class SupernodalLLT
+  * \brief A supernodal multifrontal LL^T Cholesky factorization of sparse selfadjoint positive definite matrices
+  *
+  * This class performs the same factorization as SimplicialLLT, i.e., \f$ P A P^{-1} = L L^* \f$ where L is
+  * lower triangular, but it groups the columns of L sharing the same structure into supernodes.
+  * Each supernode is computed from a dense frontal matrix, on which the dense blocked LLT kernel, triangular
+  * solves and rank updates are applied, such that most of the flops are spent in matrix-matrix products.
+  * This makes it much faster than SimplicialLLT on large problems with significant fill-in, as those
+  * arising from the discretization of 2D and 3D PDEs.
+  *
+  * The supernodes belonging to independent subtrees of the elimination tree are factorized concurrently
+  * on the threads made available to %Eigen, through either OpenMP or the thread pool registered with
+  * setGemmThreadPool(). The supernodes near the root are processed afterwards using multi-threaded
+  * matrix products.
+  *
+  * \tparam _MatrixType the type of the sparse matrix A, it must be a SparseMatrix<>
+  * \tparam _UpLo the triangular part that will be used for the computations. It can be Lower
+  *               or Upper. Default is Lower.
+  * \tparam _Ordering The ordering method to use, either AMDOrdering<> or NaturalOrdering<>. Default is AMDOrdering<>
+  *
+  * \implsparsesolverconcept
+  *
+  * \sa class SimplicialLLT, class AMDOrdering, class NaturalOrdering
+  */
+template<typename _MatrixType, int _UpLo, typename _Ordering>
+class SupernodalLLT : public SparseSolverBase<SupernodalLLT<_MatrixType,_UpLo,_Ordering> >
+{
+    typedef SparseSolverBase<SupernodalLLT> Base;
+    using Base::m_isInitialized;
+
+  public:
+    typedef _MatrixType MatrixType;
+    typedef _Ordering OrderingType;
+    enum { UpLo = _UpLo };
+    typedef typename MatrixType::Scalar Scalar;
+    typedef typename MatrixType::RealScalar RealScalar;
+    typedef typename MatrixType::StorageIndex StorageIndex;
+    typedef SparseMatrix<Scalar,ColMajor,StorageIndex> CholMatrixType;
+    typedef Matrix<Scalar,Dynamic,1> VectorType;
+    typedef Matrix<StorageIndex,Dynamic,1> VectorI;
+
+    enum {
+      ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+      MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime
+    };
+
+  protected:
+    typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+    typedef Map<DenseMatrix> FrontMap;
+    typedef Map<const DenseMatrix> ConstFrontMap;
+
+  public:
+
+    /** Default constructor */
+    SupernodalLLT()
+      : m_info(Success), m_factorizationIsOk(false), m_analysisIsOk(false), m_size(0)
+    {}
+
+    /** Constructs and performs the LLT factorization of \a matrix */
+    explicit SupernodalLLT(const MatrixType& matrix)
+      : m_info(Success), m_factorizationIsOk(false), m_analysisIsOk(false), m_size(0)
+    {
+      compute(matrix);
+    }
+
+    inline Index cols() const { return m_size; }
+    inline Index rows() const { return m_size; }
+
+    /** \brief Reports whether previous computation was successful.
+      *
+      * \returns \c Success if computation was successful,
+      *          \c NumericalIssue if the matrix appears not to be positive definite.
+      */
+    ComputationInfo info() const
+    {
+      eigen_assert(m_isInitialized && "Decomposition is not initialized.");
+      return m_info;
+    }
+
+    /** Computes the sparse Cholesky decomposition of \a matrix */
+    SupernodalLLT& compute(const MatrixType& matrix)
+    {
+      eigen_assert(matrix.rows()==matrix.cols());
+      CholMatrixType ap;
+      ordering(matrix, ap);
+      analyzePattern_preordered(ap);
+      factorize_preordered(ap);
+      return *this;
+    }
+
+    /** Performs a symbolic decomposition on the sparcity of \a matrix.
+      *
+      * This function is particularly useful when solving for several problems having the same structure.
+      *
+      * \sa factorize()
+      */
+    void analyzePattern(const MatrixType& matrix)
+    {
+      eigen_assert(matrix.rows()==matrix.cols());
+      CholMatrixType ap;
+      ordering(matrix, ap);
+      analyzePattern_preordered(ap);
+    }
+
+    /** Performs a numeric decomposition of \a matrix
+      *
+      * The given matrix must has the same sparcity than the matrix on which the symbolic decomposition has been performed.
+      *
+      * \sa analyzePattern()
+      */
+    void factorize(const MatrixType& matrix)
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      eigen_assert(matrix.rows()==matrix.cols() && matrix.rows()==m_size);
+      CholMatrixType ap(m_size,m_size);
+      if(m_P.size()>0)
+        ap.template selfadjointView<Lower>() = matrix.template selfadjointView<UpLo>().twistedBy(m_P);
+      else
+        ap.template selfadjointView<Lower>() = matrix.template selfadjointView<UpLo>();
+      factorize_preordered(ap);
+    }
+
+    /** \returns the permutation P
+      * \sa permutationPinv() */
+    const PermutationMatrix<Dynamic,Dynamic,StorageIndex>& permutationP() const
+    { return m_P; }
+
+    /** \returns the inverse P^-1 of the permutation P
+      * \sa permutationP() */
+    const PermutationMatrix<Dynamic,Dynamic,StorageIndex>& permutationPinv() const
+    { return m_Pinv; }
+
+    /** \returns the number of supernodes of the factor */
+    Index supernodes() const
+    {
+      eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+      return m_superStart.size()-1;
+    }
+
+    /** \returns a copy of the lower triangular factor L as a sparse matrix, such that \f$ P A P^{-1} = L L^* \f$ */
+    CholMatrixType matrixL() const
+    {
+      eigen_assert(m_factorizationIsOk && "SupernodalLLT is not factorized");
+      VectorI colSizes(m_size);
+      for(Index s=0; s<supernodes(); ++s)
+        for(Index j=m_superStart[s]; j<m_superStart[s+1]; ++j)
+          colSizes[j] = StorageIndex(m_rowStart[s+1] - m_rowStart[s] - (j-m_superStart[s]));
+      CholMatrixType L(m_size,m_size);
+      L.reserve(colSizes);
+      for(Index s=0; s<supernodes(); ++s)
+      {
+        const Index first = m_superStart[s], width = m_superStart[s+1]-first, height = m_rowStart[s+1]-m_rowStart[s];
+        const StorageIndex* rowIndices = m_rowIndices.data() + m_rowStart[s];
+        ConstFrontMap Ls(m_values.data() + m_valueStart[s], height, width);
+        for(Index j=0; j<width; ++j)
+          for(Index k=j; k<height; ++k)
+            L.insert(rowIndices[k], first+j) = Ls(k,j);
+      }
+      L.makeCompressed();
+      return L;
+    }
+
+    /** \returns the determinant of the underlying matrix from the current factorization */
+    Scalar determinant() const
+    {
+      eigen_assert(m_factorizationIsOk && "SupernodalLLT is not factorized");
+      Scalar detL(1);
+      for(Index s=0; s<supernodes(); ++s)
+      {
+        const Index width = m_superStart[s+1]-m_superStart[s], height = m_rowStart[s+1]-m_rowStart[s];
+        detL *= ConstFrontMap(m_values.data() + m_valueStart[s], height, width).diagonal().prod();
+      }
+      return numext::abs2(detL);
+    }
+
+#ifndef EIGEN_PARSED_BY_DOXYGEN
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve_impl(const MatrixBase<Rhs> &b, MatrixBase<Dest> &dest) const
+    {
+      eigen_assert(m_factorizationIsOk && "The decomposition is not in a valid state for solving, you must first call either compute() or symbolic()/numeric()");
+      eigen_assert(m_size==b.rows());
+
+      if(m_info!=Success)
+        return;
+
+      if(m_P.size()>0)
+        dest = m_P * b;
+      else
+        dest = b;
+
+      typedef Matrix<Scalar,Dynamic,Dest::ColsAtCompileTime> DenseRhs;
+      DenseRhs tmp;
+
+      // forward substitution: L y = P b
+      for(Index s=0; s<supernodes(); ++s)
+      {
+        const Index first = m_superStart[s], width = m_superStart[s+1]-first, height = m_rowStart[s+1]-m_rowStart[s];
+        const StorageIndex* rowIndices = m_rowIndices.data() + m_rowStart[s];
+        ConstFrontMap Ls(m_values.data() + m_valueStart[s], height, width);
+        Ls.topRows(width).template triangularView<Lower>().solveInPlace(dest.middleRows(first,width));
+        if(height>width)
+        {
+          tmp.noalias() = Ls.bottomRows(height-width) * dest.middleRows(first,width);
+          for(Index k=0; k<height-width; ++k)
+            dest.row(rowIndices[width+k]) -= tmp.row(k);
+        }
+      }
+
+      // backward substitution: L^* x = y
+      for(Index s=supernodes()-1; s>=0; --s)
+      {
+        const Index first = m_superStart[s], width = m_superStart[s+1]-first, height = m_rowStart[s+1]-m_rowStart[s];
+        const StorageIndex* rowIndices = m_rowIndices.data() + m_rowStart[s];
+        ConstFrontMap Ls(m_values.data() + m_valueStart[s], height, width);
+        if(height>width)
+        {
+          tmp.resize(height-width, dest.cols());
+          for(Index k=0; k<height-width; ++k)
+            tmp.row(k) = dest.row(rowIndices[width+k]);
+          dest.middleRows(first,width).noalias() -= Ls.bottomRows(height-width).adjoint() * tmp;
+        }
+        Ls.topRows(width).template triangularView<Lower>().adjoint().solveInPlace(dest.middleRows(first,width));
+      }
+
+      if(m_P.size()>0)
+        dest = m_Pinv * dest;
+    }
+
+    /** \internal */
+    template<typename Rhs,typename Dest>
+    void _solve_impl(const SparseMatrixBase<Rhs> &b, SparseMatrixBase<Dest> &dest) const
+    {
+      internal::solve_sparse_through_dense_panels(*this, b, dest);
+    }
+#endif // EIGEN_PARSED_BY_DOXYGEN
+
+  protected:
+
+    void ordering(const MatrixType& a, CholMatrixType& ap);
+    void analyzePattern_preordered(const CholMatrixType& ap);
+    void computeSchedule(Index threads);
+    void factorize_preordered(const CholMatrixType& ap);
+    bool factorizeSupernode(Index s, const CholMatrixType& ap, std::vector<DenseMatrix>& updates);
+
+    struct CompareWork {
+      const Matrix<double,Dynamic,1>& work;
+      CompareWork(const Matrix<double,Dynamic,1>& w) : work(w) {}
+      bool operator()(StorageIndex a, StorageIndex b) const { return work[a] < work[b]; }
+    };
+
+    struct SubtreeTask {
+      SupernodalLLT& self;
+      const CholMatrixType& ap;
+      std::vector<DenseMatrix>& updates;
+      Matrix<bool,Dynamic,1>& ok;
+      SubtreeTask(SupernodalLLT& s, const CholMatrixType& a, std::vector<DenseMatrix>& u, Matrix<bool,Dynamic,1>& o)
+        : self(s), ap(a), updates(u), ok(o) {}
+      void operator()(Index t) const
+      {
+        for(StorageIndex k = self.m_taskStart[t]; k < self.m_taskStart[t+1] && ok[t]; ++k)
+          ok[t] = self.factorizeSupernode(self.m_taskNodes[k], ap, updates);
+      }
+    };
+
+    mutable ComputationInfo m_info;
+    bool m_factorizationIsOk;
+    bool m_analysisIsOk;
+    Index m_size;
+
+    PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_P;     // the permutation
+    PermutationMatrix<Dynamic,Dynamic,StorageIndex> m_Pinv;  // the inverse permutation
+
+    VectorI m_superStart;                      // first column of each supernode
+    VectorI m_superParent;                     // supernodal elimination tree
+    VectorI m_childStart, m_children;          // children of each supernode
+    Matrix<Index,Dynamic,1> m_rowStart;        // position of the row indices of each supernode in m_rowIndices
+    VectorI m_rowIndices;                      // sorted row indices of each supernode, starting with its own columns
+    Matrix<Index,Dynamic,1> m_valueStart;      // position of the dense column-major block of each supernode in m_values
+    VectorType m_values;
+
+    Index m_scheduleThreads;                   // number of threads the schedule has been computed for
+    VectorI m_taskStart, m_taskNodes;          // supernodes of the independent subtrees, in topological order
+    VectorI m_topNodes;                        // remaining supernodes, in topological order
+};
+
+template<typename MatrixType, int UpLo, typename Ordering>
+void SupernodalLLT<MatrixType,UpLo,Ordering>::ordering(const MatrixType& a, CholMatrixType& ap)
+{
+  const Index size = a.rows();
+  ap.resize(size,size);
+  // Note that ordering methods compute the inverse permutation
+  if(!internal::is_same<OrderingType,NaturalOrdering<Index> >::value)
+  {
+    {
+      CholMatrixType C;
+      C = a.template selfadjointView<UpLo>();
+
+      OrderingType ordering;
+      ordering(C,m_Pinv);
+    }
+
+    if(m_Pinv.size()>0) m_P = m_Pinv.inverse();
+    else                m_P.resize(0);
+  }
+  else
+  {
+    m_Pinv.resize(0);
+    m_P.resize(0);
+  }
+
+  if(m_P.size()>0)
+    ap.template selfadjointView<Lower>() = a.template selfadjointView<UpLo>().twistedBy(m_P);
+  else
+    ap.template selfadjointView<Lower>() = a.template selfadjointView<UpLo>();
+}
+
+template<typename MatrixType, int UpLo, typename Ordering>
+void SupernodalLLT<MatrixType,UpLo,Ordering>::analyzePattern_preordered(const CholMatrixType& ap)
+{
+  const StorageIndex size = StorageIndex(ap.rows());
+  m_size = size;
+
+  // Elimination tree and column counts of L. Row k of the lower triangular part of ap is column k of its transpose.
+  CholMatrixType apt = ap.transpose();
+  VectorI parent(size), colCount(size), tags(size);
+  for(StorageIndex k = 0; k < size; ++k)
+  {
+    parent[k] = -1;
+    tags[k] = k;
+    colCount[k] = 0;
+    for(typename CholMatrixType::InnerIterator it(apt,k); it; ++it)
+    {
+      StorageIndex i = it.index();
+      if(i < k)
+      {
+        for(; tags[i] != k; i = parent[i])
+        {
+          if (parent[i] == -1)
+            parent[i] = k;
+          colCount[i]++;
+          tags[i] = k;
+        }
+      }
+    }
+  }
+
+  // Fundamental supernodes: column j extends the supernode of column j-1 if j-1 is its only child
+  // and both columns share the same structure below j.
+  VectorI childCount = VectorI::Zero(size);
+  for(StorageIndex j = 0; j < size; ++j)
+    if(parent[j]>=0) childCount[parent[j]]++;
+
+  VectorI superOf(size);
+  StorageIndex nsuper = 0;
+  for(StorageIndex j = 0; j < size; ++j)
+  {
+    if(j==0 || !(parent[j-1]==j && colCount[j-1]==colCount[j]+1 && childCount[j]==1))
+      ++nsuper;
+    superOf[j] = nsuper-1;
+  }
+
+  m_superStart.resize(nsuper+1);
+  m_superStart[nsuper] = size;
+  for(StorageIndex j = size-1; j >= 0; --j)
+    m_superStart[superOf[j]] = j;
+
+  m_superParent.resize(nsuper);
+  m_childStart.setZero(nsuper+1);
+  m_rowStart.resize(nsuper+1);
+  m_valueStart.resize(nsuper+1);
+  m_rowStart[0] = 0;
+  m_valueStart[0] = 0;
+  for(StorageIndex s = 0; s < nsuper; ++s)
+  {
+    const StorageIndex last = m_superStart[s+1]-1;
+    const Index width = m_superStart[s+1]-m_superStart[s];
+    const Index height = width + colCount[last];
+    m_superParent[s] = parent[last]>=0 ? superOf[parent[last]] : -1;
+    if(m_superParent[s]>=0) m_childStart[m_superParent[s]+1]++;
+    m_rowStart[s+1] = m_rowStart[s] + height;
+    m_valueStart[s+1] = m_valueStart[s] + height*width;
+  }
+  for(StorageIndex s = 0; s < nsuper; ++s)
+    m_childStart[s+1] += m_childStart[s];
+  m_children.resize(m_childStart[nsuper]);
+  {
+    VectorI pos = m_childStart.head(nsuper);
+    for(StorageIndex s = 0; s < nsuper; ++s)
+      if(m_superParent[s]>=0) m_children[pos[m_superParent[s]]++] = s;
+  }
+
+  // Row structure of each supernode: its own columns, followed by the union of the rows of its columns in ap
+  // and of the off-diagonal rows of its children, in increasing order.
+  m_rowIndices.resize(m_rowStart[nsuper]);
+  tags.setConstant(-1);
+  for(StorageIndex s = 0; s < nsuper; ++s)
+  {
+    const StorageIndex first = m_superStart[s], last = m_superStart[s+1]-1;
+    StorageIndex* rowIndices = m_rowIndices.data() + m_rowStart[s];
+    Index height = 0;
+    for(StorageIndex j = first; j <= last; ++j)
+      rowIndices[height++] = j;
+    for(StorageIndex j = first; j <= last; ++j)
+      for(typename CholMatrixType::InnerIterator it(ap,j); it; ++it)
+        if(it.index() > last && tags[it.index()] != s)
+        {
+          tags[it.index()] = s;
+          rowIndices[height++] = it.index();
+        }
+    for(StorageIndex c = m_childStart[s]; c < m_childStart[s+1]; ++c)
+    {
+      const StorageIndex child = m_children[c];
+      for(Index k = m_rowStart[child]; k < m_rowStart[child+1]; ++k)
+      {
+        StorageIndex i = m_rowIndices[k];
+        if(i > last && tags[i] != s)
+        {
+          tags[i] = s;
+          rowIndices[height++] = i;
+        }
+      }
+    }
+    eigen_internal_assert(height == m_rowStart[s+1]-m_rowStart[s]);
+    std::sort(rowIndices + (last-first+1), rowIndices + height);
+  }
+
+  m_values.resize(m_valueStart[nsuper]);
+  m_scheduleThreads = 0;
+
+  m_isInitialized     = true;
+  m_info              = Success;
+  m_analysisIsOk      = true;
+  m_factorizationIsOk = false;
+}
+
+template<typename MatrixType, int UpLo, typename Ordering>
+void SupernodalLLT<MatrixType,UpLo,Ordering>::computeSchedule(Index threads)
+{
+  const Index nsuper = supernodes();
+  m_scheduleThreads = threads;
+
+  // Estimate the number of flops of each subtree of the supernodal elimination tree.
+  Matrix<double,Dynamic,1> work(nsuper);
+  for(Index s = 0; s < nsuper; ++s)
+  {
+    const double width = double(m_superStart[s+1]-m_superStart[s]);
+    const double height = double(m_rowStart[s+1]-m_rowStart[s]);
+    work[s] = width*height*height;
+  }
+  for(Index s = 0; s < nsuper; ++s)
+    if(m_superParent[s]>=0) work[m_superParent[s]] += work[s];
+
+  // Starting from the roots, repeatedly split the most expensive subtree into its children until there are
+  // enough subtrees to balance the load over the threads. The split nodes are processed at the end.
+  std::vector<StorageIndex> subtrees, top;
+  if(threads>1)
+  {
+    CompareWork cmp(work);
+
+    double total = 0;
+    for(Index s = 0; s < nsuper; ++s)
+      if(m_superParent[s]<0)
+      {
+        subtrees.push_back(StorageIndex(s));
+        total += work[s];
+      }
+    std::make_heap(subtrees.begin(), subtrees.end(), cmp);
+    const Index target = 4*threads;
+    while(Index(subtrees.size()) < target)
+    {
+      StorageIndex s = subtrees.front();
+      if(m_childStart[s]==m_childStart[s+1] || work[s] < total/double(target))
+        break;
+      std::pop_heap(subtrees.begin(), subtrees.end(), cmp);
+      subtrees.pop_back();
+      top.push_back(s);
+      for(StorageIndex c = m_childStart[s]; c < m_childStart[s+1]; ++c)
+      {
+        subtrees.push_back(m_children[c]);
+        std::push_heap(subtrees.begin(), subtrees.end(), cmp);
+      }
+    }
+    std::sort_heap(subtrees.begin(), subtrees.end(), cmp);
+    std::reverse(subtrees.begin(), subtrees.end());
+  }
+
+  if(subtrees.size()<2)
+  {
+    // nothing to run in parallel
+    m_taskStart.setZero(1);
+    m_taskNodes.resize(0);
+    m_topNodes = VectorI::LinSpaced(nsuper, 0, StorageIndex(nsuper-1));
+    return;
+  }
+
+  m_taskStart.resize(subtrees.size()+1);
+  m_taskNodes.resize(nsuper - top.size());
+  m_taskStart[0] = 0;
+  std::vector<StorageIndex> stack;
+  for(std::size_t t = 0; t < subtrees.size(); ++t)
+  {
+    StorageIndex* nodes = m_taskNodes.data() + m_taskStart[t];
+    Index count = 0;
+    stack.push_back(subtrees[t]);
+    while(!stack.empty())
+    {
+      StorageIndex s = stack.back();
+      stack.pop_back();
+      nodes[count++] = s;
+      for(StorageIndex c = m_childStart[s]; c < m_childStart[s+1]; ++c)
+        stack.push_back(m_children[c]);
+    }
+    // children always have smaller indices than their parent
+    std::sort(nodes, nodes+count);
+    m_taskStart[t+1] = StorageIndex(m_taskStart[t] + count);
+  }
+  std::sort(top.begin(), top.end());
+  m_topNodes = Map<const VectorI>(top.data(), top.size());
+}
+
+template<typename MatrixType, int UpLo, typename Ordering>
+bool SupernodalLLT<MatrixType,UpLo,Ordering>::factorizeSupernode(Index s, const CholMatrixType& ap, std::vector<DenseMatrix>& updates)
+{
+  const Index first = m_superStart[s], width = m_superStart[s+1]-first, height = m_rowStart[s+1]-m_rowStart[s];
+  const StorageIndex* rowIndices = m_rowIndices.data() + m_rowStart[s];
+
+  // Assemble the frontal matrix from the columns of ap and the update matrices of the children.
+  // Only its lower triangular part is referenced.
+  DenseMatrix front = DenseMatrix::Zero(height, height);
+  for(Index j = 0; j < width; ++j)
+    for(typename CholMatrixType::InnerIterator it(ap,first+j); it; ++it)
+      front(std::lower_bound(rowIndices, rowIndices+height, it.index()) - rowIndices, j) += it.value();
+
+  ei_declare_aligned_stack_constructed_variable(Index, relative, height, 0);
+  for(StorageIndex c = m_childStart[s]; c < m_childStart[s+1]; ++c)
+  {
+    const StorageIndex child = m_children[c];
+    const Index childWidth = m_superStart[child+1]-m_superStart[child];
+    const StorageIndex* childRows = m_rowIndices.data() + m_rowStart[child] + childWidth;
+    const Index childSize = m_rowStart[child+1]-m_rowStart[child]-childWidth;
+    // both row sets are sorted, and the one of the child is included in the one of its parent
+    for(Index k = 0, p = 0; k < childSize; ++k)
+    {
+      while(rowIndices[p] != childRows[k]) ++p;
+      relative[k] = p;
+    }
+    const DenseMatrix& update = updates[child];
+    for(Index j = 0; j < childSize; ++j)
+      for(Index i = j; i < childSize; ++i)
+        front(relative[i], relative[j]) += update(i,j);
+    updates[child].resize(0,0);
+  }
+
+  // Partial factorization of the front: L11 L11^* = F11, L21 = F21 L11^-*, and F22 - L21 L21^* is passed to the parent.
+  Block<DenseMatrix> F11(front, 0, 0, width, width);
+  if(internal::llt_inplace<Scalar,Lower>::blocked(F11)>=0)
+    return false;
+  const Index rs = height-width;
+  if(rs>0)
+  {
+    Block<DenseMatrix> F21(front, width, 0, rs, width);
+    F11.adjoint().template triangularView<Upper>().template solveInPlace<OnTheRight>(F21);
+    updates[s] = front.bottomRightCorner(rs, rs);
+    updates[s].template selfadjointView<Lower>().rankUpdate(F21, RealScalar(-1));
+  }
+  FrontMap(m_values.data() + m_valueStart[s], height, width) = front.leftCols(width);
+  return true;
+}
+
+template<typename MatrixType, int UpLo, typename Ordering>
+void SupernodalLLT<MatrixType,UpLo,Ordering>::factorize_preordered(const CholMatrixType& ap)
+{
+  eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+  eigen_assert(ap.rows()==m_size);
+
+  Index threads = nbThreads();
+  if(threads != m_scheduleThreads)
+    computeSchedule(threads);
+
+  // Update matrices of the supernodes waiting to be assembled into their parent.
+  std::vector<DenseMatrix> updates(supernodes());
+
+  const Index tasks = m_taskStart.size()-1;
+  Matrix<bool,Dynamic,1> ok = Matrix<bool,Dynamic,1>::Constant(tasks, true);
+  internal::parallelize_tasks(tasks, SubtreeTask(*this, ap, updates, ok));
+
+  bool success = ok.all();
+  for(Index k = 0; k < m_topNodes.size() && success; ++k)
+    success = factorizeSupernode(m_topNodes[k], ap, updates);
+
+  m_info = success ? Success : NumericalIssue;
+  m_factorizationIsOk = true;
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_SUPERNODAL_LLT_H
@@ -17,6 +17,117 @@ namespace internal {
 template <> struct product_promote_storage_type<Sparse,Dense, OuterProduct> { typedef Sparse ret; };
 template <> struct product_promote_storage_type<Dense,Sparse, OuterProduct> { typedef Sparse ret; };
 
+/** \internal
+  * \returns the number of threads to use for a sparse * dense product performing \a work multiply-adds,
+  * that is 1 if multi-threading is disabled or if the product is too small to be worth it.
+  */
+inline Index sparse_dense_product_threads(Index work)
+{
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_GEMM_THREADPOOL)
+  Eigen::initParallel();
+  Index threads = Eigen::nbThreads();
+  // This 20000 threshold has been found experimentally on 2D and 3D Poisson problems.
+  // It basically represents the minimal amount of work to be done to be worth it.
+  if(threads>1 && work > 20000)
+    return threads;
+#else
+  EIGEN_UNUSED_VARIABLE(work);
+#endif
+  return 1;
+}
+
+/** \internal
+  * Splits the outer vectors of a sparse expression into \a tasks ranges and \returns the first outer vector of the
+  * range \a t. When the expression exposes its outer index array, the ranges have about the same number of non zeros,
+  * otherwise they have the same number of outer vectors.
+  */
+template<typename SparseType, bool HasOuterIndex = (int(remove_all<SparseType>::type::Flags)&CompressedAccessBit)!=0>
+struct sparse_outer_partition
+{
+  static Index begin(const SparseType& mat, Index t, Index tasks)
+  {
+    return (mat.outerSize()*t)/tasks;
+  }
+};
+
+template<typename SparseType>
+struct sparse_outer_partition<SparseType,true>
+{
+  static Index begin(const SparseType& mat, Index t, Index tasks)
+  {
+    typedef typename remove_all<SparseType>::type::StorageIndex StorageIndex;
+    const Index n = mat.outerSize();
+    const StorageIndex* outer = mat.outerIndexPtr();
+    if(t==tasks)
+      return n;
+    if(outer==0)
+      return (n*t)/tasks;
+    Index target = Index(outer[0]) + ((Index(outer[n])-Index(outer[0]))*t)/tasks;
+    return std::lower_bound(outer, outer+n, target) - outer;
+  }
+};
+
+/** \internal
+  * Runs a sparse * dense product kernel which scatters its contributions into arbitrary rows of the destination,
+  * as the column-major and selfadjoint products do. The outer vectors of \a lhs are split into \a threads ranges
+  * balanced by number of non zeros. The first range is accumulated directly into \a res, the others into private
+  * buffers which are then added to \a res concurrently over ranges of rows.
+  *
+  * \a Kernel must provide a method template <tt>run(Index begin, Index end, Dest& dest)</tt> accumulating the
+  * contributions of the outer vectors \c begin to \c end into \c dest.
+  */
+template<typename SparseLhsType, typename Kernel, typename DenseResType>
+struct sparse_dense_scatter_job
+{
+  typedef Matrix<typename DenseResType::Scalar,Dynamic,Dynamic> Buffer;
+
+  sparse_dense_scatter_job(const SparseLhsType& lhs, const Kernel& kernel, DenseResType& res, std::vector<Buffer>& buffers, bool merge)
+    : m_lhs(lhs), m_kernel(kernel), m_res(res), m_buffers(buffers), m_merge(merge)
+  {}
+
+  void operator()(Index t) const
+  {
+    Index tasks = Index(m_buffers.size())+1;
+    if(m_merge)
+    {
+      Index begin = (m_res.rows()*t)/tasks;
+      Index end = (m_res.rows()*(t+1))/tasks;
+      for(size_t b=0; b<m_buffers.size(); ++b)
+        m_res.middleRows(begin, end-begin) += m_buffers[b].middleRows(begin, end-begin);
+      return;
+    }
+    Index begin = sparse_outer_partition<SparseLhsType>::begin(m_lhs, t, tasks);
+    Index end = sparse_outer_partition<SparseLhsType>::begin(m_lhs, t+1, tasks);
+    if(t==0)
+      m_kernel.run(begin, end, m_res);
+    else
+    {
+      Buffer& buffer = m_buffers[t-1];
+      buffer.setZero(m_res.rows(), m_res.cols());
+      m_kernel.run(begin, end, buffer);
+    }
+  }
+
+  static void run(const SparseLhsType& lhs, const Kernel& kernel, DenseResType& res, Index threads)
+  {
+    // Do not allocate the buffers if parallelize_tasks would run the tasks sequentially anyway.
+    if(threads<=1 || parallelize_tasks_threads(threads)<=1)
+    {
+      kernel.run(0, lhs.outerSize(), res);
+      return;
+    }
+    std::vector<Buffer> buffers(threads-1);
+    parallelize_tasks(threads, sparse_dense_scatter_job(lhs, kernel, res, buffers, false));
+    parallelize_tasks(threads, sparse_dense_scatter_job(lhs, kernel, res, buffers, true));
+  }
+
+  const SparseLhsType& m_lhs;
+  const Kernel& m_kernel;
+  DenseResType& m_res;
+  std::vector<Buffer>& m_buffers;
+  bool m_merge;
+};
+
 template<typename SparseLhsType, typename DenseRhsType, typename DenseResType,
          typename AlphaType,
          int LhsStorageOrder = ((SparseLhsType::Flags&RowMajorBit)==RowMajorBit) ? RowMajor : ColMajor,
@@ -31,34 +142,46 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef typename evaluator<Lhs>::InnerIterator LhsInnerIterator;
   typedef evaluator<Lhs> LhsEval;
+
+  // processes a range of rows balanced by number of non zeros
+  struct RowsTask
+  {
+    RowsTask(const SparseLhsType& lhs, const LhsEval& lhsEval, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index tasks)
+      : m_lhs(lhs), m_lhsEval(lhsEval), m_rhs(rhs), m_res(res), m_alpha(alpha), m_tasks(tasks)
+    {}
+    void operator()(Index t) const
+    {
+      processRows(m_lhsEval, m_rhs, m_res, m_alpha,
+                  sparse_outer_partition<SparseLhsType>::begin(m_lhs, t, m_tasks),
+                  sparse_outer_partition<SparseLhsType>::begin(m_lhs, t+1, m_tasks));
+    }
+    const SparseLhsType& m_lhs;
+    const LhsEval& m_lhsEval;
+    const DenseRhsType& m_rhs;
+    DenseResType& m_res;
+    const typename Res::Scalar& m_alpha;
+    Index m_tasks;
+  };
+
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
   {
     LhsEval lhsEval(lhs);
-    
-    Index n = lhs.outerSize();
-#ifdef EIGEN_HAS_OPENMP
-    Eigen::initParallel();
-    Index threads = Eigen::nbThreads();
-#endif
-    
-    for(Index c=0; c<rhs.cols(); ++c)
+    Index threads = sparse_dense_product_threads(lhsEval.nonZerosEstimate());
+    if(threads>1)
     {
-#ifdef EIGEN_HAS_OPENMP
-      // This 20000 threshold has been found experimentally on 2D and 3D Poisson problems.
-      // It basically represents the minimal amount of work to be done to be worth it.
-      if(threads>1 && lhsEval.nonZerosEstimate() > 20000)
-      {
-        #pragma omp parallel for schedule(dynamic,(n+threads*4-1)/(threads*4)) num_threads(threads)
-        for(Index i=0; i<n; ++i)
-          processRow(lhsEval,rhs,res,alpha,i,c);
-      }
-      else
-#endif
-      {
-        for(Index i=0; i<n; ++i)
-          processRow(lhsEval,rhs,res,alpha,i,c);
-      }
+      // more tasks than threads so that they are dynamically balanced
+      Index tasks = numext::mini<Index>(threads*4, lhs.outerSize());
+      parallelize_tasks(tasks, RowsTask(lhs, lhsEval, rhs, res, alpha, tasks));
     }
+    else
+      processRows(lhsEval, rhs, res, alpha, 0, lhs.outerSize());
+  }
+
+  static void processRows(const LhsEval& lhsEval, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index begin, Index end)
+  {
+    for(Index c=0; c<rhs.cols(); ++c)
+      for(Index i=begin; i<end; ++i)
+        processRow(lhsEval,rhs,res,alpha,i,c);
   }
   
   static void processRow(const LhsEval& lhsEval, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha, Index i, Index col)
@@ -90,19 +213,34 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, A
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef evaluator<Lhs> LhsEval;
   typedef typename LhsEval::InnerIterator LhsInnerIterator;
-  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
+
+  struct Kernel
   {
-    LhsEval lhsEval(lhs);
-    for(Index c=0; c<rhs.cols(); ++c)
+    Kernel(const LhsEval& lhsEval, const DenseRhsType& rhs, const AlphaType& alpha) : m_lhsEval(lhsEval), m_rhs(rhs), m_alpha(alpha) {}
+    template<typename Dest>
+    void run(Index begin, Index end, Dest& res) const
     {
-      for(Index j=0; j<lhs.outerSize(); ++j)
+      for(Index c=0; c<m_rhs.cols(); ++c)
       {
-//        typename Res::Scalar rhs_j = alpha * rhs.coeff(j,c);
-        typename ScalarBinaryOpTraits<AlphaType, typename Rhs::Scalar>::ReturnType rhs_j(alpha * rhs.coeff(j,c));
-        for(LhsInnerIterator it(lhsEval,j); it ;++it)
-          res.coeffRef(it.index(),c) += it.value() * rhs_j;
+        for(Index j=begin; j<end; ++j)
+        {
+//          typename Res::Scalar rhs_j = alpha * rhs.coeff(j,c);
+          typename ScalarBinaryOpTraits<AlphaType, typename Rhs::Scalar>::ReturnType rhs_j(m_alpha * m_rhs.coeff(j,c));
+          for(LhsInnerIterator it(m_lhsEval,j); it ;++it)
+            res.coeffRef(it.index(),c) += it.value() * rhs_j;
+        }
       }
     }
+    const LhsEval& m_lhsEval;
+    const DenseRhsType& m_rhs;
+    const AlphaType& m_alpha;
+  };
+
+  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
+  {
+    LhsEval lhsEval(lhs);
+    Index threads = sparse_dense_product_threads(lhsEval.nonZerosEstimate()*rhs.cols());
+    sparse_dense_scatter_job<SparseLhsType,Kernel,DenseResType>::run(lhs, Kernel(lhsEval, rhs, alpha), res, threads);
   }
 };
 
@@ -114,24 +252,40 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   typedef typename internal::remove_all<DenseResType>::type Res;
   typedef evaluator<Lhs> LhsEval;
   typedef typename LhsEval::InnerIterator LhsInnerIterator;
+
+  // processes a range of rows balanced by number of non zeros
+  struct RowsTask
+  {
+    RowsTask(const SparseLhsType& lhs, const LhsEval& lhsEval, const DenseRhsType& rhs, Res& res, const typename Res::Scalar& alpha, Index tasks)
+      : m_lhs(lhs), m_lhsEval(lhsEval), m_rhs(rhs), m_res(res), m_alpha(alpha), m_tasks(tasks)
+    {}
+    void operator()(Index t) const
+    {
+      Index end = sparse_outer_partition<SparseLhsType>::begin(m_lhs, t+1, m_tasks);
+      for(Index i=sparse_outer_partition<SparseLhsType>::begin(m_lhs, t, m_tasks); i<end; ++i)
+        processRow(m_lhsEval, m_rhs, m_res, m_alpha, i);
+    }
+    const SparseLhsType& m_lhs;
+    const LhsEval& m_lhsEval;
+    const DenseRhsType& m_rhs;
+    Res& m_res;
+    const typename Res::Scalar& m_alpha;
+    Index m_tasks;
+  };
+
   static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
   {
     Index n = lhs.rows();
     LhsEval lhsEval(lhs);
 
-#ifdef EIGEN_HAS_OPENMP
-    Eigen::initParallel();
-    Index threads = Eigen::nbThreads();
-    // This 20000 threshold has been found experimentally on 2D and 3D Poisson problems.
-    // It basically represents the minimal amount of work to be done to be worth it.
-    if(threads>1 && lhsEval.nonZerosEstimate()*rhs.cols() > 20000)
+    Index threads = sparse_dense_product_threads(lhsEval.nonZerosEstimate()*rhs.cols());
+    if(threads>1)
     {
-      #pragma omp parallel for schedule(dynamic,(n+threads*4-1)/(threads*4)) num_threads(threads)
-      for(Index i=0; i<n; ++i)
-        processRow(lhsEval,rhs,res,alpha,i);
+      // more tasks than threads so that they are dynamically balanced
+      Index tasks = numext::mini<Index>(threads*4, n);
+      parallelize_tasks(tasks, RowsTask(lhs, lhsEval, rhs, res, alpha, tasks));
     }
     else
-#endif
     {
       for(Index i=0; i<n; ++i)
         processRow(lhsEval, rhs, res, alpha, i);
@@ -152,16 +306,32 @@ struct sparse_time_dense_product_impl<SparseLhsType,DenseRhsType,DenseResType, t
   typedef typename internal::remove_all<SparseLhsType>::type Lhs;
   typedef typename internal::remove_all<DenseRhsType>::type Rhs;
   typedef typename internal::remove_all<DenseResType>::type Res;
+  typedef evaluator<Lhs> LhsEval;
   typedef typename evaluator<Lhs>::InnerIterator LhsInnerIterator;
-  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
+
+  struct Kernel
   {
-    evaluator<Lhs> lhsEval(lhs);
-    for(Index j=0; j<lhs.outerSize(); ++j)
+    Kernel(const LhsEval& lhsEval, const DenseRhsType& rhs, const typename Res::Scalar& alpha) : m_lhsEval(lhsEval), m_rhs(rhs), m_alpha(alpha) {}
+    template<typename Dest>
+    void run(Index begin, Index end, Dest& res) const
     {
-      typename Rhs::ConstRowXpr rhs_j(rhs.row(j));
-      for(LhsInnerIterator it(lhsEval,j); it ;++it)
-        res.row(it.index()) += (alpha*it.value()) * rhs_j;
+      for(Index j=begin; j<end; ++j)
+      {
+        typename Rhs::ConstRowXpr rhs_j(m_rhs.row(j));
+        for(LhsInnerIterator it(m_lhsEval,j); it ;++it)
+          res.row(it.index()) += (m_alpha*it.value()) * rhs_j;
+      }
     }
+    const LhsEval& m_lhsEval;
+    const DenseRhsType& m_rhs;
+    const typename Res::Scalar& m_alpha;
+  };
+
+  static void run(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const typename Res::Scalar& alpha)
+  {
+    LhsEval lhsEval(lhs);
+    Index threads = sparse_dense_product_threads(lhsEval.nonZerosEstimate()*rhs.cols());
+    sparse_dense_scatter_job<SparseLhsType,Kernel,DenseResType>::run(lhs, Kernel(lhsEval, rhs, alpha), res, threads);
   }
 };
 
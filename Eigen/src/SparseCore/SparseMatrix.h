@@ -448,6 +448,12 @@ class SparseMatrix
     template<typename InputIterators,typename DupFunctor>
     void setFromTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func);
 
+    template<typename InputIterators>
+    void setFromSortedTriplets(const InputIterators& begin, const InputIterators& end);
+
+    template<typename InputIterators,typename DupFunctor>
+    void setFromSortedTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func);
+
     void sumupDuplicates() { collapseDuplicates(internal::scalar_sum_op<Scalar,Scalar>()); }
 
     template<typename DupFunctor>
@@ -1034,7 +1040,7 @@ private:
 namespace internal {
 
 template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
-void set_from_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func)
+void set_from_triplets_sequential(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func)
 {
   enum { IsRowMajor = SparseMatrixType::IsRowMajor };
   typedef typename SparseMatrixType::Scalar Scalar;
@@ -1065,6 +1071,267 @@ void set_from_triplets(const InputIterator& begin, const InputIterator& end, Spa
   mat = trMat;
 }
 
+#if defined(EIGEN_HAS_OPENMP) || defined(EIGEN_HAS_GEMM_THREADPOOL)
+
+/** \internal
+  * Multi-threaded assembly of a compressed sparse matrix from a random access range of triplets.
+  *
+  * The triplets are split into \c num_chunks contiguous chunks, and the matrix is built in five passes:
+  *  1. each chunk counts its entries per outer vector (one histogram per chunk),
+  *  2. the histograms are turned into per-chunk write offsets (prefix sums),
+  *  3. each chunk scatters its entries into a temporary buffer grouped by outer vector,
+  *  4. each outer vector is sorted by inner index and its unique entries are counted,
+  *  5. the unique entries are written to \c mat, duplicates being merged with \c dup_func.
+  * Passes 1, 3 and 4, 5 run concurrently over triplet chunks and outer ranges respectively.
+  * Since the scatter preserves the relative order of the triplets, \c dup_func sees duplicates in input order,
+  * exactly as with the sequential algorithm.
+  */
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+struct parallel_triplet_assembler
+{
+  enum { IsRowMajor = SparseMatrixType::IsRowMajor };
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+
+  struct Entry
+  {
+    StorageIndex inner;
+    Scalar value;
+  };
+
+  struct EntryLess
+  {
+    bool operator()(const Entry& a, const Entry& b) const { return a.inner < b.inner; }
+  };
+
+  parallel_triplet_assembler(const InputIterator& begin, Index size, Index num_chunks, SparseMatrixType& mat, DupFunctor dup_func)
+    : m_begin(begin), m_size(size), m_chunks(num_chunks), m_outerSize(mat.outerSize()),
+      m_counts(num_chunks*mat.outerSize(), 0), m_starts(mat.outerSize()+1, 0), m_buffer(size), m_mat(mat), m_dupFunc(dup_func)
+  {}
+
+  void run()
+  {
+    parallelize_tasks(m_chunks, Pass<&parallel_triplet_assembler::count>(this));
+    parallelize_tasks(m_chunks, Pass<&parallel_triplet_assembler::offsets>(this));
+    for(Index j=0; j<m_outerSize; ++j)
+      m_starts[j+1] += m_starts[j];
+    parallelize_tasks(m_chunks, Pass<&parallel_triplet_assembler::scatter>(this));
+
+    StorageIndex* outerIndex = m_mat.outerIndexPtr();
+    outerIndex[0] = 0;
+    parallelize_tasks(m_chunks, Pass<&parallel_triplet_assembler::sort>(this));
+    for(Index j=0; j<m_outerSize; ++j)
+      outerIndex[j+1] += outerIndex[j];
+    m_mat.resizeNonZeros(outerIndex[m_outerSize]);
+    parallelize_tasks(m_chunks, Pass<&parallel_triplet_assembler::gather>(this));
+  }
+
+ protected:
+  template<void (parallel_triplet_assembler::*Method)(Index)>
+  struct Pass
+  {
+    explicit Pass(parallel_triplet_assembler* self) : m_self(self) {}
+    void operator()(Index t) const { (m_self->*Method)(t); }
+    parallel_triplet_assembler* m_self;
+  };
+
+  Index chunkBegin(Index t) const { return (m_size*t)/m_chunks; }
+  Index outerBegin(Index t) const { return (m_outerSize*t)/m_chunks; }
+  // once the buffer is filled, balance the outer ranges by number of entries rather than by number of outer vectors
+  Index balancedOuterBegin(Index t) const
+  {
+    if(t==m_chunks) return m_outerSize;
+    return std::upper_bound(m_starts.begin(), m_starts.end(), StorageIndex(chunkBegin(t))) - m_starts.begin() - 1;
+  }
+
+  Index outerOf(const InputIterator& it) const { return IsRowMajor ? it->row() : it->col(); }
+  Index innerOf(const InputIterator& it) const { return IsRowMajor ? it->col() : it->row(); }
+
+  void count(Index t)
+  {
+    StorageIndex* counts = &m_counts[t*m_outerSize];
+    InputIterator end = m_begin + chunkBegin(t+1);
+    for(InputIterator it = m_begin + chunkBegin(t); it!=end; ++it)
+    {
+      eigen_assert(it->row()>=0 && it->row()<m_mat.rows() && it->col()>=0 && it->col()<m_mat.cols());
+      ++counts[outerOf(it)];
+    }
+  }
+
+  void offsets(Index t)
+  {
+    for(Index j=outerBegin(t); j<outerBegin(t+1); ++j)
+    {
+      StorageIndex run = 0;
+      for(Index c=0; c<m_chunks; ++c)
+      {
+        StorageIndex n = m_counts[c*m_outerSize+j];
+        m_counts[c*m_outerSize+j] = run;
+        run += n;
+      }
+      m_starts[j+1] = run;
+    }
+  }
+
+  void scatter(Index t)
+  {
+    StorageIndex* offsets = &m_counts[t*m_outerSize];
+    InputIterator end = m_begin + chunkBegin(t+1);
+    for(InputIterator it = m_begin + chunkBegin(t); it!=end; ++it)
+    {
+      Index j = outerOf(it);
+      Entry& entry = m_buffer[m_starts[j] + offsets[j]++];
+      entry.inner = StorageIndex(innerOf(it));
+      entry.value = it->value();
+    }
+  }
+
+  void sort(Index t)
+  {
+    StorageIndex* outerIndex = m_mat.outerIndexPtr();
+    for(Index j=balancedOuterBegin(t); j<balancedOuterBegin(t+1); ++j)
+    {
+      Entry* first = &m_buffer[0] + m_starts[j];
+      Entry* last  = &m_buffer[0] + m_starts[j+1];
+      if(last-first<=16)
+      {
+        // insertion sort, stable and cheaper than std::stable_sort on the short vectors of typical FEM matrices
+        for(Entry* it=first+1; it<last; ++it)
+        {
+          Entry tmp = *it;
+          Entry* k = it;
+          for(; k>first && tmp.inner<(k-1)->inner; --k)
+            *k = *(k-1);
+          *k = tmp;
+        }
+      }
+      else
+        std::stable_sort(first, last, EntryLess());
+
+      StorageIndex unique = 0;
+      for(Entry* it=first; it<last; ++it)
+        if(it==first || it->inner!=(it-1)->inner)
+          ++unique;
+      outerIndex[j+1] = unique;
+    }
+  }
+
+  void gather(Index t)
+  {
+    const StorageIndex* outerIndex = m_mat.outerIndexPtr();
+    StorageIndex* innerIndices = m_mat.innerIndexPtr();
+    Scalar* values = m_mat.valuePtr();
+    for(Index j=balancedOuterBegin(t); j<balancedOuterBegin(t+1); ++j)
+    {
+      Index k = Index(outerIndex[j])-1;
+      for(Index p=m_starts[j]; p<m_starts[j+1]; ++p)
+      {
+        const Entry& entry = m_buffer[p];
+        if(p>m_starts[j] && entry.inner==innerIndices[k])
+          values[k] = m_dupFunc(values[k], entry.value);
+        else
+        {
+          ++k;
+          innerIndices[k] = entry.inner;
+          values[k] = entry.value;
+        }
+      }
+    }
+  }
+
+  InputIterator m_begin;
+  Index m_size;
+  Index m_chunks;
+  Index m_outerSize;
+  std::vector<StorageIndex> m_counts;  // m_chunks histograms of size m_outerSize, then per-chunk write offsets
+  std::vector<StorageIndex> m_starts;  // start of each outer vector in m_buffer
+  std::vector<Entry> m_buffer;
+  SparseMatrixType& m_mat;
+  DupFunctor m_dupFunc;
+};
+
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+void set_from_triplets_dispatch(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func,
+                                std::random_access_iterator_tag)
+{
+  // below this many triplets per thread, the cost of the extra passes is not amortized
+  const Index min_triplets_per_thread = 1<<15;
+  Index size = Index(end-begin);
+  Index threads = (std::min)(Index(nbThreads()), size/min_triplets_per_thread);
+  if(threads<=1)
+  {
+    set_from_triplets_sequential(begin, end, mat, dup_func);
+    return;
+  }
+  mat.resize(mat.rows(), mat.cols());
+  parallel_triplet_assembler<InputIterator,SparseMatrixType,DupFunctor>(begin, size, threads, mat, dup_func).run();
+}
+
+#endif // EIGEN_HAS_OPENMP || EIGEN_HAS_GEMM_THREADPOOL
+
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor, typename IteratorCategory>
+void set_from_triplets_dispatch(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func,
+                                IteratorCategory)
+{
+  set_from_triplets_sequential(begin, end, mat, dup_func);
+}
+
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+void set_from_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func)
+{
+  set_from_triplets_dispatch(begin, end, mat, dup_func, typename std::iterator_traits<InputIterator>::iterator_category());
+}
+
+template<typename InputIterator, typename SparseMatrixType, typename DupFunctor>
+void set_from_sorted_triplets(const InputIterator& begin, const InputIterator& end, SparseMatrixType& mat, DupFunctor dup_func)
+{
+  enum { IsRowMajor = SparseMatrixType::IsRowMajor };
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+
+  mat.resize(mat.rows(), mat.cols());
+  if(begin==end)
+    return;
+
+  // pass 1: count the unique entries per outer-vector, and check the ordering
+  StorageIndex* outerIndex = mat.outerIndexPtr();
+  Index prevOuter = -1, prevInner = -1;
+  for(InputIterator it(begin); it!=end; ++it)
+  {
+    eigen_assert(it->row()>=0 && it->row()<mat.rows() && it->col()>=0 && it->col()<mat.cols());
+    Index outer = IsRowMajor ? it->row() : it->col();
+    Index inner = IsRowMajor ? it->col() : it->row();
+    eigen_assert((outer>prevOuter || (outer==prevOuter && inner>=prevInner)) && "triplets must be sorted by outer then inner index");
+    if(outer!=prevOuter || inner!=prevInner)
+      ++outerIndex[outer+1];
+    prevOuter = outer;
+    prevInner = inner;
+  }
+  for(Index j=0; j<mat.outerSize(); ++j)
+    outerIndex[j+1] += outerIndex[j];
+  mat.resizeNonZeros(outerIndex[mat.outerSize()]);
+
+  // pass 2: copy the entries, merging the duplicates
+  StorageIndex* innerIndices = mat.innerIndexPtr();
+  typename SparseMatrixType::Scalar* values = mat.valuePtr();
+  Index k = -1;
+  prevOuter = prevInner = -1;
+  for(InputIterator it(begin); it!=end; ++it)
+  {
+    Index outer = IsRowMajor ? it->row() : it->col();
+    Index inner = IsRowMajor ? it->col() : it->row();
+    if(outer==prevOuter && inner==prevInner)
+      values[k] = dup_func(values[k], it->value());
+    else
+    {
+      ++k;
+      innerIndices[k] = StorageIndex(inner);
+      values[k] = it->value();
+    }
+    prevOuter = outer;
+    prevInner = inner;
+  }
+}
+
 }
 
 
@@ -1104,6 +1371,12 @@ void set_from_triplets(const InputIterator& begin, const InputIterator& end, Spa
   * \warning The list of triplets is read multiple times (at least twice). Therefore, it is not recommended to define
   * an abstract iterator over a complex data-structure that would be expensive to evaluate. The triplets should rather
   * be explicitly stored into a std::vector for instance.
+  *
+  * When multi-threading is enabled (see \ref TopicMultiThreading) and \a InputIterators is a random access iterator,
+  * large triplet lists are assembled in parallel. The result, including the order in which duplicates are merged,
+  * is the same as with the sequential algorithm.
+  *
+  * \sa setFromSortedTriplets()
   */
 template<typename Scalar, int _Options, typename _StorageIndex>
 template<typename InputIterators>
@@ -1128,6 +1401,34 @@ void SparseMatrix<Scalar,_Options,_StorageIndex>::setFromTriplets(const InputIte
   internal::set_from_triplets<InputIterators, SparseMatrix<Scalar,_Options,_StorageIndex>, DupFunctor>(begin, end, *this, dup_func);
 }
 
+/** The same as setFromTriplets but the triplets must be sorted with respect to the storage order of the matrix,
+  * that is by increasing outer index (column for a column-major matrix), then by increasing inner index.
+  * Duplicated elements, which are thus consecutive, are summed up.
+  *
+  * The matrix is filled directly in two passes over the triplets, without any temporary copy of the list.
+  * The ordering is checked by an assertion.
+  *
+  * \sa setFromTriplets()
+  */
+template<typename Scalar, int _Options, typename _StorageIndex>
+template<typename InputIterators>
+void SparseMatrix<Scalar,_Options,_StorageIndex>::setFromSortedTriplets(const InputIterators& begin, const InputIterators& end)
+{
+  internal::set_from_sorted_triplets<InputIterators, SparseMatrix<Scalar,_Options,_StorageIndex> >(begin, end, *this, internal::scalar_sum_op<Scalar,Scalar>());
+}
+
+/** The same as setFromSortedTriplets but when duplicates are met the functor \a dup_func is applied:
+  * \code
+  * value = dup_func(OldValue, NewValue)
+  * \endcode
+  */
+template<typename Scalar, int _Options, typename _StorageIndex>
+template<typename InputIterators,typename DupFunctor>
+void SparseMatrix<Scalar,_Options,_StorageIndex>::setFromSortedTriplets(const InputIterators& begin, const InputIterators& end, DupFunctor dup_func)
+{
+  internal::set_from_sorted_triplets<InputIterators, SparseMatrix<Scalar,_Options,_StorageIndex>, DupFunctor>(begin, end, *this, dup_func);
+}
+
 /** \internal */
 template<typename Scalar, int _Options, typename _StorageIndex>
 template<typename DupFunctor>
@@ -280,13 +280,9 @@ struct Assignment<DstXprType, SrcXprType, Functor, SparseSelfAdjoint2Sparse>
 namespace internal {
 
 template<int Mode, typename SparseLhsType, typename DenseRhsType, typename DenseResType, typename AlphaType>
-inline void sparse_selfadjoint_time_dense_product(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
+struct sparse_selfadjoint_time_dense_product_kernel
 {
-  EIGEN_ONLY_USED_FOR_DEBUG(alpha);
-  
-  typedef typename internal::nested_eval<SparseLhsType,DenseRhsType::MaxColsAtCompileTime>::type SparseLhsTypeNested;
-  typedef typename internal::remove_all<SparseLhsTypeNested>::type SparseLhsTypeNestedCleaned;
-  typedef evaluator<SparseLhsTypeNestedCleaned> LhsEval;
+  typedef evaluator<SparseLhsType> LhsEval;
   typedef typename LhsEval::InnerIterator LhsIterator;
   typedef typename SparseLhsType::Scalar LhsScalar;
   
@@ -298,45 +294,75 @@ inline void sparse_selfadjoint_time_dense_product(const SparseLhsType& lhs, cons
           || ( (Mode&Lower) && LhsIsRowMajor),
     ProcessSecondHalf = !ProcessFirstHalf
   };
-  
-  SparseLhsTypeNested lhs_nested(lhs);
-  LhsEval lhsEval(lhs_nested);
 
-  // work on one column at once
-  for (Index k=0; k<rhs.cols(); ++k)
+  sparse_selfadjoint_time_dense_product_kernel(const LhsEval& lhsEval, const DenseRhsType& rhs, const AlphaType& alpha)
+    : m_lhsEval(lhsEval), m_rhs(rhs), m_alpha(alpha)
+  {}
+
+  // accumulates the contributions of the outer vectors begin to end into res
+  template<typename Dest>
+  void run(Index begin, Index end, Dest& res) const
   {
-    for (Index j=0; j<lhs.outerSize(); ++j)
+    const DenseRhsType& rhs = m_rhs;
+    const AlphaType& alpha = m_alpha;
+    // work on one column at once
+    for (Index k=0; k<rhs.cols(); ++k)
     {
-      LhsIterator i(lhsEval,j);
-      // handle diagonal coeff
-      if (ProcessSecondHalf)
+      for (Index j=begin; j<end; ++j)
       {
-        while (i && i.index()<j) ++i;
-        if(i && i.index()==j)
+        LhsIterator i(m_lhsEval,j);
+        // handle diagonal coeff
+        if (ProcessSecondHalf)
         {
-          res.coeffRef(j,k) += alpha * i.value() * rhs.coeff(j,k);
-          ++i;
+          while (i && i.index()<j) ++i;
+          if(i && i.index()==j)
+          {
+            res.coeffRef(j,k) += alpha * i.value() * rhs.coeff(j,k);
+            ++i;
+          }
         }
-      }
 
-      // premultiplied rhs for scatters
-      typename ScalarBinaryOpTraits<AlphaType, typename DenseRhsType::Scalar>::ReturnType rhs_j(alpha*rhs(j,k));
-      // accumulator for partial scalar product
-      typename DenseResType::Scalar res_j(0);
-      for(; (ProcessFirstHalf ? i && i.index() < j : i) ; ++i)
-      {
-        LhsScalar lhs_ij = i.value();
-        if(!LhsIsRowMajor) lhs_ij = numext::conj(lhs_ij);
-        res_j += lhs_ij * rhs.coeff(i.index(),k);
-        res(i.index(),k) += numext::conj(lhs_ij) * rhs_j;
-      }
-      res.coeffRef(j,k) += alpha * res_j;
+        // premultiplied rhs for scatters
+        typename ScalarBinaryOpTraits<AlphaType, typename DenseRhsType::Scalar>::ReturnType rhs_j(alpha*rhs(j,k));
+        // accumulator for partial scalar product
+        typename DenseResType::Scalar res_j(0);
+        for(; (ProcessFirstHalf ? i && i.index() < j : i) ; ++i)
+        {
+          LhsScalar lhs_ij = i.value();
+          if(!LhsIsRowMajor) lhs_ij = numext::conj(lhs_ij);
+          res_j += lhs_ij * rhs.coeff(i.index(),k);
+          res(i.index(),k) += numext::conj(lhs_ij) * rhs_j;
+        }
+        res.coeffRef(j,k) += alpha * res_j;
 
-      // handle diagonal coeff
-      if (ProcessFirstHalf && i && (i.index()==j))
-        res.coeffRef(j,k) += alpha * i.value() * rhs.coeff(j,k);
+        // handle diagonal coeff
+        if (ProcessFirstHalf && i && (i.index()==j))
+          res.coeffRef(j,k) += alpha * i.value() * rhs.coeff(j,k);
+      }
     }
   }
+
+  const LhsEval& m_lhsEval;
+  const DenseRhsType& m_rhs;
+  const AlphaType& m_alpha;
+};
+
+template<int Mode, typename SparseLhsType, typename DenseRhsType, typename DenseResType, typename AlphaType>
+inline void sparse_selfadjoint_time_dense_product(const SparseLhsType& lhs, const DenseRhsType& rhs, DenseResType& res, const AlphaType& alpha)
+{
+  EIGEN_ONLY_USED_FOR_DEBUG(alpha);
+  
+  typedef typename internal::nested_eval<SparseLhsType,DenseRhsType::MaxColsAtCompileTime>::type SparseLhsTypeNested;
+  typedef typename internal::remove_all<SparseLhsTypeNested>::type SparseLhsTypeNestedCleaned;
+  typedef sparse_selfadjoint_time_dense_product_kernel<Mode,SparseLhsTypeNestedCleaned,DenseRhsType,DenseResType,AlphaType> Kernel;
+  
+  SparseLhsTypeNested lhs_nested(lhs);
+  typename Kernel::LhsEval lhsEval(lhs_nested);
+
+  // Each outer vector both gathers into and scatters to the result, so that concurrent ranges of outer vectors
+  // are accumulated into separate buffers.
+  Index threads = sparse_dense_product_threads(lhsEval.nonZerosEstimate()*rhs.cols());
+  sparse_dense_scatter_job<SparseLhsTypeNestedCleaned,Kernel,DenseResType>::run(lhs_nested, Kernel(lhsEval, rhs, alpha), res, threads);
 }
 
 
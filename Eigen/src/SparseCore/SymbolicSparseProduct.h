@@ -0,0 +1,322 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SYMBOLICSPARSEPRODUCT_H
+#define EIGEN_SYMBOLICSPARSEPRODUCT_H
+
+namespace Eigen {
+
+namespace internal {
+
+// Operands of SymbolicSparseProduct are used as is if their storage order matches the one of the result,
+// and are converted otherwise.
+template<typename Xpr, int Order, typename StorageIndex,
+         bool Matches = (int(traits<Xpr>::Flags&RowMajorBit) == (int(Order)==int(RowMajor) ? int(RowMajorBit) : 0))>
+struct symbolic_product_operand
+{
+  typedef const Xpr& type;
+};
+
+template<typename Xpr, int Order, typename StorageIndex>
+struct symbolic_product_operand<Xpr,Order,StorageIndex,false>
+{
+  typedef SparseMatrix<typename traits<Xpr>::Scalar,Order,StorageIndex> type;
+};
+
+// Each outer vector j of the result is the sum of the outer vectors k of the "other" operand scaled by the entries
+// (k,j) of the "driver" operand, that is, for a column-major result, the driver is rhs and the other operand is lhs.
+template<bool ResultIsRowMajor> struct symbolic_product_roles
+{
+  template<typename L, typename R> static const R& driver(const L&, const R& rhs) { return rhs; }
+  template<typename L, typename R> static const L& other(const L& lhs, const R&) { return lhs; }
+};
+
+template<> struct symbolic_product_roles<true>
+{
+  template<typename L, typename R> static const L& driver(const L& lhs, const R&) { return lhs; }
+  template<typename L, typename R> static const R& other(const L&, const R& rhs) { return rhs; }
+};
+
+} // end namespace internal
+
+/** \ingroup SparseCore_Module
+  * \class SymbolicSparseProduct
+  *
+  * \brief Sparse matrix - sparse matrix product with a reusable symbolic phase
+  *
+  * \tparam SparseMatrixType the type of the result, a SparseMatrix<>
+  *
+  * This class splits the product of two sparse matrices into a symbolic phase, analyzePattern(), which computes and
+  * stores the sparsity pattern of the result, and a numerical phase, evaluate(), which only computes its values.
+  * When the same product has to be computed many times for matrices whose values change but whose sparsity
+  * patterns do not, as for the Galerkin product \c R*A*P of an algebraic multigrid setup, the symbolic work is
+  * thus done once only:
+  * \code
+  * SymbolicSparseProduct<SparseMatrix<double> > AP(A, P);
+  * AP.evaluate(A, P, tmp);
+  * SymbolicSparseProduct<SparseMatrix<double> > RAP(R, tmp);
+  * for(...)
+  * {
+  *   // update the values of A
+  *   AP.evaluate(A, P, tmp);
+  *   RAP.evaluate(R, tmp, res);
+  * }
+  * \endcode
+  *
+  * The pattern is structural: as for the default product, entries vanishing through numerical cancellation are
+  * stored as explicit zeros, and the result is sorted and compressed.
+  *
+  * Both phases run in parallel over the outer vectors of the result when multi-threading is enabled
+  * (see \ref TopicMultiThreading), the work being balanced with respect to the number of flops.
+  * Operands whose storage order differs from the one of the result are converted at each call.
+  *
+  * \sa SparseMatrixBase::operator*(), SparseMatrixBase::pruned()
+  */
+template<typename SparseMatrixType>
+class SymbolicSparseProduct
+{
+  public:
+    typedef typename SparseMatrixType::Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef typename SparseMatrixType::StorageIndex StorageIndex;
+    enum {
+      IsRowMajor = SparseMatrixType::IsRowMajor,
+      Order = IsRowMajor ? RowMajor : ColMajor
+    };
+    typedef Matrix<StorageIndex,Dynamic,1> IndexVector;
+
+    /** Default constructor, analyzePattern() must be called before evaluate(). */
+    SymbolicSparseProduct() : m_rows(0), m_cols(0), m_isInitialized(false) {}
+
+    /** Computes the sparsity pattern of \a lhs * \a rhs. */
+    template<typename Lhs, typename Rhs>
+    SymbolicSparseProduct(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs)
+      : m_rows(0), m_cols(0), m_isInitialized(false)
+    {
+      analyzePattern(lhs, rhs);
+    }
+
+    /** Computes and stores the sparsity pattern of \a lhs * \a rhs. */
+    template<typename Lhs, typename Rhs>
+    SymbolicSparseProduct& analyzePattern(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs);
+
+    /** Computes the values of \a lhs * \a rhs into \a res, using the pattern computed by analyzePattern().
+      *
+      * \a lhs and \a rhs must have the same sizes and sparsity patterns as the matrices given to analyzePattern(),
+      * and must not alias \a res. \a res is resized and its storage is reused whenever possible.
+      */
+    template<typename Lhs, typename Rhs>
+    void evaluate(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs, SparseMatrixType& res) const;
+
+    /** \returns the number of rows of the result */
+    Index rows() const { return m_rows; }
+    /** \returns the number of columns of the result */
+    Index cols() const { return m_cols; }
+    /** \returns the number of non zeros of the result */
+    Index nonZeros() const { return m_outerIndex.size()==0 ? 0 : Index(m_outerIndex(m_outerIndex.size()-1)); }
+
+  protected:
+    enum Phase { CountPhase, FillPhase, NumericPhase };
+
+    // Runs one phase over the range of outer vectors of the result assigned to a task.
+    template<typename DriverEval, typename OtherEval>
+    struct Job
+    {
+      Job(const SymbolicSparseProduct& self, const DriverEval& driver, const OtherEval& other, Index innerSize, Index numTasks,
+          Phase phase, StorageIndex* outerIndex, StorageIndex* innerIndices, Scalar* values)
+        : m_self(self), m_driver(driver), m_other(other), m_innerSize(innerSize), m_numTasks(numTasks),
+          m_phase(phase), m_outerIndex(outerIndex), m_innerIndices(innerIndices), m_values(values)
+      {}
+
+      void operator()(Index t) const
+      {
+        Index begin = m_self.taskBegin(t, m_numTasks);
+        Index end = m_self.taskBegin(t+1, m_numTasks);
+        if(begin==end)
+          return;
+        if(m_phase==NumericPhase)
+          numeric(begin, end);
+        else
+          symbolic(begin, end);
+      }
+
+      void symbolic(Index begin, Index end) const
+      {
+        // marker[i]==j iff i has already been met in the outer vector j
+        IndexVector marker = IndexVector::Constant(m_innerSize, -1);
+        for(Index j=begin; j<end; ++j)
+        {
+          StorageIndex nnz = 0;
+          StorageIndex* indices = m_phase==FillPhase ? m_innerIndices + m_outerIndex[j] : 0;
+          for(typename DriverEval::InnerIterator dIt(m_driver, j); dIt; ++dIt)
+            for(typename OtherEval::InnerIterator oIt(m_other, dIt.index()); oIt; ++oIt)
+            {
+              Index i = oIt.index();
+              if(marker(i)!=j)
+              {
+                marker(i) = StorageIndex(j);
+                if(indices)
+                  indices[nnz] = StorageIndex(i);
+                ++nnz;
+              }
+            }
+          if(indices)
+            std::sort(indices, indices+nnz);
+          else
+            m_outerIndex[j+1] = nnz;
+        }
+      }
+
+      void numeric(Index begin, Index end) const
+      {
+        Matrix<Scalar,Dynamic,1> acc = Matrix<Scalar,Dynamic,1>::Zero(m_innerSize);
+        for(Index j=begin; j<end; ++j)
+        {
+          for(typename DriverEval::InnerIterator dIt(m_driver, j); dIt; ++dIt)
+            for(typename OtherEval::InnerIterator oIt(m_other, dIt.index()); oIt; ++oIt)
+            {
+              // keep the lhs * rhs order of the factors
+              if(IsRowMajor) acc(oIt.index()) += dIt.value() * oIt.value();
+              else           acc(oIt.index()) += oIt.value() * dIt.value();
+            }
+          for(Index p=m_outerIndex[j]; p<m_outerIndex[j+1]; ++p)
+          {
+            m_values[p] = acc(m_innerIndices[p]);
+            acc(m_innerIndices[p]) = Scalar(0);
+          }
+        }
+        // entries outside of the pattern would remain in the accumulator
+        eigen_assert(acc.isZero(RealScalar(0)) && "the sparsity patterns of the operands differ from the ones given to analyzePattern()");
+      }
+
+      const SymbolicSparseProduct& m_self;
+      const DriverEval& m_driver;
+      const OtherEval& m_other;
+      Index m_innerSize;
+      Index m_numTasks;
+      Phase m_phase;
+      StorageIndex* m_outerIndex;
+      StorageIndex* m_innerIndices;
+      Scalar* m_values;
+    };
+
+    // first outer vector of the task t out of numTasks, such that each task performs about the same number of flops
+    Index taskBegin(Index t, Index numTasks) const
+    {
+      Index outerSize = m_work.size()-1;
+      if(t==numTasks) return outerSize;
+      Index target = (m_work(outerSize)*t)/numTasks;
+      return std::lower_bound(m_work.data(), m_work.data()+outerSize, target) - m_work.data();
+    }
+
+    Index numTasks() const
+    {
+      // below this number of flops per thread, running in parallel is not worth it
+      const Index min_work_per_thread = 50000;
+      Index outerSize = m_work.size()-1;
+      return numext::maxi<Index>(1, numext::mini<Index>(nbThreads(), m_work(outerSize)/min_work_per_thread));
+    }
+
+    Index m_rows;
+    Index m_cols;
+    IndexVector m_outerIndex;
+    IndexVector m_innerIndices;
+    Matrix<Index,Dynamic,1> m_work;   // m_work(j) is the number of flops needed by the outer vectors before j
+    bool m_isInitialized;
+};
+
+template<typename SparseMatrixType>
+template<typename Lhs, typename Rhs>
+SymbolicSparseProduct<SparseMatrixType>& SymbolicSparseProduct<SparseMatrixType>::analyzePattern(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs)
+{
+  eigen_assert(lhs.cols() == rhs.rows());
+  typedef typename internal::symbolic_product_operand<Lhs,Order,StorageIndex>::type LhsOperand;
+  typedef typename internal::symbolic_product_operand<Rhs,Order,StorageIndex>::type RhsOperand;
+  typedef typename internal::remove_all<LhsOperand>::type LhsPlain;
+  typedef typename internal::remove_all<RhsOperand>::type RhsPlain;
+  typedef typename internal::conditional<IsRowMajor, LhsPlain, RhsPlain>::type Driver;
+  typedef typename internal::conditional<IsRowMajor, RhsPlain, LhsPlain>::type Other;
+
+  LhsOperand lhsOp(lhs.derived());
+  RhsOperand rhsOp(rhs.derived());
+  internal::evaluator<Driver> driver(internal::symbolic_product_roles<IsRowMajor>::driver(lhsOp, rhsOp));
+  internal::evaluator<Other> other(internal::symbolic_product_roles<IsRowMajor>::other(lhsOp, rhsOp));
+
+  m_rows = lhs.rows();
+  m_cols = rhs.cols();
+  const Index outerSize = IsRowMajor ? m_rows : m_cols;
+  const Index innerSize = IsRowMajor ? m_cols : m_rows;
+  const Index depth = lhs.cols();
+
+  // estimate the work per outer vector from the number of non zeros of the outer vectors of the other operand
+  Matrix<Index,Dynamic,1> otherNonZeros(depth);
+  for(Index k=0; k<depth; ++k)
+  {
+    Index nnz = 0;
+    for(typename internal::evaluator<Other>::InnerIterator it(other, k); it; ++it)
+      ++nnz;
+    otherNonZeros(k) = nnz;
+  }
+  m_work.resize(outerSize+1);
+  m_work(0) = 0;
+  for(Index j=0; j<outerSize; ++j)
+  {
+    Index work = 1;
+    for(typename internal::evaluator<Driver>::InnerIterator it(driver, j); it; ++it)
+      work += otherNonZeros(it.index());
+    m_work(j+1) = m_work(j) + work;
+  }
+
+  typedef Job<internal::evaluator<Driver>, internal::evaluator<Other> > JobType;
+  Index tasks = numTasks();
+  m_outerIndex.resize(outerSize+1);
+  m_outerIndex(0) = 0;
+  internal::parallelize_tasks(tasks, JobType(*this, driver, other, innerSize, tasks, CountPhase, m_outerIndex.data(), 0, 0));
+  for(Index j=0; j<outerSize; ++j)
+    m_outerIndex(j+1) += m_outerIndex(j);
+  m_innerIndices.resize(m_outerIndex(outerSize));
+  internal::parallelize_tasks(tasks, JobType(*this, driver, other, innerSize, tasks, FillPhase, m_outerIndex.data(), m_innerIndices.data(), 0));
+
+  m_isInitialized = true;
+  return *this;
+}
+
+template<typename SparseMatrixType>
+template<typename Lhs, typename Rhs>
+void SymbolicSparseProduct<SparseMatrixType>::evaluate(const SparseMatrixBase<Lhs>& lhs, const SparseMatrixBase<Rhs>& rhs, SparseMatrixType& res) const
+{
+  eigen_assert(m_isInitialized && "SymbolicSparseProduct is not initialized.");
+  eigen_assert(lhs.rows()==m_rows && rhs.cols()==m_cols && lhs.cols()==rhs.rows()
+            && "the sizes of the operands differ from the ones given to analyzePattern()");
+  typedef typename internal::symbolic_product_operand<Lhs,Order,StorageIndex>::type LhsOperand;
+  typedef typename internal::symbolic_product_operand<Rhs,Order,StorageIndex>::type RhsOperand;
+  typedef typename internal::remove_all<LhsOperand>::type LhsPlain;
+  typedef typename internal::remove_all<RhsOperand>::type RhsPlain;
+  typedef typename internal::conditional<IsRowMajor, LhsPlain, RhsPlain>::type Driver;
+  typedef typename internal::conditional<IsRowMajor, RhsPlain, LhsPlain>::type Other;
+
+  LhsOperand lhsOp(lhs.derived());
+  RhsOperand rhsOp(rhs.derived());
+  internal::evaluator<Driver> driver(internal::symbolic_product_roles<IsRowMajor>::driver(lhsOp, rhsOp));
+  internal::evaluator<Other> other(internal::symbolic_product_roles<IsRowMajor>::other(lhsOp, rhsOp));
+
+  const Index outerSize = IsRowMajor ? m_rows : m_cols;
+  const Index innerSize = IsRowMajor ? m_cols : m_rows;
+  res.resize(m_rows, m_cols);
+  res.resizeNonZeros(nonZeros());
+  std::copy(m_outerIndex.data(), m_outerIndex.data()+outerSize+1, res.outerIndexPtr());
+  std::copy(m_innerIndices.data(), m_innerIndices.data()+nonZeros(), res.innerIndexPtr());
+
+  typedef Job<internal::evaluator<Driver>, internal::evaluator<Other> > JobType;
+  Index tasks = numTasks();
+  internal::parallelize_tasks(tasks, JobType(*this, driver, other, innerSize, tasks, NumericPhase,
+                                             res.outerIndexPtr(), res.innerIndexPtr(), res.valuePtr()));
+}
+
+} // end namespace Eigen
+
+#endif // EIGEN_SYMBOLICSPARSEPRODUCT_H
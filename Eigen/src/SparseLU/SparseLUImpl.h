@@ -49,6 +49,7 @@ class SparseLUImpl
      void panel_dfs(const Index m, const Index w, const Index jcol, MatrixType& A, IndexVector& perm_r, Index& nseg, ScalarVector& dense, IndexVector& panel_lsub, IndexVector& segrep, IndexVector& repfnz, IndexVector& xprune, IndexVector& marker, IndexVector& parent, IndexVector& xplore, GlobalLU_t& glu);
     
      void panel_bmod(const Index m, const Index w, const Index jcol, const Index nseg, ScalarVector& dense, ScalarVector& tempv, IndexVector& segrep, IndexVector& repfnz, GlobalLU_t& glu);
+     void panel_bmod_columns(const Index m, const Index jcol, const Index jbegin, const Index jend, const Index nseg, ScalarVector& dense, BlockScalarVector tempv, IndexVector& segrep, IndexVector& repfnz, GlobalLU_t& glu);
      Index column_dfs(const Index m, const Index jcol, IndexVector& perm_r, Index maxsuper, Index& nseg,  BlockIndexVector lsub_col, IndexVector& segrep, BlockIndexVector repfnz, IndexVector& xprune, IndexVector& marker, IndexVector& parent, IndexVector& xplore, GlobalLU_t& glu);
      Index column_bmod(const Index jcol, const Index nseg, BlockScalarVector dense, ScalarVector& tempv, BlockIndexVector segrep, BlockIndexVector repfnz, Index fpanelc, GlobalLU_t& glu); 
      Index copy_to_ucol(const Index jcol, const Index nseg, IndexVector& segrep, BlockIndexVector repfnz ,IndexVector& perm_r, BlockScalarVector dense, GlobalLU_t& glu); 
@@ -58,6 +59,31 @@ class SparseLUImpl
      
      template<typename , typename >
      friend struct column_dfs_traits;
+
+     // Updates one of the \a tasks groups of contiguous columns of a panel (see panel_bmod)
+     struct panel_bmod_task
+     {
+       panel_bmod_task(SparseLUImpl& impl, Index m, Index w, Index jcol, Index tasks, Index nseg, ScalarVector& dense, ScalarVector& tempv,
+                       Index tempv_per_column, IndexVector& segrep, IndexVector& repfnz, GlobalLU_t& glu)
+         : impl(impl), m(m), w(w), jcol(jcol), tasks(tasks), nseg(nseg), dense(dense), tempv(tempv),
+           tempv_per_column(tempv_per_column), segrep(segrep), repfnz(repfnz), glu(glu) {}
+
+       void operator()(Index t) const
+       {
+         Index jbegin = (t*w)/tasks, jend = ((t+1)*w)/tasks;
+         impl.panel_bmod_columns(m, jcol, jcol+jbegin, jcol+jend, nseg, dense,
+                                 tempv.segment(jbegin*tempv_per_column, (jend-jbegin)*tempv_per_column), segrep, repfnz, glu);
+       }
+
+       SparseLUImpl& impl;
+       Index m, w, jcol, tasks, nseg;
+       ScalarVector& dense;
+       ScalarVector& tempv;
+       Index tempv_per_column;
+       IndexVector& segrep;
+       IndexVector& repfnz;
+       GlobalLU_t& glu;
+     };
 }; 
 
 } // end namespace internal
@@ -35,28 +35,22 @@ namespace Eigen {
 namespace internal {
 
 /**
- * \brief Performs numeric block updates (sup-panel) in topological order.
- * 
- * Before entering this routine, the original nonzeros in the panel
- * were already copied into the spa[m,w]
- * 
- * \param m number of rows in the matrix
- * \param w Panel size
- * \param jcol Starting  column of the panel
- * \param nseg Number of segments in the U part
- * \param dense Store the full representation of the panel 
- * \param tempv working array 
- * \param segrep segment representative... first row in the segment
- * \param repfnz First nonzero rows
- * \param glu Global LU data. 
+ * \brief Performs the sup-panel updates of the panel columns [jbegin,jend) in topological order.
  * 
+ * The updates of distinct panel columns are independent, hence disjoint column ranges
+ * can be processed concurrently as long as they are given distinct working arrays.
  * 
+ * \param jbegin First panel column to update
+ * \param jend End of the range of panel columns to update
+ * \param tempv working array, aligned on a packet boundary
+ * \sa panel_bmod()
  */
 template <typename Scalar, typename StorageIndex>
-void SparseLUImpl<Scalar,StorageIndex>::panel_bmod(const Index m, const Index w, const Index jcol, 
-                                            const Index nseg, ScalarVector& dense, ScalarVector& tempv,
+void SparseLUImpl<Scalar,StorageIndex>::panel_bmod_columns(const Index m, const Index jcol, const Index jbegin, const Index jend,
+                                            const Index nseg, ScalarVector& dense, BlockScalarVector tempv,
                                             IndexVector& segrep, IndexVector& repfnz, GlobalLU_t& glu)
 {
+  const Index w = jend - jbegin;
   
   Index ksub,jj,nextl_col; 
   Index fsupc, nsupc, nsupr, nrow; 
@@ -85,7 +79,7 @@ void SparseLUImpl<Scalar,StorageIndex>::panel_bmod(const Index m, const Index w,
     // loop over the panel columns to detect the actual number of columns and rows
     Index u_rows = 0;
     Index u_cols = 0;
-    for (jj = jcol; jj < jcol + w; jj++)
+    for (jj = jbegin; jj < jend; jj++)
     {
       nextl_col = (jj-jcol) * m; 
       VectorBlock<IndexVector> repfnz_col(repfnz, nextl_col, m); // First nonzero column index for each row
@@ -106,7 +100,7 @@ void SparseLUImpl<Scalar,StorageIndex>::panel_bmod(const Index m, const Index w,
       
       // gather U
       Index u_col = 0;
-      for (jj = jcol; jj < jcol + w; jj++)
+      for (jj = jbegin; jj < jend; jj++)
       {
         nextl_col = (jj-jcol) * m; 
         VectorBlock<IndexVector> repfnz_col(repfnz, nextl_col, m); // First nonzero column index for each row
@@ -142,17 +136,17 @@ void SparseLUImpl<Scalar,StorageIndex>::panel_bmod(const Index m, const Index w,
       // update
       luptr += u_rows;
       MappedMatrixBlock B(glu.lusup.data()+luptr, nrow, u_rows, OuterStride<>(lda) );
-      eigen_assert(tempv.size()>w*ldu + nrow*w + 1);
       
       Index ldl = internal::first_multiple<Index>(nrow, PacketSize);
       Index offset = (PacketSize-internal::first_default_aligned(B.data(), PacketSize)) % PacketSize;
+      eigen_assert(tempv.size()>=w*ldu + offset + ldl*w);
       MappedMatrixBlock L(tempv.data()+w*ldu+offset, nrow, u_cols, OuterStride<>(ldl));
       
       L.noalias() = B * U;
       
       // scatter U and L
       u_col = 0;
-      for (jj = jcol; jj < jcol + w; jj++)
+      for (jj = jbegin; jj < jend; jj++)
       {
         nextl_col = (jj-jcol) * m; 
         VectorBlock<IndexVector> repfnz_col(repfnz, nextl_col, m); // First nonzero column index for each row
@@ -187,7 +181,7 @@ void SparseLUImpl<Scalar,StorageIndex>::panel_bmod(const Index m, const Index w,
     else // level 2 only
     {
       // Sequence through each column in the panel
-      for (jj = jcol; jj < jcol + w; jj++)
+      for (jj = jbegin; jj < jend; jj++)
       {
         nextl_col = (jj-jcol) * m; 
         VectorBlock<IndexVector> repfnz_col(repfnz, nextl_col, m); // First nonzero column index for each row
@@ -215,6 +209,50 @@ void SparseLUImpl<Scalar,StorageIndex>::panel_bmod(const Index m, const Index w,
   } // End for each updating supernode
 } // end panel bmod
 
+/**
+ * \brief Performs numeric block updates (sup-panel) in topological order.
+ * 
+ * Before entering this routine, the original nonzeros in the panel
+ * were already copied into the spa[m,w]
+ * 
+ * The columns of the panel are updated independently from each other. When several threads are
+ * available and the panel has enough updating supernodes, they are split into contiguous groups
+ * that are processed concurrently, each group working on its own part of \a tempv.
+ * 
+ * \param m number of rows in the matrix
+ * \param w Panel size
+ * \param jcol Starting  column of the panel
+ * \param nseg Number of segments in the U part
+ * \param dense Store the full representation of the panel 
+ * \param tempv working array 
+ * \param segrep segment representative... first row in the segment
+ * \param repfnz First nonzero rows
+ * \param glu Global LU data. 
+ * 
+ * 
+ */
+template <typename Scalar, typename StorageIndex>
+void SparseLUImpl<Scalar,StorageIndex>::panel_bmod(const Index m, const Index w, const Index jcol, 
+                                            const Index nseg, ScalarVector& dense, ScalarVector& tempv,
+                                            IndexVector& segrep, IndexVector& repfnz, GlobalLU_t& glu)
+{
+  const Index PacketSize = internal::packet_traits<Scalar>::size;
+  // Below this number of updating supernodes, the work is not worth the synchronization.
+  const Index min_segments_per_panel = 8;
+  Index tasks = (std::min)(Index(nbThreads()), w);
+  if(tasks<=1 || nseg<min_segments_per_panel)
+  {
+    panel_bmod_columns(m, jcol, jcol, jcol+w, nseg, dense, tempv, segrep, repfnz, glu);
+    return;
+  }
+
+  // Each group receives a share of tempv proportional to its number of columns,
+  // rounded down to a multiple of the packet size to preserve the alignment.
+  const Index per_column = ((tempv.size()/w)/PacketSize)*PacketSize;
+  panel_bmod_task task(*this, m, w, jcol, tasks, nseg, dense, tempv, per_column, segrep, repfnz, glu);
+  parallelize_tasks(tasks, task);
+}
+
 } // end namespace internal
 
 } // end namespace Eigen
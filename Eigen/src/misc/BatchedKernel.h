@@ -0,0 +1,113 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_MISC_BATCHED_KERNEL_H
+#define EIGEN_MISC_BATCHED_KERNEL_H
+
+namespace Eigen {
+
+namespace internal {
+
+/** \internal
+  * Interleaved ("structure of arrays") storage of a batch of matrices with \a Rows rows, as used by the batched
+  * decompositions: the batch is a column-major matrix whose row \a b holds the column-major coefficients of
+  * the \a b-th problem, and whose columns are \a Stride apart. Coefficient (i,j) of the problems \a first,
+  * \a first+1, ... is thus a contiguous run of the batch, which is loaded into one packet so that each SIMD lane
+  * works on its own problem.
+  */
+template<typename Scalar, int Rows = Dynamic, int Stride = Dynamic>
+struct batched_view
+{
+  batched_view(Scalar* data, Index stride, Index rows)
+    : m_data(data), m_stride(stride), m_rows(rows)
+  {}
+
+  Index rows() const { return m_rows.value(); }
+
+  template<typename Packet>
+  EIGEN_STRONG_INLINE Packet load(Index first, Index i, Index j) const
+  { return ploadu<Packet>(m_data + (i + j*rows())*m_stride.value() + first); }
+
+  template<typename Packet>
+  EIGEN_STRONG_INLINE void store(Index first, Index i, Index j, const Packet& value) const
+  { pstoreu<Scalar>(m_data + (i + j*rows())*m_stride.value() + first, value); }
+
+  Scalar* m_data;
+  variable_if_dynamic<Index, Stride> m_stride;
+  variable_if_dynamic<Index, Rows> m_rows;
+};
+
+/** \internal Copies the first \a cols columns of \a Packets packets of problems starting at \a srcFirst in \a src
+  * to the problems starting at \a dstFirst in \a dst
+  *
+  * The kernels copy the problems they process to a small contiguous buffer before working on them: in a batch,
+  * consecutive coefficients of a problem are a whole batch apart, which causes many cache conflicts when the
+  * batch size is close to a power of two. The buffer covers whole cache lines of the batch.
+  */
+template<typename Packet, int Packets, typename SrcView, typename DstView>
+EIGEN_STRONG_INLINE void batched_copy(const SrcView& src, Index srcFirst, const DstView& dst, Index dstFirst, Index cols)
+{
+  enum { PacketSize = unpacket_traits<Packet>::size };
+  for(Index j = 0; j < cols; ++j)
+    for(Index i = 0; i < src.rows(); ++i)
+      for(Index p = 0; p < Packets; ++p)
+        dst.store(dstFirst + p*PacketSize, i, j, src.template load<Packet>(srcFirst + p*PacketSize, i, j));
+}
+
+/** \internal Runs a batched kernel on a contiguous range of problems */
+template<typename Scalar, typename Kernel>
+struct batched_task
+{
+  typedef typename packet_traits<Scalar>::type Packet;
+  enum {
+    PacketSize = packet_traits<Scalar>::size,
+    // number of packets spanning a 64 bytes cache line
+    PacketsPerLine = 64 / (PacketSize * sizeof(Scalar)) > 1 ? 64 / (PacketSize * sizeof(Scalar)) : 1,
+    ProblemsPerLine = PacketsPerLine * PacketSize
+  };
+
+  batched_task(const Kernel& kernel, Index batchSize, Index problemsPerTask)
+    : m_kernel(kernel), m_batchSize(batchSize), m_problemsPerTask(problemsPerTask)
+  {}
+
+  void operator()(Index task) const
+  {
+    const Index begin = task * m_problemsPerTask;
+    const Index end = (std::min)(begin + m_problemsPerTask, m_batchSize);
+    Index b = begin;
+    for(; b + ProblemsPerLine <= end; b += ProblemsPerLine)
+      m_kernel.template run<Packet,PacketsPerLine>(b);
+    for(; b + PacketSize <= end; b += PacketSize)
+      m_kernel.template run<Packet,1>(b);
+    // remaining problems are processed one by one through the scalar versions of the packet primitives
+    for(; b < end; ++b)
+      m_kernel.template run<Scalar,1>(b);
+  }
+
+  const Kernel& m_kernel;
+  Index m_batchSize, m_problemsPerTask;
+};
+
+/** \internal
+  * Calls \c kernel.template \c run<Packet,Packets>(b) for the problems \a b, ..., \a b + Packets * PacketSize - 1 of a
+  * batch, and \c kernel.template \c run<Scalar,1>(b) for the problems left over, splitting the batch among the
+  * available threads.
+  */
+template<typename Scalar, typename Kernel>
+void batched_run(const Kernel& kernel, Index batchSize)
+{
+  // a multiple of the cache line, so that only the last task has left over problems
+  const Index problemsPerTask = 64 * batched_task<Scalar,Kernel>::ProblemsPerLine;
+  const Index numTasks = (batchSize + problemsPerTask - 1) / problemsPerTask;
+  parallelize_tasks(numTasks, batched_task<Scalar,Kernel>(kernel, batchSize, problemsPerTask));
+}
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_MISC_BATCHED_KERNEL_H
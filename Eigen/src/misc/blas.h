@@ -6,7 +6,9 @@ extern "C"
 {
 #endif
 
+#ifndef BLASFUNC
 #define BLASFUNC(FUNC) FUNC##_
+#endif
 
 #ifdef __WIN64__
 typedef long long BLASLONG;
@@ -0,0 +1,71 @@
+#ifndef EIGEN_BENCH_SCALING_H
+#define EIGEN_BENCH_SCALING_H
+
+// Shared driver of the strong scaling benchmarks (dense_lu_scaling, sparse_lu_scaling, bench_svd).
+// Compile them either with OpenMP (-fopenmp) or with -std=c++11 -pthread -DEIGEN_GEMM_THREADPOOL,
+// in which case the products run on a thread pool of hardware_concurrency()-1 threads.
+
+#include <iostream>
+#include <Eigen/Core>
+#include "BenchTimer.h"
+#ifdef EIGEN_GEMM_THREADPOOL
+#include <unsupported/Eigen/CXX11/ThreadPool>
+#endif
+
+#ifndef NBTRIES
+#define NBTRIES 3
+#endif
+
+class ScalingBench
+{
+  public:
+    ScalingBench()
+#ifdef EIGEN_GEMM_THREADPOOL
+      : m_pool(std::thread::hardware_concurrency()>1 ? std::thread::hardware_concurrency()-1 : 1)
+#endif
+    {
+#ifdef EIGEN_GEMM_THREADPOOL
+      Eigen::setGemmThreadPool(&m_pool);
+#endif
+    }
+
+    ~ScalingBench()
+    {
+#ifdef EIGEN_GEMM_THREADPOOL
+      Eigen::setGemmThreadPool(0);
+#endif
+      Eigen::setNbThreads(0);
+    }
+
+    /** For 1 to nbThreads() threads, calls \a step(timer) NBTRIES times, \a step being responsible for starting and
+      * stopping the timer around the measured part, then prints the best time, the speedup over one thread,
+      * and whatever \a report(best_time) prints. \a report may return false to abort, and so does run(). */
+    template<typename Step, typename Report>
+    bool run(const Step& step, const Report& report)
+    {
+      const int max_threads = Eigen::nbThreads();
+      double reference = 0;
+      for(int threads=1; threads<=max_threads; ++threads)
+      {
+        Eigen::setNbThreads(threads);
+        Eigen::BenchTimer timer;
+        for(int k=0; k<NBTRIES; ++k)
+          step(timer);
+        if(threads==1)
+          reference = timer.best();
+        std::cout << threads << " threads:\t" << timer.best() << "s\tspeedup " << reference/timer.best();
+        bool ok = report(timer.best());
+        std::cout << "\n";
+        if(!ok)
+          return false;
+      }
+      return true;
+    }
+
+  protected:
+#ifdef EIGEN_GEMM_THREADPOOL
+    Eigen::ThreadPool m_pool;
+#endif
+};
+
+#endif // EIGEN_BENCH_SCALING_H
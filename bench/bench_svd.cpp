@@ -0,0 +1,49 @@
+// Measures the strong scaling of BDCSVD, as well as the share of its bidiagonalization step.
+// g++ -I.. bench_svd.cpp -O3 -DNDEBUG -fopenmp -DSIZE=4000 && ./a.out
+// g++ -I.. bench_svd.cpp -O3 -DNDEBUG -std=c++11 -pthread -DEIGEN_GEMM_THREADPOOL -DSIZE=4000 && ./a.out
+
+#ifndef NBTRIES
+#define NBTRIES 2
+#endif
+
+#include <Eigen/SVD>
+#include <bench/BenchScaling.h>
+
+using namespace Eigen;
+
+#ifndef SIZE
+#define SIZE 2000
+#endif
+
+#ifndef SCALAR
+#define SCALAR double
+#endif
+
+typedef SCALAR Scalar;
+typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+
+int main()
+{
+  DenseMatrix A = DenseMatrix::Random(SIZE,SIZE);
+  ScalingBench bench;
+
+  std::cout << "n=" << SIZE << "\n";
+
+  BDCSVD<DenseMatrix> svd(SIZE, SIZE, ComputeThinU|ComputeThinV);
+  BenchTimer bidiag;
+  bench.run([&](BenchTimer& timer) {
+              bidiag.start();
+              internal::UpperBidiagonalization<DenseMatrix> bid(A);
+              bidiag.stop();
+              timer.start();
+              svd.compute(A, ComputeThinU|ComputeThinV);
+              timer.stop();
+            },
+            [&](double) {
+              std::cout << "\tbidiagonalization " << bidiag.best() << "s"
+                        << "\terror " << (svd.matrixU() * svd.singularValues().asDiagonal() * svd.matrixV().transpose() - A).norm()/A.norm();
+              bidiag.reset();
+              return true;
+            });
+  return 0;
+}
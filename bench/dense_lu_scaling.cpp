@@ -0,0 +1,39 @@
+// Measures the strong scaling of the PartialPivLU factorization.
+// g++ -I.. dense_lu_scaling.cpp -O3 -DNDEBUG -fopenmp -DSIZE=8000 && ./a.out
+// g++ -I.. dense_lu_scaling.cpp -O3 -DNDEBUG -std=c++11 -pthread -DEIGEN_GEMM_THREADPOOL -DSIZE=8000 && ./a.out
+
+#include <Eigen/LU>
+#include <bench/BenchScaling.h>
+
+using namespace Eigen;
+
+#ifndef SIZE
+#define SIZE 4000
+#endif
+
+#ifndef SCALAR
+#define SCALAR double
+#endif
+
+typedef SCALAR Scalar;
+typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+int main()
+{
+  DenseMatrix A = DenseMatrix::Random(SIZE,SIZE);
+  DenseVector b = DenseVector::Random(SIZE);
+  ScalingBench bench;
+
+  std::cout << "n=" << SIZE << "\n";
+
+  PartialPivLU<DenseMatrix> lu(SIZE);
+  bench.run([&](BenchTimer& timer) { timer.start(); lu.compute(A); timer.stop(); },
+            [&](double time) {
+              DenseVector x = lu.solve(b);
+              std::cout << "\t" << 2.0/3.0*double(SIZE)*double(SIZE)*double(SIZE)*1e-9/time << " GFLOPS"
+                        << "\tresidual " << (A*x-b).norm()/b.norm();
+              return true;
+            });
+  return 0;
+}
@@ -0,0 +1,69 @@
+// Measures the strong scaling of the SparseLU numerical factorization.
+// g++ -I.. sparse_lu_scaling.cpp -O3 -DNDEBUG -fopenmp -DSIZE=40 && ./a.out
+// g++ -I.. sparse_lu_scaling.cpp -O3 -DNDEBUG -std=c++11 -pthread -DEIGEN_GEMM_THREADPOOL -DSIZE=40 && ./a.out
+
+#include <Eigen/SparseLU>
+#include <bench/BenchScaling.h>
+
+using namespace Eigen;
+
+// grid size of the 3D convection-diffusion operator
+#ifndef SIZE
+#define SIZE 30
+#endif
+
+#ifndef SCALAR
+#define SCALAR double
+#endif
+
+typedef SCALAR Scalar;
+typedef SparseMatrix<Scalar,ColMajor> SpMat;
+typedef Matrix<Scalar,Dynamic,1> DenseVector;
+
+// 7-point finite-difference convection-diffusion operator, which is unsymmetric.
+SpMat make_operator(int n)
+{
+  std::vector<Triplet<Scalar> > triplets;
+  const int size = n*n*n;
+  triplets.reserve(7*size);
+  for(int i=0; i<n; ++i)
+    for(int j=0; j<n; ++j)
+      for(int k=0; k<n; ++k)
+      {
+        int id = (i*n+j)*n+k;
+        triplets.push_back(Triplet<Scalar>(id,id,Scalar(6)));
+        if(i>0)   triplets.push_back(Triplet<Scalar>(id,id-n*n,Scalar(-1.3)));
+        if(i<n-1) triplets.push_back(Triplet<Scalar>(id,id+n*n,Scalar(-0.7)));
+        if(j>0)   triplets.push_back(Triplet<Scalar>(id,id-n,Scalar(-1.2)));
+        if(j<n-1) triplets.push_back(Triplet<Scalar>(id,id+n,Scalar(-0.8)));
+        if(k>0)   triplets.push_back(Triplet<Scalar>(id,id-1,Scalar(-1.1)));
+        if(k<n-1) triplets.push_back(Triplet<Scalar>(id,id+1,Scalar(-0.9)));
+      }
+  SpMat A(size,size);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+int main()
+{
+  SpMat A = make_operator(SIZE);
+  DenseVector b = DenseVector::Random(A.rows());
+  ScalingBench bench;
+
+  std::cout << "n=" << A.rows() << " nnz=" << A.nonZeros() << "\n";
+
+  SparseLU<SpMat> lu;
+  lu.analyzePattern(A);
+  bool ok = bench.run([&](BenchTimer& timer) { timer.start(); lu.factorize(A); timer.stop(); },
+                      [&](double) {
+                        if(lu.info()!=Success)
+                        {
+                          std::cout << "\tfactorization failed";
+                          return false;
+                        }
+                        DenseVector x = lu.solve(b);
+                        std::cout << "\tresidual " << (A*x-b).norm()/b.norm();
+                        return true;
+                      });
+  return ok ? 0 : 1;
+}
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include "BenchTimer.h"
 #include "BenchSparseUtil.h"
+#include <unsupported/Eigen/SparseExtra>
 
 #define SPMV_BENCH(CODE) BENCH(t,tries,repeats,CODE);
 
@@ -113,6 +114,17 @@ int main(int argc, char *argv[])
       std::cout << t.value()/repeats << endl;
     }
 
+    // row-major CSR versus SELL-C-sigma
+    {
+      SparseMatrix<Scalar,RowMajor> csr(sm);
+      SPMV_BENCH(res.noalias() += csr * dv; )
+      std::cout << "Eigen CSR   " << t.value()/repeats << endl;
+
+      SellMatrix<Scalar> sell(csr);
+      SPMV_BENCH(res.noalias() += sell * dv; )
+      std::cout << "Eigen SELL  " << t.value()/repeats << "\t(fill " << double(sell.storedEntries())/double(csr.nonZeros()) << ")" << endl;
+    }
+
     // CSparse
     #ifdef CSPARSE
     {
@@ -29,6 +29,15 @@
 
 #include "../Eigen/src/misc/blas.h"
 
+#ifdef EIGEN_BLAS_FUNC_SUFFIX
+// The entry points are renamed, e.g., for the per-ISA variants of the runtime
+// dispatch, so declare the renamed functions with C linkage as well.
+#undef BLAS_H
+#undef BLASFUNC
+#define BLASFUNC(FUNC) EIGEN_CAT(FUNC, EIGEN_BLAS_FUNC_SUFFIX)
+#include "../Eigen/src/misc/blas.h"
+#endif
+
 #define NOTR    0
 #define TR      1
 #define ADJ     2
@@ -0,0 +1,108 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+// Runtime dispatch of the BLAS entry points (EIGEN_BLAS_DISPATCH=ON).
+//
+// The routines of single.cpp, double.cpp, complex_single.cpp and complex_double.cpp
+// are compiled once per instruction set, with the suffixes _generic_, _avx2_ and
+// _avx512_. Every standard entry point is defined here as a GNU indirect function
+// whose resolver runs once, when the symbol is bound, and returns the variant
+// matching the features of the running CPU. Calls then go straight to the selected
+// variant, without any per-call overhead.
+//
+// The objects of each variant are partially linked, and all their symbols but the
+// suffixed entry points are made local (see CMakeLists.txt), so that the inline
+// functions and template instantiations of a variant, including the ones of the STL,
+// are never replaced by the copies of another variant.
+
+#if !(defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__ELF__))
+#error EIGEN_BLAS_DISPATCH requires GCC or Clang targeting x86 on an ELF platform
+#endif
+
+// Declare the standard entry points and the three variants with their actual prototypes.
+#include "../Eigen/src/misc/blas.h"
+#undef BLAS_H
+#undef BLASFUNC
+#define BLASFUNC(FUNC) FUNC##_generic_
+#include "../Eigen/src/misc/blas.h"
+#undef BLAS_H
+#undef BLASFUNC
+#define BLASFUNC(FUNC) FUNC##_avx2_
+#include "../Eigen/src/misc/blas.h"
+#undef BLAS_H
+#undef BLASFUNC
+#define BLASFUNC(FUNC) FUNC##_avx512_
+#include "../Eigen/src/misc/blas.h"
+
+namespace {
+
+enum isa_level { ISA_GENERIC, ISA_AVX2, ISA_AVX512 };
+
+// Resolvers may run before the static initializers, so the CPU model must be
+// initialized explicitly. __builtin_cpu_supports also checks that the OS saves
+// the extended registers.
+isa_level best_isa()
+{
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512bw")
+     && __builtin_cpu_supports("fma"))
+    return ISA_AVX512;
+  if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return ISA_AVX2;
+  return ISA_GENERIC;
+}
+
+template<typename Function>
+Function select(Function generic, Function avx2, Function avx512)
+{
+  switch(best_isa())
+  {
+    case ISA_AVX512: return avx512;
+    case ISA_AVX2:   return avx2;
+    default:         return generic;
+  }
+}
+
+}
+
+// The indirect function gets the type of its variants, which blas.h declares
+// identical to the one of the standard symbol.
+#define EIGEN_BLAS_DISPATCH(NAME) \
+  extern "C" __typeof__(&NAME##_generic_) eigen_blas_resolve_##NAME() { return select(&NAME##_generic_, &NAME##_avx2_, &NAME##_avx512_); } \
+  extern "C" __typeof__(NAME##_generic_) NAME##_ __attribute__((ifunc("eigen_blas_resolve_" #NAME)));
+
+// single.cpp
+EIGEN_BLAS_DISPATCH(isamax) EIGEN_BLAS_DISPATCH(isamin) EIGEN_BLAS_DISPATCH(sasum) EIGEN_BLAS_DISPATCH(saxpy) EIGEN_BLAS_DISPATCH(scopy) EIGEN_BLAS_DISPATCH(sdot)
+EIGEN_BLAS_DISPATCH(sdsdot) EIGEN_BLAS_DISPATCH(sgbmv) EIGEN_BLAS_DISPATCH(sgemm) EIGEN_BLAS_DISPATCH(sgemv) EIGEN_BLAS_DISPATCH(sger) EIGEN_BLAS_DISPATCH(snrm2)
+EIGEN_BLAS_DISPATCH(srot) EIGEN_BLAS_DISPATCH(srotg) EIGEN_BLAS_DISPATCH(sscal) EIGEN_BLAS_DISPATCH(sspr) EIGEN_BLAS_DISPATCH(sspr2) EIGEN_BLAS_DISPATCH(sswap)
+EIGEN_BLAS_DISPATCH(ssymm) EIGEN_BLAS_DISPATCH(ssymv) EIGEN_BLAS_DISPATCH(ssyr) EIGEN_BLAS_DISPATCH(ssyr2) EIGEN_BLAS_DISPATCH(ssyr2k) EIGEN_BLAS_DISPATCH(ssyrk)
+EIGEN_BLAS_DISPATCH(stbsv) EIGEN_BLAS_DISPATCH(stpmv) EIGEN_BLAS_DISPATCH(stpsv) EIGEN_BLAS_DISPATCH(strmm) EIGEN_BLAS_DISPATCH(strmv) EIGEN_BLAS_DISPATCH(strsm)
+EIGEN_BLAS_DISPATCH(strsv)
+
+// double.cpp
+EIGEN_BLAS_DISPATCH(dasum) EIGEN_BLAS_DISPATCH(daxpy) EIGEN_BLAS_DISPATCH(dcopy) EIGEN_BLAS_DISPATCH(ddot) EIGEN_BLAS_DISPATCH(dgbmv) EIGEN_BLAS_DISPATCH(dgemm)
+EIGEN_BLAS_DISPATCH(dgemv) EIGEN_BLAS_DISPATCH(dger) EIGEN_BLAS_DISPATCH(dnrm2) EIGEN_BLAS_DISPATCH(drot) EIGEN_BLAS_DISPATCH(drotg) EIGEN_BLAS_DISPATCH(dscal)
+EIGEN_BLAS_DISPATCH(dsdot) EIGEN_BLAS_DISPATCH(dspr) EIGEN_BLAS_DISPATCH(dspr2) EIGEN_BLAS_DISPATCH(dswap) EIGEN_BLAS_DISPATCH(dsymm) EIGEN_BLAS_DISPATCH(dsymv)
+EIGEN_BLAS_DISPATCH(dsyr) EIGEN_BLAS_DISPATCH(dsyr2) EIGEN_BLAS_DISPATCH(dsyr2k) EIGEN_BLAS_DISPATCH(dsyrk) EIGEN_BLAS_DISPATCH(dtbsv) EIGEN_BLAS_DISPATCH(dtpmv)
+EIGEN_BLAS_DISPATCH(dtpsv) EIGEN_BLAS_DISPATCH(dtrmm) EIGEN_BLAS_DISPATCH(dtrmv) EIGEN_BLAS_DISPATCH(dtrsm) EIGEN_BLAS_DISPATCH(dtrsv) EIGEN_BLAS_DISPATCH(idamax)
+EIGEN_BLAS_DISPATCH(idamin)
+
+// complex_single.cpp
+EIGEN_BLAS_DISPATCH(caxpy) EIGEN_BLAS_DISPATCH(ccopy) EIGEN_BLAS_DISPATCH(cdotcw) EIGEN_BLAS_DISPATCH(cdotuw) EIGEN_BLAS_DISPATCH(cgbmv) EIGEN_BLAS_DISPATCH(cgemm)
+EIGEN_BLAS_DISPATCH(cgemv) EIGEN_BLAS_DISPATCH(cgerc) EIGEN_BLAS_DISPATCH(cgeru) EIGEN_BLAS_DISPATCH(chemm) EIGEN_BLAS_DISPATCH(chemv) EIGEN_BLAS_DISPATCH(cher)
+EIGEN_BLAS_DISPATCH(cher2) EIGEN_BLAS_DISPATCH(cher2k) EIGEN_BLAS_DISPATCH(cherk) EIGEN_BLAS_DISPATCH(chpr) EIGEN_BLAS_DISPATCH(chpr2) EIGEN_BLAS_DISPATCH(crotg)
+EIGEN_BLAS_DISPATCH(cscal) EIGEN_BLAS_DISPATCH(csrot) EIGEN_BLAS_DISPATCH(csscal) EIGEN_BLAS_DISPATCH(cswap) EIGEN_BLAS_DISPATCH(csymm) EIGEN_BLAS_DISPATCH(csyr2k)
+EIGEN_BLAS_DISPATCH(csyrk) EIGEN_BLAS_DISPATCH(ctbsv) EIGEN_BLAS_DISPATCH(ctpmv) EIGEN_BLAS_DISPATCH(ctpsv) EIGEN_BLAS_DISPATCH(ctrmm) EIGEN_BLAS_DISPATCH(ctrmv)
+EIGEN_BLAS_DISPATCH(ctrsm) EIGEN_BLAS_DISPATCH(ctrsv) EIGEN_BLAS_DISPATCH(icamax) EIGEN_BLAS_DISPATCH(icamin) EIGEN_BLAS_DISPATCH(scasum) EIGEN_BLAS_DISPATCH(scnrm2)
+
+// complex_double.cpp
+EIGEN_BLAS_DISPATCH(dzasum) EIGEN_BLAS_DISPATCH(dznrm2) EIGEN_BLAS_DISPATCH(izamax) EIGEN_BLAS_DISPATCH(izamin) EIGEN_BLAS_DISPATCH(zaxpy) EIGEN_BLAS_DISPATCH(zcopy)
+EIGEN_BLAS_DISPATCH(zdotcw) EIGEN_BLAS_DISPATCH(zdotuw) EIGEN_BLAS_DISPATCH(zdrot) EIGEN_BLAS_DISPATCH(zdscal) EIGEN_BLAS_DISPATCH(zgbmv) EIGEN_BLAS_DISPATCH(zgemm)
+EIGEN_BLAS_DISPATCH(zgemv) EIGEN_BLAS_DISPATCH(zgerc) EIGEN_BLAS_DISPATCH(zgeru) EIGEN_BLAS_DISPATCH(zhemm) EIGEN_BLAS_DISPATCH(zhemv) EIGEN_BLAS_DISPATCH(zher)
+EIGEN_BLAS_DISPATCH(zher2) EIGEN_BLAS_DISPATCH(zher2k) EIGEN_BLAS_DISPATCH(zherk) EIGEN_BLAS_DISPATCH(zhpr) EIGEN_BLAS_DISPATCH(zhpr2) EIGEN_BLAS_DISPATCH(zrotg)
+EIGEN_BLAS_DISPATCH(zscal) EIGEN_BLAS_DISPATCH(zswap) EIGEN_BLAS_DISPATCH(zsymm) EIGEN_BLAS_DISPATCH(zsyr2k) EIGEN_BLAS_DISPATCH(zsyrk) EIGEN_BLAS_DISPATCH(ztbsv)
+EIGEN_BLAS_DISPATCH(ztpmv) EIGEN_BLAS_DISPATCH(ztpsv) EIGEN_BLAS_DISPATCH(ztrmm) EIGEN_BLAS_DISPATCH(ztrmv) EIGEN_BLAS_DISPATCH(ztrsm) EIGEN_BLAS_DISPATCH(ztrsv)
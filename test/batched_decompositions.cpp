@@ -0,0 +1,131 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <Eigen/LU>
+#include <Eigen/Cholesky>
+
+// Copies the b-th problem of a batch, stored as rows x cols column-major matrices, to a plain matrix.
+template<typename BatchType>
+Matrix<typename BatchType::Scalar,Dynamic,Dynamic> batched_get(const BatchType& batch, Index b, Index rows)
+{
+  Matrix<typename BatchType::Scalar,Dynamic,Dynamic> m = batch.row(b).transpose();
+  m.resize(rows, batch.cols() / rows);
+  return m;
+}
+
+template<typename BatchType, typename MatrixType>
+void batched_set(BatchType& batch, Index b, const MatrixType& m)
+{
+  batch.row(b) = Map<const Matrix<typename BatchType::Scalar,1,Dynamic> >(m.data(), m.size());
+}
+
+template<typename MatrixType>
+void batched_llt(Index size, Index batchSize)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseType;
+  typedef typename BatchedLLT<MatrixType>::BatchType BatchType;
+  const Index rhsCols = internal::random<Index>(1, 4);
+
+  BatchType batch(batchSize, size*size), rhs = BatchType::Random(batchSize, size*rhsCols);
+  for(Index b = 0; b < batchSize; ++b)
+  {
+    DenseType a = DenseType::Random(size, size);
+    DenseType spd = a * a.transpose() + DenseType::Identity(size, size) * Scalar(size);
+    // garbage in the strict upper part must not be read
+    spd.template triangularView<StrictlyUpper>().setConstant(Scalar(-1234));
+    batched_set(batch, b, spd);
+  }
+
+  BatchedLLT<MatrixType> llt(batch);
+  VERIFY_IS_EQUAL(llt.batchSize(), batchSize);
+  VERIFY_IS_EQUAL(llt.size(), size);
+  VERIFY_IS_EQUAL(llt.info(), Success);
+
+  BatchType x = llt.solve(rhs), inv = llt.inverse();
+  for(Index b = 0; b < batchSize; ++b)
+  {
+    DenseType a = batched_get(batch, b, size).template selfadjointView<Lower>();
+    LLT<DenseType> ref(a);
+    VERIFY_IS_EQUAL(llt.info(b), Success);
+    DenseType L = batched_get(llt.matrixLLT(), b, size).template triangularView<Lower>();
+    VERIFY_IS_APPROX(L, DenseType(ref.matrixL()));
+    VERIFY_IS_APPROX(a * batched_get(x, b, size), batched_get(rhs, b, size));
+    VERIFY_IS_APPROX(batched_get(inv, b, size), ref.solve(DenseType::Identity(size, size)));
+  }
+
+  // a matrix that is not positive definite only flags its own problem
+  Index bad = internal::random<Index>(0, batchSize-1);
+  DenseType a = batched_get(batch, bad, size);
+  a(size-1, size-1) = -a(size-1, size-1);
+  batched_set(batch, bad, a);
+  BatchedLLT<MatrixType> llt2;
+  llt2.compute(batch);
+  VERIFY_IS_EQUAL(llt2.info(), NumericalIssue);
+  for(Index b = 0; b < batchSize; ++b)
+  {
+    VERIFY_IS_EQUAL(llt2.info(b), b == bad ? NumericalIssue : Success);
+    if(b != bad)
+      VERIFY_IS_EQUAL(llt2.matrixLLT().row(b), llt.matrixLLT().row(b));
+  }
+}
+
+template<typename MatrixType>
+void batched_partial_lu(Index size, Index batchSize)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseType;
+  typedef typename BatchedPartialPivLU<MatrixType>::BatchType BatchType;
+  const Index rhsCols = internal::random<Index>(1, 4);
+
+  BatchType batch = BatchType::Random(batchSize, size*size), rhs = BatchType::Random(batchSize, size*rhsCols);
+  // a problem with zero columns to be skipped during the factorization
+  if(size > 1)
+    batch.row(0).head(size).setZero();
+
+  BatchedPartialPivLU<MatrixType> lu(batch);
+  VERIFY_IS_EQUAL(lu.batchSize(), batchSize);
+  VERIFY_IS_EQUAL(lu.size(), size);
+
+  BatchType x = lu.solve(rhs), inv = lu.inverse();
+  for(Index b = 0; b < batchSize; ++b)
+  {
+    DenseType a = batched_get(batch, b, size);
+    PartialPivLU<DenseType> ref(a);
+    // same pivoting strategy as PartialPivLU
+    VERIFY_IS_APPROX(batched_get(lu.matrixLU(), b, size), ref.matrixLU());
+    Transpositions<Dynamic> tr(size);
+    for(Index k = 0; k < size; ++k)
+      tr.coeffRef(k) = int(lu.pivots()(b,k));
+    VERIFY_IS_EQUAL(PermutationMatrix<Dynamic>(tr).indices(), ref.permutationP().indices());
+    if(b == 0 && size > 1)
+      continue;
+    // random matrices may be ill-conditioned: check the backward error
+    DenseType xb = batched_get(x, b, size);
+    VERIFY((a * xb - batched_get(rhs, b, size)).norm() <= test_precision<Scalar>() * a.norm() * xb.norm());
+    VERIFY_IS_APPROX(batched_get(inv, b, size), ref.inverse());
+  }
+}
+
+EIGEN_DECLARE_TEST(batched_decompositions)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    // batch sizes that are not multiples of the packet size, and larger than a task
+    Index batchSize = internal::random<Index>(1, 50);
+    if(internal::random<bool>())
+      batchSize = internal::random<Index>(500, 1500);
+    CALL_SUBTEST_1(( batched_llt<Matrix<double,6,6> >(6, batchSize) ));
+    CALL_SUBTEST_1(( batched_partial_lu<Matrix<double,6,6> >(6, batchSize) ));
+    CALL_SUBTEST_2(( batched_llt<Matrix<float,8,8> >(8, batchSize) ));
+    CALL_SUBTEST_2(( batched_partial_lu<Matrix<float,8,8> >(8, batchSize) ));
+    CALL_SUBTEST_3(( batched_llt<MatrixXd>(internal::random<Index>(1, 32), batchSize) ));
+    CALL_SUBTEST_3(( batched_partial_lu<MatrixXd>(internal::random<Index>(1, 32), batchSize) ));
+    CALL_SUBTEST_4(( batched_llt<MatrixXf>(internal::random<Index>(1, 16), batchSize) ));
+    CALL_SUBTEST_4(( batched_partial_lu<MatrixXf>(internal::random<Index>(1, 16), batchSize) ));
+  }
+}
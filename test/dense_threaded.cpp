@@ -0,0 +1,136 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_GEMM_THREADPOOL
+#include "main.h"
+#include <Eigen/LU>
+#include <Eigen/Cholesky>
+#include <Eigen/SVD>
+#include <Eigen/QR>
+#include "threaded.h"
+
+// Tests the multi-threaded code paths of the dense decompositions when a thread pool is registered.
+
+template<typename MatrixType> void test_threaded_partial_lu(Index size)
+{
+  MatrixType A = MatrixType::Random(size, size);
+  MatrixType b = MatrixType::Random(size, 3);
+  // an exactly zero column leads to zero pivots in the look-ahead panels
+  A.col(internal::random<Index>(size/2, size-1)).setZero();
+
+  ScopedGemmThreadPool pool(internal::random<int>(1,4));
+  PartialPivLU<MatrixType> threaded(A);
+  VERIFY(pool.scheduled()>0);
+  VERIFY_IS_APPROX(threaded.reconstructedMatrix(), A);
+  VERIFY(threaded.matrixLU().template triangularView<StrictlyLower>().toDenseMatrix().cwiseAbs().maxCoeff() <= typename MatrixType::RealScalar(1));
+  VERIFY((threaded.matrixLU().diagonal().array()==typename MatrixType::Scalar(0)).any());
+
+  A.col(0).swap(A.col(size-1));
+  A.col(size-1).setRandom();
+  A.diagonal().array() += typename MatrixType::RealScalar(size);
+  threaded.compute(A);
+  VERIFY_IS_APPROX(A*threaded.solve(b), b);
+}
+
+template<typename MatrixType, int UpLo> void test_threaded_llt(Index size)
+{
+  typedef typename MatrixType::RealScalar RealScalar;
+  MatrixType X = MatrixType::Random(size, size);
+  MatrixType A = X * X.adjoint();
+  A.diagonal().array() += RealScalar(1);
+  MatrixType b = MatrixType::Random(size, 3);
+
+  LLT<MatrixType,UpLo> sequential(A);
+
+  ScopedGemmThreadPool pool(internal::random<int>(1,4));
+  LLT<MatrixType,UpLo> threaded(A);
+  VERIFY(pool.scheduled()>0);
+  VERIFY(threaded.info()==Success);
+  VERIFY_IS_APPROX(threaded.reconstructedMatrix(), A);
+  VERIFY_IS_APPROX(MatrixType(threaded.matrixL()), MatrixType(sequential.matrixL()));
+  VERIFY_IS_APPROX(A*threaded.solve(b), b);
+
+  // the failure is reported at the first non positive pivot
+  Index k = internal::random<Index>(0, size-1);
+  A(k,k) = -RealScalar(size);
+  threaded.compute(A);
+  VERIFY(threaded.info()==NumericalIssue);
+}
+
+template<typename MatrixType> void test_threaded_bdcsvd(Index rows, Index cols, unsigned int options)
+{
+  MatrixType A = MatrixType::Random(rows, cols);
+
+  BDCSVD<MatrixType> sequential(A, options);
+
+  ScopedGemmThreadPool pool(internal::random<int>(1,4));
+  BDCSVD<MatrixType> threaded(A, options);
+  VERIFY(pool.scheduled()>0);
+  VERIFY(threaded.info()==Success);
+  VERIFY_IS_APPROX(threaded.singularValues(), sequential.singularValues());
+  if((options & ComputeThinU) && (options & ComputeThinV))
+    VERIFY_IS_APPROX(threaded.matrixU() * threaded.singularValues().asDiagonal() * threaded.matrixV().adjoint(), A);
+  if(options & ComputeThinU)
+    VERIFY_IS_UNITARY(threaded.matrixU());
+  if(options & ComputeThinV)
+    VERIFY_IS_UNITARY(threaded.matrixV());
+}
+
+template<typename MatrixType> void test_threaded_tsqr(Index rows, Index cols)
+{
+  MatrixType A = MatrixType::Random(rows, cols);
+  MatrixType b = MatrixType::Random(rows, 2);
+
+  TallSkinnyQR<MatrixType> sequential(A);
+  MatrixType x = sequential.solve(b);
+
+  ScopedGemmThreadPool pool(internal::random<int>(1,4));
+  TallSkinnyQR<MatrixType> threaded(A);
+  VERIFY(pool.scheduled()>0);
+  // the chunking does not depend on the number of threads
+  VERIFY_IS_EQUAL(MatrixType(threaded.matrixR()), MatrixType(sequential.matrixR()));
+  VERIFY_IS_EQUAL(MatrixType(threaded.solve(b)), x);
+  VERIFY_IS_APPROX(MatrixType(threaded.householderQ().adjoint() * A).topRows(cols), MatrixType(threaded.matrixR()));
+}
+
+template<typename MatrixType> void test_threaded_batched(Index size, Index batchSize)
+{
+  typedef typename BatchedPartialPivLU<MatrixType>::BatchType BatchType;
+  BatchType batch = BatchType::Random(batchSize, size*size);
+  BatchType rhs = BatchType::Random(batchSize, size);
+
+  BatchedPartialPivLU<MatrixType> sequential(batch);
+  BatchType x = sequential.solve(rhs);
+
+  ScopedGemmThreadPool pool(internal::random<int>(1,4));
+  BatchedPartialPivLU<MatrixType> threaded(batch);
+  VERIFY(pool.scheduled()>0);
+  // each problem is factorized by the same instructions, whichever thread and lane it lands on
+  VERIFY_IS_EQUAL(threaded.matrixLU(), sequential.matrixLU());
+  VERIFY_IS_EQUAL(threaded.pivots(), sequential.pivots());
+  VERIFY_IS_EQUAL(threaded.solve(rhs), x);
+}
+
+EIGEN_DECLARE_TEST(dense_threaded)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( test_threaded_partial_lu<MatrixXd>(internal::random<int>(256,600)) ));
+    CALL_SUBTEST_2(( test_threaded_partial_lu<Matrix<float,Dynamic,Dynamic,RowMajor> >(internal::random<int>(256,400)) ));
+    CALL_SUBTEST_3(( test_threaded_partial_lu<MatrixXcd>(internal::random<int>(256,300)) ));
+    CALL_SUBTEST_4(( test_threaded_llt<MatrixXd,Lower>(internal::random<int>(512,900)) ));
+    CALL_SUBTEST_5(( test_threaded_llt<Matrix<float,Dynamic,Dynamic,RowMajor>,Upper>(internal::random<int>(512,700)) ));
+    CALL_SUBTEST_6(( test_threaded_llt<MatrixXcd,Upper>(internal::random<int>(512,600)) ));
+    CALL_SUBTEST_7(( test_threaded_bdcsvd<MatrixXd>(internal::random<int>(300,600), internal::random<int>(300,600), ComputeThinU|ComputeThinV) ));
+    CALL_SUBTEST_7(( test_threaded_bdcsvd<MatrixXd>(internal::random<int>(300,600), internal::random<int>(300,600), internal::random<bool>() ? ComputeThinU : ComputeThinV) ));
+    CALL_SUBTEST_8(( test_threaded_bdcsvd<MatrixXf>(internal::random<int>(300,500), internal::random<int>(300,500), 0) ));
+    CALL_SUBTEST_9(( test_threaded_bdcsvd<MatrixXcd>(internal::random<int>(300,400), internal::random<int>(300,400), ComputeThinU|ComputeThinV) ));
+    CALL_SUBTEST_10(( test_threaded_tsqr<MatrixXd>(internal::random<int>(2000,20000), internal::random<int>(1,16)) ));
+    CALL_SUBTEST_10(( test_threaded_tsqr<MatrixXcf>(internal::random<int>(2000,10000), internal::random<int>(1,8)) ));
+    CALL_SUBTEST_11(( test_threaded_batched<Matrix<double,8,8> >(8, internal::random<int>(2000,5000)) ));
+    CALL_SUBTEST_11(( test_threaded_batched<MatrixXf>(internal::random<int>(6,32), internal::random<int>(2000,5000)) ));
+  }
+}
@@ -242,6 +242,10 @@ EIGEN_DECLARE_TEST(eigensolver_generic)
   );
   
   CALL_SUBTEST_2( eigensolver_generic_extra<0>() );
+
+  // large enough for the multishift QR algorithm
+  s = internal::random<int>(EIGEN_TEST_MAX_SIZE/4,EIGEN_TEST_MAX_SIZE/2);
+  CALL_SUBTEST_6( eigensolver(MatrixXd(s,s)) );
   
   TEST_SET_BUT_UNUSED_VARIABLE(s)
 }
@@ -190,6 +190,78 @@ template<typename MatrixType> void selfadjointeigensolver(const MatrixType& m)
   }
 }
 
+template<typename MatrixType> void selfadjointeigensolver_divide_and_conquer(const MatrixType& m)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef Matrix<RealScalar,Dynamic,1> RealVectorType;
+  Index n = m.rows();
+
+  MatrixType a = MatrixType::Random(n,n);
+  MatrixType symmA = a.adjoint() * a;
+  symmA.template triangularView<StrictlyUpper>().setZero();
+
+  SelfAdjointEigenSolver<MatrixType> eiQR(symmA);
+  SelfAdjointEigenSolver<MatrixType> eiDC(symmA, ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiDC.info(), Success);
+  VERIFY_IS_APPROX(eiQR.eigenvalues(), eiDC.eigenvalues());
+  VERIFY_IS_APPROX(symmA.template selfadjointView<Lower>() * eiDC.eigenvectors(),
+                   eiDC.eigenvectors() * eiDC.eigenvalues().asDiagonal());
+  VERIFY_IS_UNITARY(eiDC.eigenvectors());
+
+  // heavy deflation: repeated and clustered eigenvalues
+  RealVectorType d = RealVectorType::Ones(n);
+  RealVectorType e = RealVectorType::Zero(n-1);
+  SelfAdjointEigenSolver<MatrixType> eiTridiag;
+  eiTridiag.computeFromTridiagonal(d, e, ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiTridiag.info(), Success);
+  VERIFY_IS_APPROX(eiTridiag.eigenvalues(), d);
+  VERIFY_IS_UNITARY(eiTridiag.eigenvectors());
+
+  // Wilkinson matrix, whose largest eigenvalues come in close pairs
+  for(Index i=0; i<n; ++i)
+    d(i) = numext::abs(RealScalar(i) - RealScalar(n-1)/RealScalar(2));
+  e.setOnes();
+  Matrix<RealScalar,Dynamic,Dynamic> T = d.asDiagonal();
+  T.template diagonal<1>() = e;
+  T.template diagonal<-1>() = e;
+  eiTridiag.computeFromTridiagonal(d, e, ComputeEigenvectors|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiTridiag.info(), Success);
+  VERIFY_IS_APPROX(T * eiTridiag.eigenvectors().real(), eiTridiag.eigenvectors().real() * eiTridiag.eigenvalues().asDiagonal());
+  VERIFY_IS_UNITARY(eiTridiag.eigenvectors());
+
+  // generalized problem
+  MatrixType b = MatrixType::Random(n,n);
+  MatrixType symmB = b.adjoint() * b + MatrixType::Identity(n,n);
+  GeneralizedSelfAdjointEigenSolver<MatrixType> eiGen(symmA, symmB, ComputeEigenvectors|Ax_lBx|DivideAndConquer);
+  VERIFY_IS_EQUAL(eiGen.info(), Success);
+  VERIFY((symmA.template selfadjointView<Lower>() * eiGen.eigenvectors()).isApprox(
+          symmB * (eiGen.eigenvectors() * eiGen.eigenvalues().asDiagonal()), 10*test_precision<RealScalar>()));
+
+  // k largest eigenpairs
+  Index k = internal::random<Index>(1,n);
+  SelfAdjointEigenSolver<MatrixType> eiLargest;
+  eiLargest.computeLargest(symmA, k);
+  VERIFY_IS_EQUAL(eiLargest.info(), Success);
+  VERIFY_IS_EQUAL(eiLargest.eigenvalues().size(), k);
+  VERIFY_IS_EQUAL(eiLargest.eigenvectors().cols(), k);
+  VERIFY_IS_APPROX(eiLargest.eigenvalues(), eiQR.eigenvalues().tail(k));
+  VERIFY_IS_APPROX(symmA.template selfadjointView<Lower>() * eiLargest.eigenvectors(),
+                   eiLargest.eigenvectors() * eiLargest.eigenvalues().asDiagonal());
+  VERIFY_IS_APPROX(eiLargest.eigenvectors().adjoint() * eiLargest.eigenvectors(), MatrixType::Identity(k,k));
+
+  eiLargest.computeLargest(symmA, k, EigenvaluesOnly);
+  VERIFY_IS_APPROX(eiLargest.eigenvalues(), eiQR.eigenvalues().tail(k));
+  VERIFY_RAISES_ASSERT(eiLargest.eigenvectors());
+
+  // multiple eigenvalues
+  MatrixType id = MatrixType::Identity(n,n);
+  eiLargest.computeLargest(id, k);
+  VERIFY_IS_EQUAL(eiLargest.info(), Success);
+  VERIFY_IS_APPROX(eiLargest.eigenvalues(), RealVectorType::Ones(k));
+  VERIFY_IS_APPROX(eiLargest.eigenvectors().adjoint() * eiLargest.eigenvectors(), MatrixType::Identity(k,k));
+}
+
 template<int>
 void bug_854()
 {
@@ -271,6 +343,21 @@ EIGEN_DECLARE_TEST(eigensolver_selfadjoint)
   CALL_SUBTEST_13( bug_1204<0>() );
   CALL_SUBTEST_13( bug_1225<0>() );
 
+  // sizes large enough for the blocked tridiagonalization
+  s = internal::random<int>(160,320);
+  CALL_SUBTEST_14( selfadjointeigensolver(MatrixXd(s,s)) );
+  CALL_SUBTEST_14( selfadjointeigensolver(Matrix<std::complex<double>,Dynamic,Dynamic,RowMajor>(s,s)) );
+
+  // divide-and-conquer and subset eigensolvers
+  for(int i = 0; i < g_repeat; i++) {
+    s = internal::random<int>(2,EIGEN_TEST_MAX_SIZE/2);
+    CALL_SUBTEST_15( selfadjointeigensolver_divide_and_conquer(MatrixXd(s,s)) );
+    CALL_SUBTEST_15( selfadjointeigensolver_divide_and_conquer(MatrixXcd(s,s)) );
+    CALL_SUBTEST_16( selfadjointeigensolver_divide_and_conquer(MatrixXf(s,s)) );
+  }
+  s = internal::random<int>(160,320);
+  CALL_SUBTEST_15( selfadjointeigensolver_divide_and_conquer(MatrixXd(s,s)) );
+
   // Test problem size constructors
   s = internal::random<int>(1,EIGEN_TEST_MAX_SIZE/4);
   CALL_SUBTEST_8(SelfAdjointEigenSolver<MatrixXf> tmp1(s));
@@ -335,6 +335,27 @@ void test_product()
   MatrixXf Bf = Bh.cast<float>();
   MatrixXf Cf = Ch.cast<float>();
   VERIFY_IS_APPROX(Ch.noalias()+=Ah*Bh, (Cf.noalias()+=Af*Bf).cast<half>());
+
+  // mixed storage orders, scaling and a destination with an inner stride
+  typedef Matrix<half,Dynamic,Dynamic,RowMajor> RowMatrixXh;
+  RowMatrixXh Rh = Bh.transpose();
+  MatrixXf Rf = Rh.cast<float>();
+  VERIFY_IS_APPROX(Ch.noalias()-=half(2)*(Ah*Rh.transpose()), (Cf.noalias()-=2.f*(Af*Rf.transpose())).cast<half>());
+  RowMatrixXh Dh(cols,rows);
+  MatrixXf Df(cols,rows);
+  VERIFY_IS_APPROX(Dh.noalias()=Rh*Ah.transpose(), (Df.noalias()=Rf*Af.transpose()).cast<half>());
+  MatrixXh Eh = MatrixXh::Zero(2*rows,cols);
+  Map<MatrixXh,0,Stride<Dynamic,2> > Es(Eh.data(), rows, cols, Stride<Dynamic,2>(2*rows,2));
+  Es.noalias() = Ah*Bh;
+  VERIFY_IS_APPROX(MatrixXh(Es), (Af*Bf).cast<half>());
+
+  // the accumulation has to be carried in float along a large depth
+  depth = internal::random<Index>(256,1024);
+  Ah = MatrixXh::Random(rows,depth);
+  Bh = MatrixXh::Random(depth,cols);
+  Af = Ah.cast<float>();
+  Bf = Bh.cast<float>();
+  VERIFY_IS_APPROX(Ah*Bh, (Af*Bf).cast<half>());
 }
 
 EIGEN_DECLARE_TEST(half_float)
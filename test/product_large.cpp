@@ -88,6 +88,54 @@ void product_large_regressions()
   }
 }
 
+// products of 8-bit matrices cast to int must be exact
+template<typename LhsScalar, typename RhsScalar, int LhsOrder, int RhsOrder>
+void product_int8()
+{
+  typedef Matrix<LhsScalar,Dynamic,Dynamic,LhsOrder> LhsMatrix;
+  typedef Matrix<RhsScalar,Dynamic,Dynamic,RhsOrder> RhsMatrix;
+  typedef Matrix<int,Dynamic,Dynamic,RowMajor> RowMatrixXi;
+  Index rows  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+  Index cols  = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+  Index depth = internal::random<Index>(1,EIGEN_TEST_MAX_SIZE);
+
+  LhsMatrix A = LhsMatrix::Random(rows,depth);
+  RhsMatrix B = RhsMatrix::Random(depth,cols);
+  // extreme values
+  A(internal::random<Index>(0,rows-1), internal::random<Index>(0,depth-1)) = NumTraits<LhsScalar>::lowest();
+  A(internal::random<Index>(0,rows-1), internal::random<Index>(0,depth-1)) = NumTraits<LhsScalar>::highest();
+  B(internal::random<Index>(0,depth-1), internal::random<Index>(0,cols-1)) = NumTraits<RhsScalar>::lowest();
+  B(internal::random<Index>(0,depth-1), internal::random<Index>(0,cols-1)) = NumTraits<RhsScalar>::highest();
+  MatrixXi Ai = A.template cast<int>();
+  MatrixXi Bi = B.template cast<int>();
+  MatrixXi ref = Ai * Bi;
+
+  MatrixXi C(rows,cols);
+  C.noalias() = A.template cast<int>() * B.template cast<int>();
+  VERIFY_IS_EQUAL(C, ref);
+  RowMatrixXi R(rows,cols);
+  R.noalias() = A.template cast<int>() * B.template cast<int>();
+  VERIFY_IS_EQUAL(MatrixXi(R), ref);
+
+  MatrixXi D = MatrixXi::Random(rows,cols), D0 = D;
+  D.noalias() += A.template cast<int>() * B.template cast<int>();
+  VERIFY_IS_EQUAL(D, D0 + ref);
+  D.noalias() -= 3 * (A.template cast<int>() * B.template cast<int>());
+  VERIFY_IS_EQUAL(D, D0 - 2 * ref);
+
+  // operands without direct access, and blocks
+  VERIFY_IS_EQUAL(MatrixXi(B.transpose().template cast<int>() * A.transpose().template cast<int>()), MatrixXi(ref.transpose()));
+  Index r0 = internal::random<Index>(0,rows-1), c0 = internal::random<Index>(0,cols-1);
+  C.setZero();
+  C.bottomRightCorner(rows-r0,cols-c0).noalias() = A.bottomRows(rows-r0).template cast<int>() * B.rightCols(cols-c0).template cast<int>();
+  VERIFY_IS_EQUAL(C.bottomRightCorner(rows-r0,cols-c0), ref.bottomRightCorner(rows-r0,cols-c0));
+  VERIFY_IS_EQUAL(MatrixXi((2*A).template cast<int>() * B.template cast<int>()), MatrixXi((2*A).template cast<int>() * Bi));
+
+  // vector products
+  VERIFY_IS_EQUAL(MatrixXi(A.template cast<int>() * B.col(0).template cast<int>()), MatrixXi(ref.col(0)));
+  VERIFY_IS_EQUAL(MatrixXi(A.row(0).template cast<int>() * B.template cast<int>()), MatrixXi(ref.row(0)));
+}
+
 template<int>
 void bug_1622() {
   typedef Matrix<double, 2, -1, 0, 2, -1> Mat2X;
@@ -117,6 +165,11 @@ EIGEN_DECLARE_TEST(product_large)
     CALL_SUBTEST_8( product(Matrix<double,Dynamic,Dynamic,RowMajor>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
     CALL_SUBTEST_9( product(Matrix<std::complex<float>,Dynamic,Dynamic,RowMajor>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
     CALL_SUBTEST_10( product(Matrix<std::complex<double>,Dynamic,Dynamic,RowMajor>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE), internal::random<int>(1,EIGEN_TEST_MAX_SIZE))) );
+
+    CALL_SUBTEST_11(( product_int8<signed char,signed char,ColMajor,ColMajor>() ));
+    CALL_SUBTEST_11(( product_int8<unsigned char,signed char,RowMajor,ColMajor>() ));
+    CALL_SUBTEST_11(( product_int8<signed char,unsigned char,ColMajor,RowMajor>() ));
+    CALL_SUBTEST_11(( product_int8<unsigned char,unsigned char,RowMajor,RowMajor>() ));
   }
 
   CALL_SUBTEST_6( product_large_regressions<0>() );
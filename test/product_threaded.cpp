@@ -0,0 +1,58 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_GEMM_THREADPOOL
+#include "main.h"
+#include "threaded.h"
+
+template<typename MatrixType>
+void test_parallelize_gemm(Index rows, Index depth, Index cols, int num_threads)
+{
+  MatrixType a = MatrixType::Random(rows, depth);
+  MatrixType b = MatrixType::Random(depth, cols);
+  MatrixType c(rows, cols), c_threaded(rows, cols);
+
+  VERIFY(getGemmThreadPool()==0);
+  VERIFY_IS_EQUAL(nbThreads(), 1);
+  c.noalias() = a * b;
+
+  {
+    ScopedGemmThreadPool pool(num_threads);
+    VERIFY(getGemmThreadPool()==&pool);
+    VERIFY_IS_EQUAL(nbThreads(), num_threads+1);
+    c_threaded.noalias() = a * b;
+    VERIFY_IS_APPROX(c, c_threaded);
+    VERIFY(pool.scheduled()>0);
+
+    // products issued from within the pool must not try to use it again
+    MatrixType c_nested(rows, cols);
+    Barrier done(1);
+    int scheduled = pool.scheduled();
+    pool.Schedule([&]() { c_nested.noalias() = a * b; done.Notify(); });
+    done.Wait();
+    VERIFY_IS_APPROX(c, c_nested);
+    VERIFY_IS_EQUAL(pool.scheduled(), scheduled+1);
+
+    // the number of threads can still be limited through setNbThreads
+    setNbThreads(2);
+    VERIFY_IS_EQUAL(nbThreads(), (std::min)(2, num_threads+1));
+    c_threaded.noalias() = a * b;
+    VERIFY_IS_APPROX(c, c_threaded);
+    setNbThreads(0);
+  }
+  VERIFY_IS_EQUAL(nbThreads(), 1);
+}
+
+EIGEN_DECLARE_TEST(product_threaded)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1(( test_parallelize_gemm<MatrixXf>(internal::random<int>(200,600), internal::random<int>(200,600), internal::random<int>(200,600), internal::random<int>(1,4)) ));
+    CALL_SUBTEST_2(( test_parallelize_gemm<MatrixXd>(internal::random<int>(200,600), internal::random<int>(1,600), internal::random<int>(200,600), internal::random<int>(1,4)) ));
+    CALL_SUBTEST_3(( test_parallelize_gemm<Matrix<float,Dynamic,Dynamic,RowMajor> >(internal::random<int>(200,600), internal::random<int>(200,600), internal::random<int>(200,600), internal::random<int>(1,4)) ));
+    CALL_SUBTEST_4(( test_parallelize_gemm<MatrixXcf>(internal::random<int>(100,300), internal::random<int>(100,300), internal::random<int>(100,300), internal::random<int>(1,4)) ));
+  }
+}
@@ -247,6 +247,36 @@ template<typename MatrixType> void qr_kahan_matrix()
   }
 }
 
+template<typename MatrixType> void qr_blocked()
+{
+  // large enough for several panels of the blocked factorization
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index rows = internal::random<Index>(100, 300);
+  Index cols = internal::random<Index>(70, 150);
+  Index rank = internal::random<Index>(40, (std::min)(rows, cols) - 1);
+
+  // graded columns make the downdated norms inaccurate, forcing panels to stop early
+  MatrixType m1;
+  createRandomPIMatrixOfRank(rank, rows, cols, m1);
+  for(Index j = 0; j < cols; ++j)
+    m1.col(j) *= std::pow(RealScalar(10), -RealScalar(internal::random<int>(0, 3)));
+
+  ColPivHouseholderQR<MatrixType> qr(m1);
+  VERIFY_IS_EQUAL(rank, qr.rank());
+  MatrixType r = qr.matrixQR().template triangularView<Upper>();
+  MatrixType c = qr.householderQ() * r * qr.colsPermutation().inverse();
+  VERIFY_IS_APPROX(m1, c);
+
+  // the diagonal of R is non-increasing
+  for(Index i = 0; i + 1 < rank; ++i)
+    VERIFY(numext::abs(r(i+1,i+1)) <= numext::abs(r(i,i)) * RealScalar(1.001));
+
+  CompleteOrthogonalDecomposition<MatrixType> cod(m1);
+  VERIFY_IS_EQUAL(rank, cod.rank());
+  MatrixType rhs = m1 * MatrixType::Random(cols, 2);
+  VERIFY_IS_APPROX(m1 * cod.solve(rhs), rhs);
+}
+
 template<typename MatrixType> void qr_invertible()
 {
   using std::log;
@@ -346,6 +376,13 @@ EIGEN_DECLARE_TEST(qr_colpivoting)
     CALL_SUBTEST_3( qr_invertible<MatrixXcd>() );
   }
 
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( qr_blocked<MatrixXf>() );
+    CALL_SUBTEST_2( qr_blocked<MatrixXd>() );
+    CALL_SUBTEST_3( qr_blocked<MatrixXcd>() );
+    CALL_SUBTEST_4(( qr_blocked<Matrix<double,Dynamic,Dynamic,RowMajor> >() ));
+  }
+
   CALL_SUBTEST_7(qr_verify_assert<Matrix3f>());
   CALL_SUBTEST_8(qr_verify_assert<Matrix3d>());
   CALL_SUBTEST_1(qr_verify_assert<MatrixXf>());
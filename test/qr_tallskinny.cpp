@@ -0,0 +1,71 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <Eigen/QR>
+
+template<typename MatrixType> void qr_tallskinny(Index rows, Index cols, Index chunkRows)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef Matrix<Scalar, Dynamic, Dynamic> DenseMatrix;
+
+  MatrixType a = MatrixType::Random(rows, cols);
+  TallSkinnyQR<MatrixType> tsqr;
+  tsqr.setChunkRows(chunkRows).compute(a);
+  VERIFY_IS_EQUAL(tsqr.rows(), rows);
+  VERIFY_IS_EQUAL(tsqr.cols(), cols);
+
+  // A = Q R, with a unitary Q
+  DenseMatrix r = DenseMatrix::Zero(rows, cols);
+  r.topRows(cols) = tsqr.matrixR();
+  DenseMatrix q = tsqr.householderQ() * DenseMatrix::Identity(rows, rows);
+  VERIFY_IS_UNITARY(q);
+  VERIFY_IS_APPROX(a, q * r);
+  VERIFY_IS_APPROX(DenseMatrix(tsqr.householderQ() * r), DenseMatrix(a));
+  VERIFY_IS_APPROX(DenseMatrix(tsqr.householderQ().adjoint() * a), r);
+
+  // R matches the one of HouseholderQR up to the signs of its rows
+  HouseholderQR<MatrixType> qr(a);
+  DenseMatrix r2 = qr.matrixQR().topRows(cols).template triangularView<Upper>();
+  VERIFY_IS_APPROX(r.topRows(cols).cwiseAbs(), r2.cwiseAbs());
+
+  // least squares
+  DenseMatrix b = DenseMatrix::Random(rows, 3);
+  DenseMatrix x = tsqr.solve(b);
+  VERIFY_IS_APPROX(x, qr.solve(b));
+  VERIFY_IS_APPROX((a.adjoint() * (a * x - b)).norm() + Scalar(1), Scalar(1));
+}
+
+template<typename MatrixType> void qr_tallskinny_verify_assert()
+{
+  MatrixType tmp;
+
+  TallSkinnyQR<MatrixType> tsqr;
+  VERIFY_RAISES_ASSERT(tsqr.matrixR())
+  VERIFY_RAISES_ASSERT(tsqr.solve(tmp))
+  VERIFY_RAISES_ASSERT(tsqr.householderQ())
+  VERIFY_RAISES_ASSERT(tsqr.compute(MatrixType::Random(3, 5)))
+}
+
+EIGEN_DECLARE_TEST(qr_tallskinny)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index cols = internal::random<Index>(1, 12);
+    Index rows = internal::random<Index>(cols, 40*cols);
+    Index chunk = internal::random<Index>(0, rows/3);
+    CALL_SUBTEST_1( qr_tallskinny<MatrixXf>(rows, cols, chunk) );
+    CALL_SUBTEST_2( qr_tallskinny<MatrixXd>(rows, cols, chunk) );
+    CALL_SUBTEST_3( qr_tallskinny<MatrixXcd>(rows, cols, chunk) );
+    CALL_SUBTEST_4(( qr_tallskinny<Matrix<double,Dynamic,Dynamic,RowMajor> >(rows, cols, chunk) ));
+    // a single chunk, and the default chunking
+    CALL_SUBTEST_2( qr_tallskinny<MatrixXd>(rows, cols, rows) );
+    CALL_SUBTEST_2( qr_tallskinny<MatrixXd>(internal::random<Index>(1000, 3000), internal::random<Index>(1, 8), 0) );
+  }
+
+  CALL_SUBTEST_1(qr_tallskinny_verify_assert<MatrixXf>());
+  CALL_SUBTEST_2(qr_tallskinny_verify_assert<MatrixXd>());
+}
@@ -0,0 +1,140 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "main.h"
+#include <Eigen/SVD>
+#include <Eigen/SparseCore>
+
+// Builds a rows x cols matrix whose i-th singular value is decay^i.
+template<typename MatrixType>
+MatrixType randomized_svd_test_matrix(Index rows, Index cols, typename MatrixType::RealScalar decay)
+{
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index diag = (std::min)(rows, cols);
+  MatrixType U = HouseholderQR<MatrixType>(MatrixType::Random(rows, diag)).householderQ() * MatrixType::Identity(rows, diag);
+  MatrixType V = HouseholderQR<MatrixType>(MatrixType::Random(cols, diag)).householderQ() * MatrixType::Identity(cols, diag);
+  Matrix<RealScalar,Dynamic,1> s(diag);
+  for(Index i = 0; i < diag; ++i)
+    s(i) = std::pow(decay, RealScalar(i));
+  return U * s.asDiagonal() * V.adjoint();
+}
+
+template<typename SVD, typename MatrixType>
+void randomized_svd_check(const SVD& svd, const MatrixType& A, Index k)
+{
+  typedef typename MatrixType::RealScalar RealScalar;
+  VERIFY_IS_EQUAL(svd.info(), Success);
+  VERIFY_IS_EQUAL(svd.targetRank(), k);
+  VERIFY_IS_EQUAL(svd.singularValues().size(), k);
+  VERIFY_IS_EQUAL(svd.matrixU().rows(), A.rows());
+  VERIFY_IS_EQUAL(svd.matrixU().cols(), k);
+  VERIFY_IS_EQUAL(svd.matrixV().rows(), A.cols());
+  VERIFY_IS_EQUAL(svd.matrixV().cols(), k);
+
+  BDCSVD<MatrixType> ref(A);
+  VERIFY_IS_APPROX(svd.singularValues(), ref.singularValues().head(k));
+  VERIFY(svd.matrixU().isUnitary());
+  VERIFY(svd.matrixV().isUnitary());
+
+  // The error of the rank-k approximation is driven by the first neglected singular value.
+  MatrixType approx = svd.matrixU() * svd.singularValues().asDiagonal() * svd.matrixV().adjoint();
+  RealScalar best = k < ref.singularValues().size() ? ref.singularValues()(k) : RealScalar(0);
+  VERIFY(BDCSVD<MatrixType>(A - approx).singularValues()(0) <= RealScalar(1.01) * best + test_precision<RealScalar>());
+}
+
+// A matrix-free operator applying A through its factors, as a user-defined operator would.
+template<typename MatrixType>
+struct LowRankOperator
+{
+  MatrixType L, R;
+  struct Adjoint
+  {
+    const LowRankOperator& op;
+    Adjoint(const LowRankOperator& o) : op(o) {}
+    MatrixType operator*(const MatrixType& x) const { return op.R * (op.L.adjoint() * x); }
+  };
+  Index rows() const { return L.rows(); }
+  Index cols() const { return R.rows(); }
+  MatrixType operator*(const MatrixType& x) const { return L * (R.adjoint() * x); }
+  Adjoint adjoint() const { return Adjoint(*this); }
+};
+
+template<typename MatrixType>
+void randomizedsvd(Index rows, Index cols)
+{
+  typedef typename MatrixType::Scalar Scalar;
+  typedef typename MatrixType::RealScalar RealScalar;
+  Index k = internal::random<Index>(1, (std::min)(rows, cols)/2);
+
+  // fast decay: the default parameters recover the leading singular values to full accuracy
+  MatrixType A = randomized_svd_test_matrix<MatrixType>(rows, cols, RealScalar(0.5));
+  RandomizedSVD<MatrixType> svd(A, k, ComputeThinU | ComputeThinV);
+  randomized_svd_check(svd, A, k);
+
+  // compute() and constructor agree
+  srand(g_seed);
+  RandomizedSVD<MatrixType> svd1(A, k, ComputeThinU | ComputeThinV);
+  srand(g_seed);
+  RandomizedSVD<MatrixType> svd2;
+  svd2.compute(A, k, ComputeThinU | ComputeThinV);
+  VERIFY_IS_EQUAL(svd1.singularValues(), svd2.singularValues());
+  VERIFY_IS_EQUAL(svd1.matrixU(), svd2.matrixU());
+
+  // Map and Ref inputs
+  Map<const MatrixType> mapA(A.data(), rows, cols);
+  randomized_svd_check(RandomizedSVD<MatrixType>(mapA, k, ComputeThinU | ComputeThinV), A, k);
+  Ref<const MatrixType> refA(A);
+  randomized_svd_check(RandomizedSVD<MatrixType>(refA, k, ComputeThinU | ComputeThinV), A, k);
+
+  // singular values only
+  RandomizedSVD<MatrixType> svdValues(A, k);
+  VERIFY_IS_APPROX(svdValues.singularValues(), svd.singularValues());
+  VERIFY_RAISES_ASSERT(svdValues.matrixU());
+  VERIFY_RAISES_ASSERT(svdValues.matrixV());
+
+  // requesting more triplets than available
+  RandomizedSVD<MatrixType> svdAll(A, rows+cols, ComputeThinU | ComputeThinV);
+  VERIFY_IS_EQUAL(svdAll.targetRank(), (std::min)(rows, cols));
+  VERIFY_IS_APPROX(svdAll.matrixU() * svdAll.singularValues().asDiagonal() * svdAll.matrixV().adjoint(), A);
+
+  // exactly low rank matrix given as an abstract operator, solve() is then exact on its range
+  LowRankOperator<MatrixType> op;
+  op.L = MatrixType::Random(rows, k);
+  op.R = MatrixType::Random(cols, k);
+  MatrixType lowRank = op.L * op.R.adjoint();
+  RandomizedSVD<MatrixType> svdOp(op, k, ComputeThinU | ComputeThinV);
+  randomized_svd_check(svdOp, lowRank, k);
+  VERIFY_IS_EQUAL(svdOp.rank(), k);
+  Matrix<Scalar,Dynamic,1> x = op.R * Matrix<Scalar,Dynamic,1>::Random(k);
+  Matrix<Scalar,Dynamic,1> b = lowRank * x;
+  VERIFY_IS_APPROX(lowRank * svdOp.solve(b), b);
+
+  // sparse matrix input
+  SparseMatrix<Scalar> S(rows, cols);
+  for(Index j = 0; j < cols; ++j)
+    for(Index i = 0; i < rows; ++i)
+      if(internal::random<int>(0,9) == 0)
+        S.insert(i,j) = internal::random<Scalar>();
+  MatrixType denseS = S;
+  RandomizedSVD<MatrixType> svdSparse;
+  svdSparse.setOversampling(cols).setPowerIterations(0);
+  svdSparse.compute(S, k, ComputeThinU | ComputeThinV);
+  randomized_svd_check(svdSparse, denseS, k);
+
+  VERIFY_RAISES_ASSERT(svd.compute(A, k, ComputeFullU));
+}
+
+EIGEN_DECLARE_TEST(randomizedsvd)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    Index r = internal::random<Index>(10, EIGEN_TEST_MAX_SIZE), c = internal::random<Index>(10, EIGEN_TEST_MAX_SIZE);
+    CALL_SUBTEST_1(( randomizedsvd<MatrixXd>(r, c) ));
+    CALL_SUBTEST_2(( randomizedsvd<MatrixXf>(internal::random<Index>(10, 100), internal::random<Index>(10, 100)) ));
+    CALL_SUBTEST_3(( randomizedsvd<MatrixXcd>(r, c) ));
+    CALL_SUBTEST_4(( randomizedsvd<Matrix<double,Dynamic,Dynamic,RowMajor> >(r, c) ));
+  }
+}
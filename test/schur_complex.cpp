@@ -86,6 +86,8 @@ EIGEN_DECLARE_TEST(schur_complex)
   CALL_SUBTEST_2(( schur<MatrixXcf>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE/4)) ));
   CALL_SUBTEST_3(( schur<Matrix<std::complex<float>, 1, 1> >() ));
   CALL_SUBTEST_4(( schur<Matrix<float, 3, 3, Eigen::RowMajor> >() ));
+  CALL_SUBTEST_6(( schur<MatrixXd>(internal::random<int>(1,EIGEN_TEST_MAX_SIZE/4)) ));
+  CALL_SUBTEST_6(( schur<MatrixXd>(internal::random<int>(EIGEN_TEST_MAX_SIZE/4,EIGEN_TEST_MAX_SIZE/2)) ));
 
   // Test problem size constructors
   CALL_SUBTEST_5(ComplexSchur<MatrixXf>(10));
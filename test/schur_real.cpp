@@ -105,6 +105,10 @@ EIGEN_DECLARE_TEST(schur_real)
   CALL_SUBTEST_3(( schur<Matrix<float, 1, 1> >() ));
   CALL_SUBTEST_4(( schur<Matrix<double, 3, 3, Eigen::RowMajor> >() ));
 
+  // large enough for the multishift QR algorithm
+  CALL_SUBTEST_6(( schur<MatrixXd>(internal::random<int>(EIGEN_TEST_MAX_SIZE/4,EIGEN_TEST_MAX_SIZE)) ));
+  CALL_SUBTEST_6(( schur<MatrixXf>(internal::random<int>(EIGEN_TEST_MAX_SIZE/4,EIGEN_TEST_MAX_SIZE/2)) ));
+
   // Test problem size constructors
   CALL_SUBTEST_5(RealSchur<MatrixXf>(10));
 }
@@ -21,6 +21,17 @@ static long g_dense_op_sparse_count = 0;
 
 #include "sparse.h"
 
+// orders triplets by outer index then inner index
+template<bool IsRowMajor> struct StorageOrderLess
+{
+  template<typename TripletType>
+  bool operator()(const TripletType& a, const TripletType& b) const
+  {
+    if(IsRowMajor) return a.row()<b.row() || (a.row()==b.row() && a.col()<b.col());
+    return a.col()<b.col() || (a.col()==b.col() && a.row()<b.row());
+  }
+};
+
 template<typename SparseMatrixType> void sparse_basic(const SparseMatrixType& ref)
 {
   typedef typename SparseMatrixType::StorageIndex StorageIndex;
@@ -417,6 +428,16 @@ template<typename SparseMatrixType> void sparse_basic(const SparseMatrixType& re
     m.setFromTriplets(triplets.begin(), triplets.end(), [] (Scalar,Scalar b) { return b; });
     VERIFY_IS_APPROX(m, refMat_last);
 #endif
+
+    // sort the triplets with respect to the storage order, duplicates keeping their relative order
+    std::vector<TripletType> sortedTriplets(triplets);
+    std::stable_sort(sortedTriplets.begin(), sortedTriplets.end(), StorageOrderLess<bool(SparseMatrixType::IsRowMajor)>());
+    m.setFromSortedTriplets(sortedTriplets.begin(), sortedTriplets.end());
+    VERIFY_IS_APPROX(m, refMat_sum);
+    VERIFY(m.isCompressed());
+
+    m.setFromSortedTriplets(sortedTriplets.begin(), sortedTriplets.end(), std::multiplies<Scalar>());
+    VERIFY_IS_APPROX(m, refMat_prod);
   }
   
   // test Map
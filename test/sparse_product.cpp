@@ -461,6 +461,49 @@ void test_mixing_types()
   VERIFY_IS_APPROX( dC2 = sC1 * dR1.col(0), dC3 = sC1 * dR1.template cast<Cplx>().col(0) );
 }
 
+template<typename SparseMatrixType, typename OtherSparseMatrixType>
+void symbolic_sparse_product()
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  const Index rows  = internal::random<Index>(1,100);
+  const Index cols  = internal::random<Index>(1,100);
+  const Index depth = internal::random<Index>(1,100);
+  double density = (std::max)(8./(rows*cols), 0.1);
+
+  DenseMatrix refLhs = DenseMatrix::Zero(rows, depth);
+  DenseMatrix refRhs = DenseMatrix::Zero(depth, cols);
+  SparseMatrixType lhs(rows, depth);
+  OtherSparseMatrixType rhs(depth, cols);
+  initSparse(density, refLhs, lhs);
+  initSparse(density, refRhs, rhs);
+  lhs.makeCompressed();
+  rhs.makeCompressed();
+
+  SymbolicSparseProduct<SparseMatrixType> product(lhs, rhs);
+  SparseMatrixType res, ref = lhs*rhs;
+  VERIFY_IS_EQUAL(product.rows(), rows);
+  VERIFY_IS_EQUAL(product.cols(), cols);
+  VERIFY_IS_EQUAL(product.nonZeros(), ref.nonZeros());
+  product.evaluate(lhs, rhs, res);
+  VERIFY(res.isCompressed());
+  VERIFY_IS_APPROX(res, refLhs*refRhs);
+  for(Index j=0; j<res.outerSize(); ++j)
+    for(Index p=res.outerIndexPtr()[j]+1; p<res.outerIndexPtr()[j+1]; ++p)
+      VERIFY(res.innerIndexPtr()[p-1] < res.innerIndexPtr()[p]);
+
+  // same patterns, new values
+  lhs.coeffs().setRandom();
+  rhs.coeffs().setRandom();
+  product.evaluate(lhs, rhs, res);
+  VERIFY_IS_APPROX(res, DenseMatrix(lhs)*DenseMatrix(rhs));
+
+  // expressions as operands
+  SymbolicSparseProduct<SparseMatrixType> productT(rhs.transpose(), lhs.transpose());
+  productT.evaluate(rhs.transpose(), lhs.transpose(), res);
+  VERIFY_IS_APPROX(res, DenseMatrix(rhs).transpose()*DenseMatrix(lhs).transpose());
+}
+
 EIGEN_DECLARE_TEST(sparse_product)
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -473,5 +516,11 @@ EIGEN_DECLARE_TEST(sparse_product)
     CALL_SUBTEST_4( (sparse_product_regression_test<SparseMatrix<double,RowMajor>, Matrix<double, Dynamic, Dynamic, RowMajor> >()) );
 
     CALL_SUBTEST_5( (test_mixing_types<float>()) );
+
+    CALL_SUBTEST_6( (symbolic_sparse_product<SparseMatrix<double,ColMajor>, SparseMatrix<double,ColMajor> >()) );
+    CALL_SUBTEST_6( (symbolic_sparse_product<SparseMatrix<double,ColMajor>, SparseMatrix<double,RowMajor> >()) );
+    CALL_SUBTEST_6( (symbolic_sparse_product<SparseMatrix<double,RowMajor>, SparseMatrix<double,RowMajor> >()) );
+    CALL_SUBTEST_6( (symbolic_sparse_product<SparseMatrix<double,RowMajor>, SparseMatrix<double,ColMajor> >()) );
+    CALL_SUBTEST_6( (symbolic_sparse_product<SparseMatrix<std::complex<float>,ColMajor,long int>, SparseMatrix<std::complex<float>,RowMajor,long int> >()) );
   }
 }
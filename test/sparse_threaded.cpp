@@ -0,0 +1,218 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#define EIGEN_GEMM_THREADPOOL
+#include "sparse.h"
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseLU>
+#include "threaded.h"
+
+// Tests the multi-threaded code paths of the sparse modules when a thread pool is registered.
+
+template<typename SparseMatrixType>
+SparseMatrixType threaded_laplacian_3d(int n)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  std::vector<Triplet<Scalar,StorageIndex> > triplets;
+  for(int i=0; i<n; ++i)
+    for(int j=0; j<n; ++j)
+      for(int k=0; k<n; ++k)
+      {
+        int r = (i*n+j)*n+k;
+        triplets.push_back(Triplet<Scalar,StorageIndex>(r,r,Scalar(6)));
+        if(i>0) triplets.push_back(Triplet<Scalar,StorageIndex>(r,r-n*n,Scalar(-1)));
+        if(i<n-1) triplets.push_back(Triplet<Scalar,StorageIndex>(r,r+n*n,Scalar(-1)));
+        if(j>0) triplets.push_back(Triplet<Scalar,StorageIndex>(r,r-n,Scalar(-1)));
+        if(j<n-1) triplets.push_back(Triplet<Scalar,StorageIndex>(r,r+n,Scalar(-1)));
+        if(k>0) triplets.push_back(Triplet<Scalar,StorageIndex>(r,r-1,Scalar(-1)));
+        if(k<n-1) triplets.push_back(Triplet<Scalar,StorageIndex>(r,r+1,Scalar(-1)));
+      }
+  SparseMatrixType A(n*n*n,n*n*n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+template<typename Scalar> void test_threaded_supernodal_llt()
+{
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  SparseMatrixType A = threaded_laplacian_3d<SparseMatrixType>(internal::random<int>(6,14));
+  DenseMatrix b = DenseMatrix::Random(A.rows(), 2);
+
+  SupernodalLLT<SparseMatrixType> sequential(A);
+  DenseMatrix x_sequential = sequential.solve(b);
+
+  ScopedGemmThreadPool pool(internal::random<int>(2,4));
+  SupernodalLLT<SparseMatrixType, Upper> threaded(A);
+  VERIFY(threaded.info()==Success);
+  VERIFY(pool.scheduled()>0);
+  VERIFY_IS_APPROX(A*threaded.solve(b), b);
+  VERIFY_IS_APPROX(threaded.solve(b), x_sequential);
+  threaded.factorize(A);
+  VERIFY_IS_APPROX(threaded.solve(b), x_sequential);
+}
+
+template<typename Scalar> void test_threaded_sparse_lu()
+{
+  typedef SparseMatrix<Scalar> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  SparseMatrixType A = threaded_laplacian_3d<SparseMatrixType>(internal::random<int>(8,14));
+  // make it unsymmetric
+  for(int k=0; k<A.outerSize(); ++k)
+    for(typename SparseMatrixType::InnerIterator it(A,k); it; ++it)
+      if(it.row()>it.col())
+        it.valueRef() *= Scalar(internal::random<double>(0.5,1.5));
+  DenseMatrix b = DenseMatrix::Random(A.rows(), 2);
+
+  SparseLU<SparseMatrixType> sequential(A);
+  VERIFY(sequential.info()==Success);
+  DenseMatrix x_sequential = sequential.solve(b);
+
+  ScopedGemmThreadPool pool(internal::random<int>(2,4));
+  SparseLU<SparseMatrixType> threaded;
+  threaded.analyzePattern(A);
+  threaded.factorize(A);
+  VERIFY(threaded.info()==Success);
+  VERIFY(pool.scheduled()>0);
+  VERIFY_IS_APPROX(A*threaded.solve(b), b);
+  VERIFY_IS_APPROX(threaded.solve(b), x_sequential);
+}
+
+template<typename SparseMatrixType> void test_threaded_set_from_triplets()
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  typedef Triplet<Scalar,StorageIndex> TripletType;
+  const Index rows = internal::random<Index>(1,2000);
+  const Index cols = internal::random<Index>(1,2000);
+  const Index ntriplets = internal::random<Index>(100000,300000);
+  std::vector<TripletType> triplets;
+  triplets.reserve(ntriplets);
+  for(Index k=0; k<ntriplets; ++k)
+  {
+    // favour duplicates to check that they are merged in input order
+    StorageIndex r = internal::random<StorageIndex>(0,StorageIndex((std::min)(rows-1,Index(300))));
+    StorageIndex c = internal::random<StorageIndex>(0,StorageIndex(cols-1));
+    triplets.push_back(TripletType(r,c,internal::random<Scalar>()));
+  }
+
+  SparseMatrixType sum_sequential(rows,cols), last_sequential(rows,cols);
+  sum_sequential.setFromTriplets(triplets.begin(), triplets.end());
+  last_sequential.setFromTriplets(triplets.begin(), triplets.end(), [] (const Scalar&, const Scalar& b) { return b; });
+
+  SparseMatrixType sum_threaded(rows,cols), last_threaded(rows,cols);
+  {
+    ScopedGemmThreadPool pool(internal::random<int>(2,4));
+    sum_threaded.setFromTriplets(triplets.begin(), triplets.end());
+    VERIFY(pool.scheduled()>0);
+    last_threaded.setFromTriplets(triplets.begin(), triplets.end(), [] (const Scalar&, const Scalar& b) { return b; });
+  }
+
+  VERIFY(sum_threaded.isCompressed());
+  VERIFY_IS_EQUAL(sum_threaded.nonZeros(), sum_sequential.nonZeros());
+  VERIFY((sum_threaded.coeffs() == sum_sequential.coeffs()).all());
+  VERIFY((Map<const Matrix<StorageIndex,Dynamic,1> >(sum_threaded.innerIndexPtr(), sum_threaded.nonZeros()))
+      == (Map<const Matrix<StorageIndex,Dynamic,1> >(sum_sequential.innerIndexPtr(), sum_sequential.nonZeros())));
+  VERIFY((Map<const Matrix<StorageIndex,Dynamic,1> >(sum_threaded.outerIndexPtr(), sum_threaded.outerSize()+1))
+      == (Map<const Matrix<StorageIndex,Dynamic,1> >(sum_sequential.outerIndexPtr(), sum_sequential.outerSize()+1)));
+  VERIFY((last_threaded.coeffs() == last_sequential.coeffs()).all());
+}
+
+template<typename SparseMatrixType> void test_threaded_symbolic_product()
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  // Galerkin product R*A*P of a 3D Laplacian with a piecewise constant prolongation
+  SparseMatrixType A = threaded_laplacian_3d<SparseMatrixType>(internal::random<int>(20,26));
+  const Index n = A.rows(), coarse = n/4;
+  SparseMatrixType P(n, coarse);
+  std::vector<Triplet<Scalar> > triplets;
+  for(Index i=0; i<n; ++i)
+  {
+    triplets.push_back(Triplet<Scalar>(int(i), int(i%coarse), Scalar(1)));
+    triplets.push_back(Triplet<Scalar>(int(i), int((i/4)%coarse), Scalar(0.5)));
+  }
+  P.setFromTriplets(triplets.begin(), triplets.end());
+  SparseMatrixType R = P.transpose();
+
+  ScopedGemmThreadPool pool(internal::random<int>(2,4));
+  SparseMatrixType AP, RAP;
+  SymbolicSparseProduct<SparseMatrixType> productAP(A, P);
+  productAP.evaluate(A, P, AP);
+  SymbolicSparseProduct<SparseMatrixType> productRAP(R, AP);
+  for(int step=0; step<2; ++step)
+  {
+    A.coeffs() *= Scalar(2);
+    productAP.evaluate(A, P, AP);
+    productRAP.evaluate(R, AP, RAP);
+    SparseMatrixType ref = R*(A*P);
+    VERIFY_IS_EQUAL(RAP.nonZeros(), ref.nonZeros());
+    VERIFY_IS_APPROX(RAP, ref);
+  }
+  VERIFY(pool.scheduled()>0);
+}
+
+template<typename Scalar, int Options> void test_threaded_sparse_dense_product()
+{
+  typedef SparseMatrix<Scalar,Options> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,Dynamic,RowMajor> RowDenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  SparseMatrixType A = threaded_laplacian_3d<SparseMatrixType>(internal::random<int>(16,22));
+  // unbalanced rows/columns, and an unsymmetric lower part
+  for(Index j=0; j<A.outerSize(); j+=7)
+    A.coeffRef(A.rows()-1-j%5, j) += Scalar(2);
+  A.makeCompressed();
+  SparseMatrixType L = A.template triangularView<Lower>();
+  DenseVector x = DenseVector::Random(A.cols());
+  DenseMatrix X = DenseMatrix::Random(A.cols(), 3);
+  RowDenseMatrix Xr = X;
+  Scalar alpha = internal::random<Scalar>();
+
+  DenseVector y = DenseVector::Random(A.rows()), yt = DenseVector::Random(A.cols()), ysa = DenseVector::Random(A.rows());
+  DenseMatrix Y = DenseMatrix::Random(A.rows(), 3), Yr = DenseMatrix::Random(A.rows(), 3);
+  DenseVector y_ref = y, yt_ref = yt, ysa_ref = ysa;
+  DenseMatrix Y_ref = Y, Yr_ref = Yr;
+  y_ref.noalias() += alpha * A * x;
+  yt_ref.noalias() += A.transpose() * x;
+  ysa_ref.noalias() += L.template selfadjointView<Lower>() * x;
+  Y_ref.noalias() += A * X;
+  Yr_ref.noalias() += A * Xr;
+
+  {
+    ScopedGemmThreadPool pool(internal::random<int>(2,4));
+    y.noalias() += alpha * A * x;
+    VERIFY(pool.scheduled()>0);
+    yt.noalias() += A.transpose() * x;
+    ysa.noalias() += L.template selfadjointView<Lower>() * x;
+    Y.noalias() += A * X;
+    Yr.noalias() += A * Xr;
+  }
+
+  VERIFY_IS_APPROX(y, y_ref);
+  VERIFY_IS_APPROX(yt, yt_ref);
+  VERIFY_IS_APPROX(ysa, ysa_ref);
+  VERIFY_IS_APPROX(Y, Y_ref);
+  VERIFY_IS_APPROX(Yr, Yr_ref);
+}
+
+EIGEN_DECLARE_TEST(sparse_threaded)
+{
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( test_threaded_supernodal_llt<double>() );
+    CALL_SUBTEST_2( test_threaded_supernodal_llt<std::complex<float> >() );
+    CALL_SUBTEST_3( test_threaded_sparse_lu<double>() );
+    CALL_SUBTEST_4( test_threaded_sparse_lu<std::complex<double> >() );
+    CALL_SUBTEST_5(( test_threaded_set_from_triplets<SparseMatrix<double> >() ));
+    CALL_SUBTEST_5(( test_threaded_set_from_triplets<SparseMatrix<float,RowMajor,long int> >() ));
+    CALL_SUBTEST_6(( test_threaded_symbolic_product<SparseMatrix<double> >() ));
+    CALL_SUBTEST_6(( test_threaded_symbolic_product<SparseMatrix<std::complex<double>,RowMajor> >() ));
+    CALL_SUBTEST_7(( test_threaded_sparse_dense_product<double,ColMajor>() ));
+    CALL_SUBTEST_7(( test_threaded_sparse_dense_product<double,RowMajor>() ));
+    CALL_SUBTEST_7(( test_threaded_sparse_dense_product<std::complex<float>,ColMajor>() ));
+  }
+}
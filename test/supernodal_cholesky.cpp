@@ -0,0 +1,96 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "sparse_solver.h"
+
+template<typename T, typename I_, int flag> void test_supernodal_cholesky_T()
+{
+  typedef SparseMatrix<T,flag,I_> SparseMatrixType;
+  SupernodalLLT<SparseMatrixType, Lower> llt_lower_amd;
+  SupernodalLLT<SparseMatrixType, Upper> llt_upper_amd;
+  SupernodalLLT<SparseMatrixType, Lower, NaturalOrdering<I_> > llt_lower_nat;
+  SupernodalLLT<SparseMatrixType, Upper, NaturalOrdering<I_> > llt_upper_nat;
+
+  check_sparse_spd_solving(llt_lower_amd);
+  check_sparse_spd_solving(llt_upper_amd);
+  check_sparse_spd_solving(llt_lower_nat, (std::min)(300,EIGEN_TEST_MAX_SIZE), 1000);
+  check_sparse_spd_solving(llt_upper_nat, (std::min)(300,EIGEN_TEST_MAX_SIZE), 1000);
+
+  check_sparse_spd_determinant(llt_lower_amd);
+  check_sparse_spd_determinant(llt_upper_amd);
+
+  SupernodalLLT<SparseMatrixType> empty;
+  VERIFY_IS_EQUAL(empty.rows(), 0);
+  VERIFY_IS_EQUAL(empty.cols(), 0);
+}
+
+// 5-point Laplacian on a n x n grid, whose factor has large supernodes
+template<typename SparseMatrixType>
+SparseMatrixType laplacian_2d(int n)
+{
+  typedef typename SparseMatrixType::Scalar Scalar;
+  typedef typename SparseMatrixType::StorageIndex StorageIndex;
+  std::vector<Triplet<Scalar,StorageIndex> > triplets;
+  for(int i=0; i<n; ++i)
+    for(int j=0; j<n; ++j)
+    {
+      int k = i*n+j;
+      triplets.push_back(Triplet<Scalar,StorageIndex>(k,k,Scalar(4)));
+      if(i>0)   triplets.push_back(Triplet<Scalar,StorageIndex>(k,k-n,Scalar(-1)));
+      if(i<n-1) triplets.push_back(Triplet<Scalar,StorageIndex>(k,k+n,Scalar(-1)));
+      if(j>0)   triplets.push_back(Triplet<Scalar,StorageIndex>(k,k-1,Scalar(-1)));
+      if(j<n-1) triplets.push_back(Triplet<Scalar,StorageIndex>(k,k+1,Scalar(-1)));
+    }
+  SparseMatrixType A(n*n,n*n);
+  A.setFromTriplets(triplets.begin(), triplets.end());
+  return A;
+}
+
+template<typename T> void test_supernodal_cholesky_structure()
+{
+  typedef SparseMatrix<T> SparseMatrixType;
+  typedef Matrix<T,Dynamic,Dynamic> DenseMatrix;
+  int n = internal::random<int>(10,40);
+  SparseMatrixType A = laplacian_2d<SparseMatrixType>(n);
+
+  SupernodalLLT<SparseMatrixType> llt(A);
+  SimplicialLLT<SparseMatrixType> ref(A);
+  VERIFY(llt.info()==Success);
+  VERIFY(llt.supernodes() < A.cols());
+
+  // same ordering, hence the same factor
+  VERIFY(llt.permutationP().indices()==ref.permutationP().indices());
+  SparseMatrixType L = llt.matrixL();
+  SparseMatrixType refL = ref.matrixL();
+  VERIFY_IS_EQUAL(L.nonZeros(), refL.nonZeros());
+  VERIFY_IS_APPROX(DenseMatrix(L), DenseMatrix(refL));
+  SparseMatrixType PAPt;
+  PAPt = A.twistedBy(llt.permutationP());
+  VERIFY_IS_APPROX(DenseMatrix(L*L.adjoint()), DenseMatrix(PAPt));
+
+  DenseMatrix b = DenseMatrix::Random(A.rows(), 3);
+  DenseMatrix x = llt.solve(b);
+  VERIFY_IS_APPROX(A*x, b);
+
+  // not positive definite
+  A.coeffRef(n/2,n/2) = T(-1);
+  llt.factorize(A);
+  VERIFY(llt.info()==NumericalIssue);
+}
+
+EIGEN_DECLARE_TEST(supernodal_cholesky)
+{
+  CALL_SUBTEST_1(( test_supernodal_cholesky_T<double,               int, ColMajor>() ));
+  CALL_SUBTEST_2(( test_supernodal_cholesky_T<std::complex<double>, int, ColMajor>() ));
+  CALL_SUBTEST_3(( test_supernodal_cholesky_T<double,          long int, ColMajor>() ));
+  CALL_SUBTEST_4(( test_supernodal_cholesky_T<double,               int, RowMajor>() ));
+  CALL_SUBTEST_5(( test_supernodal_cholesky_T<float,                int, ColMajor>() ));
+  for(int i = 0; i < g_repeat; i++) {
+    CALL_SUBTEST_1( test_supernodal_cholesky_structure<double>() );
+    CALL_SUBTEST_2( test_supernodal_cholesky_structure<std::complex<double> >() );
+  }
+}
@@ -0,0 +1,37 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef TEST_THREADED_H
+#define TEST_THREADED_H
+
+// Helpers of the tests of the multi-threaded code paths, which must define EIGEN_GEMM_THREADPOOL before including main.h.
+
+#include <unsupported/Eigen/CXX11/ThreadPool>
+
+// Forwards to a ThreadPool while recording the number of scheduled tasks.
+class CountingThreadPool : public ThreadPoolInterface
+{
+ public:
+  explicit CountingThreadPool(int num_threads) : m_pool(num_threads), m_scheduled(0) {}
+  void Schedule(std::function<void()> fn) { ++m_scheduled; m_pool.Schedule(fn); }
+  int NumThreads() const { return m_pool.NumThreads(); }
+  int CurrentThreadId() const { return m_pool.CurrentThreadId(); }
+  int scheduled() const { return m_scheduled; }
+ private:
+  ThreadPool m_pool;
+  std::atomic<int> m_scheduled;
+};
+
+// A CountingThreadPool registered through setGemmThreadPool for the lifetime of the object.
+class ScopedGemmThreadPool : public CountingThreadPool
+{
+ public:
+  explicit ScopedGemmThreadPool(int num_threads) : CountingThreadPool(num_threads) { setGemmThreadPool(this); }
+  ~ScopedGemmThreadPool() { setGemmThreadPool(0); }
+};
+
+#endif // TEST_THREADED_H
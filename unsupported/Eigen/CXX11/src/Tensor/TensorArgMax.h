@@ -126,6 +126,8 @@ struct TensorEvaluator<const TensorIndexTupleOp<ArgType>, Device>
 
   EIGEN_DEVICE_FUNC EvaluatorPointerType data() const { return NULL; }
 
+  EIGEN_DEVICE_FUNC const TensorEvaluator<ArgType, Device>& impl() const { return m_impl; }
+
 #ifdef EIGEN_USE_SYCL
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void bind(cl::sycl::handler &cgh) const {
     m_impl.bind(cgh);
@@ -170,6 +172,60 @@ struct nested<TensorTupleReducerOp<ReduceOp, Dims, XprType>, 1,
   typedef TensorTupleReducerOp<ReduceOp, Dims, XprType> type;
 };
 
+// Packet comparison of the tuple reducers: returns the mask of the lanes of
+// value that replace the ones of accum. Equal values are left to the scalar
+// reducer, which breaks the ties on the index.
+template <typename ReduceOp>
+struct ArgReducerPacketOp {
+  static const bool Supported = false;
+};
+
+template <typename T>
+struct ArgReducerPacketOp<ArgMaxTupleReducer<T> > {
+  static const bool Supported = true;
+  template <typename Packet>
+  static EIGEN_STRONG_INLINE Packet replaces(const Packet& value, const Packet& accum) {
+    return pcmp_lt(accum, value);
+  }
+};
+
+template <typename T>
+struct ArgReducerPacketOp<ArgMinTupleReducer<T> > {
+  static const bool Supported = true;
+  template <typename Packet>
+  static EIGEN_STRONG_INLINE Packet replaces(const Packet& value, const Packet& accum) {
+    return pcmp_lt(value, accum);
+  }
+};
+
+// Runs the vectorized reduction of the innermost dimensions on the host
+// devices. Other devices use the generic tuple reduction.
+template <typename Device>
+struct ArgReducerLauncher {
+  static const bool Supported = false;
+};
+
+template <>
+struct ArgReducerLauncher<DefaultDevice> {
+  static const bool Supported = true;
+  template <typename Function>
+  void operator()(const DefaultDevice&, Index n, const TensorOpCost&, Function f) const {
+    f(0, n);
+  }
+};
+
+#ifdef EIGEN_USE_THREADS
+// Specialization for multi-threaded execution.
+template <>
+struct ArgReducerLauncher<ThreadPoolDevice> {
+  static const bool Supported = true;
+  template <typename Function>
+  void operator()(const ThreadPoolDevice& device, Index n, const TensorOpCost& cost, Function f) const {
+    device.parallelFor(n, cost, f);
+  }
+};
+#endif  // EIGEN_USE_THREADS
+
 }  // end namespace internal
 
 template<typename ReduceOp, typename Dims, typename XprType>
@@ -225,6 +281,18 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
   typedef StorageMemory<CoeffReturnType, Device> Storage;
   typedef typename Storage::Type EvaluatorPointerType;
   typedef StorageMemory<TupleType, Device> TupleStorageMem;
+  typedef typename internal::remove_const<typename ArgType::Scalar>::type InputScalar;
+  typedef typename internal::packet_traits<InputScalar>::type InputPacket;
+
+  // Arg reductions of the innermost dimensions of a float or double input are
+  // vectorized on the host devices. The index lanes count the packets of a
+  // chunk in the input scalar type, which represents them exactly.
+  static const bool VectorizedReduction =
+      internal::ArgReducerLauncher<Device>::Supported &&
+      internal::ArgReducerPacketOp<ReduceOp>::Supported &&
+      TensorEvaluator<ArgType, Device>::PacketAccess &&
+      internal::packet_traits<InputScalar>::HasCmp &&
+      (internal::is_same<InputScalar, float>::value || internal::is_same<InputScalar, double>::value);
 
   enum {
     IsAligned         = /*TensorEvaluator<ArgType, Device>::IsAligned*/ false,
@@ -243,7 +311,10 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
   EIGEN_STRONG_INLINE TensorEvaluator(const XprType& op, const Device& device)
       : m_orig_impl(op.expression(), device),
         m_impl(op.expression().index_tuples().reduce(op.reduce_dims(), op.reduce_op()), device),
-        m_return_dim(op.return_dim())
+        m_return_dim(op.return_dim()),
+        m_reducer(op.reduce_op()),
+        m_result(NULL),
+        m_device(device)
   {
     gen_strides(m_orig_impl.dimensions(), m_strides);
     if (Layout == static_cast<int>(ColMajor)) {
@@ -257,6 +328,19 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
     m_stride_div = ((m_return_dim >= 0) &&
                     (m_return_dim < static_cast<Index>(m_strides.size())))
                    ? m_strides[m_return_dim] : 1;
+
+    // The reduction is over contiguous runs of the input when the reduced
+    // dimensions are the innermost ones.
+    const int num_reduced = internal::array_size<Dims>::value;
+    bool inner_most = true;
+    m_reduced_size = 1;
+    for (int i = 0; i < num_reduced; ++i) {
+      const Index dim = op.reduce_dims()[i];
+      inner_most &= (Layout == static_cast<int>(ColMajor)) ? dim < num_reduced : dim >= NumDims - num_reduced;
+      m_reduced_size *= m_orig_impl.dimensions()[dim];
+    }
+    m_vectorized = VectorizedReduction && inner_most &&
+                   m_reduced_size >= kUnroll * internal::unpacket_traits<InputPacket>::size;
   }
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE const Dimensions& dimensions() const {
@@ -264,14 +348,28 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
   }
 
   EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(EvaluatorPointerType /*data*/) {
+    if (m_vectorized) {
+      m_orig_impl.evalSubExprsIfNeeded(NULL);
+      evalVectorized(internal::bool_constant<VectorizedReduction>());
+      return true;
+    }
     m_impl.evalSubExprsIfNeeded(NULL);
     return true;
   }
   EIGEN_STRONG_INLINE void cleanup() {
+    if (m_vectorized) {
+      m_device.deallocate(m_result);
+      m_result = NULL;
+      m_orig_impl.cleanup();
+      return;
+    }
     m_impl.cleanup();
   }
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE CoeffReturnType coeff(Index index) const {
+    if (m_result) {
+      return m_result[index];
+    }
     const TupleType v = m_impl.coeff(index);
     return (m_return_dim < 0) ? v.first : (v.first % m_stride_mod) / m_stride_div;
   }
@@ -293,6 +391,97 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
   }
 
  private:
+  static const int kUnroll = 4;
+
+  void evalVectorized(internal::false_type) {
+    eigen_assert(false && "vectorized arg reduction not supported for this device or type");
+  }
+
+  void evalVectorized(internal::true_type) {
+    const Index PacketSize = internal::unpacket_traits<InputPacket>::size;
+    const Index num_outputs = internal::array_prod(m_orig_impl.dimensions()) / m_reduced_size;
+    // Long runs are split in chunks, so that a single output is reduced by
+    // several threads.
+    const Index kChunkSize = 16384;
+    const Index num_chunks = divup(m_reduced_size, kChunkSize);
+    const Index chunk_size = kUnroll * PacketSize *
+        divup<Index>(divup(m_reduced_size, num_chunks), kUnroll * PacketSize);
+
+    TupleType* partials = static_cast<TupleType*>(m_device.allocate(sizeof(TupleType) * num_outputs * num_chunks));
+    m_result = static_cast<Index*>(m_device.allocate(sizeof(Index) * num_outputs));
+
+    internal::ArgReducerLauncher<Device> launcher;
+    const TensorOpCost chunk_cost =
+        (m_orig_impl.impl().costPerCoeff(true) + TensorOpCost(0, 0, 3.0 / PacketSize)) * static_cast<double>(chunk_size);
+    launcher(m_device, num_outputs * num_chunks, chunk_cost,
+             [this, partials, num_chunks, chunk_size](Index first, Index last) {
+               for (Index task = first; task < last; ++task) {
+                 const Index output = task / num_chunks;
+                 const Index begin = output * m_reduced_size + (task % num_chunks) * chunk_size;
+                 const Index end = numext::mini(begin + chunk_size, (output + 1) * m_reduced_size);
+                 partials[task] = reduceRange(begin, end);
+               }
+             });
+    launcher(m_device, num_outputs, TensorOpCost(0, sizeof(Index), num_chunks + 2 * TensorOpCost::DivCost<Index>()),
+             [this, partials, num_chunks](Index first, Index last) {
+               for (Index output = first; output < last; ++output) {
+                 TupleType accum = m_reducer.initialize();
+                 for (Index chunk = 0; chunk < num_chunks; ++chunk) {
+                   m_reducer.reduce(partials[output * num_chunks + chunk], &accum);
+                 }
+                 m_result[output] = (m_return_dim < 0) ? accum.first : (accum.first % m_stride_mod) / m_stride_div;
+               }
+             });
+    m_device.deallocate(partials);
+  }
+
+  // Reduces the coefficients [first, last) of the input, keeping the best
+  // value and the packet it was found in for each lane of kUnroll
+  // accumulators. The lanes are merged by the scalar reducer.
+  TupleType reduceRange(Index first, Index last) const {
+    typedef internal::ArgReducerPacketOp<ReduceOp> PacketOp;
+    const Index PacketSize = internal::unpacket_traits<InputPacket>::size;
+    const TensorEvaluator<ArgType, Device>& input = m_orig_impl.impl();
+    TupleType accum = m_reducer.initialize();
+
+    // Lanes that never beat the initial value keep the step -1.
+    InputPacket values[kUnroll];
+    InputPacket steps[kUnroll];
+    for (int k = 0; k < kUnroll; ++k) {
+      values[k] = internal::pset1<InputPacket>(accum.second);
+      steps[k] = internal::pset1<InputPacket>(InputScalar(-1));
+    }
+    const InputPacket one = internal::pset1<InputPacket>(InputScalar(1));
+    InputPacket step = internal::pset1<InputPacket>(InputScalar(0));
+    const Index vectorized_end = first + ((last - first) / (kUnroll * PacketSize)) * (kUnroll * PacketSize);
+    for (Index i = first; i < vectorized_end; i += kUnroll * PacketSize) {
+      for (int k = 0; k < kUnroll; ++k) {
+        const InputPacket value = input.template packet<Unaligned>(i + k * PacketSize);
+        const InputPacket mask = PacketOp::replaces(value, values[k]);
+        values[k] = internal::pselect(mask, value, values[k]);
+        steps[k] = internal::pselect(mask, step, steps[k]);
+      }
+      step = internal::padd(step, one);
+    }
+
+    EIGEN_ALIGN_MAX InputScalar lane_values[PacketSize];
+    EIGEN_ALIGN_MAX InputScalar lane_steps[PacketSize];
+    for (int k = 0; k < kUnroll; ++k) {
+      internal::pstore(lane_values, values[k]);
+      internal::pstore(lane_steps, steps[k]);
+      for (Index lane = 0; lane < PacketSize; ++lane) {
+        if (lane_steps[lane] >= InputScalar(0)) {
+          const Index index = first + (static_cast<Index>(lane_steps[lane]) * kUnroll + k) * PacketSize + lane;
+          m_reducer.reduce(TupleType(index, lane_values[lane]), &accum);
+        }
+      }
+    }
+    for (Index i = vectorized_end; i < last; ++i) {
+      m_reducer.reduce(TupleType(i, input.coeff(i)), &accum);
+    }
+    return accum;
+  }
+
   EIGEN_DEVICE_FUNC void gen_strides(const InputDimensions& dims, StrideDims& strides) {
     if (m_return_dim < 0) {
       return;  // Won't be using the strides.
@@ -322,6 +511,11 @@ struct TensorEvaluator<const TensorTupleReducerOp<ReduceOp, Dims, ArgType>, Devi
   StrideDims m_strides;
   Index m_stride_mod;
   Index m_stride_div;
+  ReduceOp m_reducer;
+  Index m_reduced_size;
+  bool m_vectorized;
+  Index* m_result;
+  const Device EIGEN_DEVICE_REF m_device;
 };
 
 } // end namespace Eigen
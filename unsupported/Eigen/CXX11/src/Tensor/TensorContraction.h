@@ -175,9 +175,11 @@ struct TensorContractionBlockMemAllocator {
 //   TensorContractionInputMapper, or some specialization of it based on the
 //   type of tensor expression (e.g. TensorImagePatchOp has optimized input
 //   mapper).
+//
+// - Enabled allows to restrict a partial specialization with enable_if.
 template <typename ResScalar, typename LhsScalar, typename RhsScalar,
     typename StorageIndex, typename OutputMapper, typename LhsMapper,
-    typename RhsMapper>
+    typename RhsMapper, typename Enabled = void>
 struct TensorContractionKernel {
   // True if `invoke()` supports `beta` in `C <- alpha * A * B + beta * C`
   // (otherwise beta should be always equal to 1).
@@ -273,6 +275,124 @@ struct TensorContractionKernel {
   const StorageIndex bn;
 };
 
+// Contraction of 8-bit integer tensors converted to int, e.g.
+// a.cast<int>().contract(b.cast<int>(), dims) with int8_t or uint8_t tensors:
+// the blocks are packed as pairs of 16-bit integers and multiplied with the
+// integer kernels of Eigen Core (see GeneralMatrixMatrixInt8.h). The result is
+// exactly the one of the int contraction.
+template <typename StorageIndex, typename OutputMapper,
+          typename LhsArg, typename RhsArg, typename Device,
+          typename left_nocontract_t, typename right_nocontract_t, typename contract_t,
+          int lhs_packet_size, int rhs_packet_size,
+          bool lhs_inner_dim_contiguous, bool rhs_inner_dim_contiguous,
+          bool lhs_inner_dim_reordered, bool rhs_inner_dim_reordered,
+          int LhsAlignment, int RhsAlignment, template <class> class MakePointer_>
+struct TensorContractionKernel<
+    int, int, int, StorageIndex, OutputMapper,
+    TensorContractionInputMapper<int, StorageIndex, Lhs,
+        TensorEvaluator<const TensorConversionOp<int, LhsArg>, Device>,
+        left_nocontract_t, contract_t, lhs_packet_size, lhs_inner_dim_contiguous,
+        lhs_inner_dim_reordered, LhsAlignment, MakePointer_>,
+    TensorContractionInputMapper<int, StorageIndex, Rhs,
+        TensorEvaluator<const TensorConversionOp<int, RhsArg>, Device>,
+        right_nocontract_t, contract_t, rhs_packet_size, rhs_inner_dim_contiguous,
+        rhs_inner_dim_reordered, RhsAlignment, MakePointer_>,
+    typename enable_if<
+        is_int8_gemm_scalar<typename remove_const<LhsArg>::type::Scalar>::value &&
+        is_int8_gemm_scalar<typename remove_const<RhsArg>::type::Scalar>::value>::type> {
+  enum { HasBeta = false };
+
+  typedef TensorContractionInputMapper<int, StorageIndex, Lhs,
+      TensorEvaluator<const TensorConversionOp<int, LhsArg>, Device>,
+      left_nocontract_t, contract_t, lhs_packet_size, lhs_inner_dim_contiguous,
+      lhs_inner_dim_reordered, LhsAlignment, MakePointer_> LhsMapper;
+  typedef TensorContractionInputMapper<int, StorageIndex, Rhs,
+      TensorEvaluator<const TensorConversionOp<int, RhsArg>, Device>,
+      right_nocontract_t, contract_t, rhs_packet_size, rhs_inner_dim_contiguous,
+      rhs_inner_dim_reordered, RhsAlignment, MakePointer_> RhsMapper;
+
+  EIGEN_DEVICE_FUNC
+  TensorContractionKernel(StorageIndex m_, StorageIndex k_, StorageIndex n_,
+                          StorageIndex bm_, StorageIndex bk_, StorageIndex bn_)
+      : m(m_), k(k_), n(n_), bm(bm_), bk(bk_), bn(bn_) {}
+
+  // Packed blocks hold pairs of 16-bit integers in int words.
+  typedef int* LhsBlock;
+  typedef int* RhsBlock;
+
+  typedef TensorContractionBlockMemAllocator<int, int> BlockMemAllocator;
+  typedef typename BlockMemAllocator::BlockMemHandle BlockMemHandle;
+
+  typedef int8_gemm_traits Traits;
+  typedef int8_gemm_pack_lhs<StorageIndex, typename LhsMapper::SubMapper> LhsPacker;
+  typedef int8_gemm_pack_rhs<StorageIndex, typename RhsMapper::SubMapper> RhsPacker;
+  typedef int8_gebp_kernel<StorageIndex, OutputMapper> GebpKernel;
+
+  template <typename Device_>
+  EIGEN_DEVICE_FUNC BlockMemHandle allocate(Device_& d, LhsBlock* lhs_block,
+                                            RhsBlock* rhs_block) {
+    return BlockMemAllocator::allocate(d, paddedRows(bm), paddedDepth(bk),
+                                       paddedCols(bn), lhs_block, rhs_block);
+  }
+
+  template <typename Device_>
+  EIGEN_DEVICE_FUNC BlockMemHandle allocateSlices(
+      Device_& d, const StorageIndex num_lhs, const StorageIndex num_rhs,
+      const StorageIndex num_slices, std::vector<LhsBlock>* lhs_blocks,
+      std::vector<RhsBlock>* rhs_blocks) {
+    return BlockMemAllocator::allocateSlices(
+        d, paddedRows(bm), paddedDepth(bk), paddedCols(bn), num_lhs, num_rhs,
+        num_slices, lhs_blocks, rhs_blocks);
+  }
+
+  template <typename Device_>
+  EIGEN_DEVICE_FUNC static void deallocate(Device_& d, BlockMemHandle handle) {
+    BlockMemAllocator::deallocate(d, handle);
+  }
+
+  EIGEN_DONT_INLINE void packLhs(
+      LhsBlock* lhsBlock, const typename LhsMapper::SubMapper& data_mapper,
+      const StorageIndex depth, const StorageIndex rows) {
+    LhsPacker()(*lhsBlock, data_mapper, depth, rows);
+  }
+
+  EIGEN_DONT_INLINE void packRhs(
+      RhsBlock* rhsBlock, const typename RhsMapper::SubMapper& data_mapper,
+      const StorageIndex depth, const StorageIndex cols) {
+    RhsPacker()(*rhsBlock, data_mapper, depth, cols);
+  }
+
+  EIGEN_DONT_INLINE void invoke(
+      const OutputMapper& output_mapper, const LhsBlock& lhsBlock,
+      const RhsBlock& rhsBlock, const StorageIndex rows,
+      const StorageIndex depth, const StorageIndex cols,
+      const int alpha, const int beta) {
+    eigen_assert(beta == 1);
+    EIGEN_UNUSED_VARIABLE(beta);
+    GebpKernel()(output_mapper, lhsBlock, rhsBlock, rows, depth, cols, alpha);
+  }
+
+ private:
+  // The packed panels are padded to full micro kernel sizes, and the depth to
+  // an even number of coefficients.
+  static StorageIndex paddedRows(StorageIndex rows) {
+    return divup<StorageIndex>(rows, Traits::mr) * Traits::mr;
+  }
+  static StorageIndex paddedCols(StorageIndex cols) {
+    return divup<StorageIndex>(cols, Traits::nr) * Traits::nr;
+  }
+  static StorageIndex paddedDepth(StorageIndex depth) {
+    return divup<StorageIndex>(depth, 2) * 2;
+  }
+
+  const StorageIndex m;
+  const StorageIndex k;
+  const StorageIndex n;
+  const StorageIndex bm;
+  const StorageIndex bk;
+  const StorageIndex bn;
+};
+
 }  // end namespace internal
 
 // Tensor contraction params that should enable to get from output matrix
@@ -0,0 +1,474 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_TENSOR_TENSOR_CONVOLUTION_THREAD_POOL_H
+#define EIGEN_CXX11_TENSOR_TENSOR_CONVOLUTION_THREAD_POOL_H
+
+// evaluator for thread pool device
+#ifdef EIGEN_USE_THREADS
+
+namespace Eigen {
+
+namespace internal {
+
+// Computes len consecutive coefficients of the result of a convolution:
+//   output[x] = sum_k weights[k] * input[x + offsets[k]]
+// where offsets[k] is the offset in the input of the k-th coefficient of the
+// kernel. The packet version keeps a block of output packets in registers
+// while looping over the kernel.
+template <typename Scalar, typename Index,
+          bool Vectorizable = packet_traits<Scalar>::Vectorizable>
+struct ConvolutionRunKernel {
+  static EIGEN_STRONG_INLINE void run(const Scalar* input, const Index* offsets,
+                                      const Scalar* weights, Index kernel_size,
+                                      Scalar* output, Index len) {
+    for (Index x = 0; x < len; ++x) {
+      Scalar accum = Scalar(0);
+      for (Index k = 0; k < kernel_size; ++k) {
+        accum += input[x + offsets[k]] * weights[k];
+      }
+      output[x] = accum;
+    }
+  }
+};
+
+template <typename Scalar, typename Index>
+struct ConvolutionRunKernel<Scalar, Index, true> {
+  typedef typename packet_traits<Scalar>::type Packet;
+  static const int PacketSize = packet_traits<Scalar>::size;
+
+  template <int NumPackets>
+  static EIGEN_STRONG_INLINE void packetBlock(const Scalar* input, const Index* offsets,
+                                              const Scalar* weights, Index kernel_size,
+                                              Scalar* output) {
+    Packet accum[NumPackets];
+    for (int p = 0; p < NumPackets; ++p) {
+      accum[p] = pset1<Packet>(Scalar(0));
+    }
+    for (Index k = 0; k < kernel_size; ++k) {
+      const Packet weight = pset1<Packet>(weights[k]);
+      const Scalar* in = input + offsets[k];
+      for (int p = 0; p < NumPackets; ++p) {
+        accum[p] = pmadd(ploadu<Packet>(in + p * PacketSize), weight, accum[p]);
+      }
+    }
+    for (int p = 0; p < NumPackets; ++p) {
+      pstoreu(output + p * PacketSize, accum[p]);
+    }
+  }
+
+  static EIGEN_STRONG_INLINE void run(const Scalar* input, const Index* offsets,
+                                      const Scalar* weights, Index kernel_size,
+                                      Scalar* output, Index len) {
+    Index x = 0;
+    for (; x + 4 * PacketSize <= len; x += 4 * PacketSize) {
+      packetBlock<4>(input + x, offsets, weights, kernel_size, output + x);
+    }
+    for (; x + PacketSize <= len; x += PacketSize) {
+      packetBlock<1>(input + x, offsets, weights, kernel_size, output + x);
+    }
+    ConvolutionRunKernel<Scalar, Index, false>::run(input + x, offsets, weights, kernel_size,
+                                                    output + x, len - x);
+  }
+};
+
+}  // end namespace internal
+
+// The convolution is materialized in evalSubExprsIfNeeded, after the input and
+// the kernel have been evaluated to contiguous buffers. The output is split
+// into runs of coefficients that are also contiguous in the input (the
+// dimensions up to and including the innermost convolved one), and the runs are
+// computed in parallel by a register blocked kernel. Large kernels are applied
+// in the Fourier domain instead, through the FFTs of the whole input and of the
+// zero padded kernel.
+template<typename Indices, typename InputArgType, typename KernelArgType>
+struct TensorEvaluator<const TensorConvolutionOp<Indices, InputArgType, KernelArgType>, ThreadPoolDevice>
+{
+  typedef ThreadPoolDevice Device;
+  typedef TensorConvolutionOp<Indices, InputArgType, KernelArgType> XprType;
+
+  static const int NumDims = internal::array_size<typename TensorEvaluator<InputArgType, Device>::Dimensions>::value;
+  static const int NumKernelDims = internal::array_size<Indices>::value;
+  typedef typename XprType::Index Index;
+  typedef DSizes<Index, NumDims> Dimensions;
+
+  typedef typename XprType::Scalar Scalar;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  typedef typename XprType::CoeffReturnType CoeffReturnType;
+  typedef typename PacketType<CoeffReturnType, Device>::type PacketReturnType;
+  static const int PacketSize = PacketType<CoeffReturnType, Device>::size;
+  typedef StorageMemory<Scalar, Device> Storage;
+  typedef typename Storage::Type EvaluatorPointerType;
+
+  enum {
+    IsAligned = true,
+    PacketAccess = (PacketType<CoeffReturnType, Device>::size > 1),
+    BlockAccess = false,
+    PreferBlockAccess = false,
+    Layout = TensorEvaluator<InputArgType, Device>::Layout,
+    CoordAccess = false,  // to be implemented
+    RawAccess = true
+  };
+
+  //===- Tensor block evaluation strategy (see TensorBlock.h) -------------===//
+  typedef internal::TensorBlockNotImplemented TensorBlock;
+  //===--------------------------------------------------------------------===//
+
+  // The FFT path is only available for the scalar types supported by TensorFFT.
+  static const bool FFTSupported = internal::is_same<RealScalar, float>::value ||
+                                   internal::is_same<RealScalar, double>::value;
+
+  TensorEvaluator(const XprType& op, const Device& device)
+      : m_inputImpl(op.inputExpression(), device), m_kernelImpl(op.kernelExpression(), device), m_kernelArg(op.kernelExpression()), m_indices(op.indices()), m_buf(NULL), m_input(NULL), m_local_input(false), m_kernel(NULL), m_local_kernel(false), m_device(device)
+  {
+    EIGEN_STATIC_ASSERT((static_cast<int>(TensorEvaluator<InputArgType, Device>::Layout) == static_cast<int>(TensorEvaluator<KernelArgType, Device>::Layout)), YOU_MADE_A_PROGRAMMING_MISTAKE);
+
+    const typename TensorEvaluator<InputArgType, Device>::Dimensions& input_dims = m_inputImpl.dimensions();
+    const typename TensorEvaluator<KernelArgType, Device>::Dimensions& kernel_dims = m_kernelImpl.dimensions();
+
+    m_dimensions = m_inputImpl.dimensions();
+    for (int i = 0; i < NumKernelDims; ++i) {
+      const Index index = op.indices()[i];
+      const Index input_dim = input_dims[index];
+      const Index kernel_dim = kernel_dims[i];
+      const Index result_dim = input_dim - kernel_dim + 1;
+      m_dimensions[index] = result_dim;
+    }
+
+    if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
+      m_inputStride[0] = 1;
+      m_outputStride[0] = 1;
+      for (int i = 1; i < NumDims; ++i) {
+        m_inputStride[i] = m_inputStride[i - 1] * input_dims[i - 1];
+        m_outputStride[i] = m_outputStride[i - 1] * m_dimensions[i - 1];
+      }
+      m_kernelStride[0] = 1;
+      for (int i = 1; i < NumKernelDims; ++i) {
+        m_kernelStride[i] = m_kernelStride[i - 1] * kernel_dims[i - 1];
+      }
+    } else {
+      m_inputStride[NumDims - 1] = 1;
+      m_outputStride[NumDims - 1] = 1;
+      for (int i = NumDims - 2; i >= 0; --i) {
+        m_inputStride[i] = m_inputStride[i + 1] * input_dims[i + 1];
+        m_outputStride[i] = m_outputStride[i + 1] * m_dimensions[i + 1];
+      }
+      m_kernelStride[NumKernelDims - 1] = 1;
+      for (int i = NumKernelDims - 2; i >= 0; --i) {
+        m_kernelStride[i] = m_kernelStride[i + 1] * kernel_dims[i + 1];
+      }
+    }
+  }
+
+  EIGEN_DEVICE_FUNC const Dimensions& dimensions() const { return m_dimensions; }
+
+  EIGEN_STRONG_INLINE bool evalSubExprsIfNeeded(Scalar* data) {
+    preloadKernel();
+    preloadInput();
+    if (data) {
+      executeEval(data);
+      return false;
+    } else {
+      m_buf = (Scalar*)m_device.allocate(dimensions().TotalSize() * sizeof(Scalar));
+      executeEval(m_buf);
+      return true;
+    }
+  }
+
+  EIGEN_STRONG_INLINE void cleanup() {
+    m_inputImpl.cleanup();
+    if (m_buf) {
+      m_device.deallocate(m_buf);
+      m_buf = NULL;
+    }
+    if (m_local_input) {
+      m_device.deallocate((void*)m_input);
+      m_local_input = false;
+    }
+    m_input = NULL;
+    if (m_local_kernel) {
+      m_device.deallocate((void*)m_kernel);
+      m_local_kernel = false;
+    }
+    m_kernel = NULL;
+  }
+
+  EIGEN_STRONG_INLINE void preloadKernel() {
+    // Don't make a local copy of the kernel unless we have to (i.e. it's an
+    // expression that needs to be evaluated)
+    const Scalar* in_place = m_kernelImpl.data();
+    if (in_place) {
+      m_kernel = in_place;
+      m_local_kernel = false;
+    } else {
+      size_t kernel_sz = m_kernelImpl.dimensions().TotalSize() * sizeof(Scalar);
+      Scalar* local = (Scalar*)m_device.allocate_temp(kernel_sz);
+      typedef TensorEvalToOp<const KernelArgType> EvalTo;
+      EvalTo evalToTmp(local, m_kernelArg);
+      const bool Vectorize = internal::IsVectorizable<Device, KernelArgType>::value;
+      internal::TensorExecutor<const EvalTo, Device, Vectorize>::run(evalToTmp, m_device);
+
+      m_kernel = local;
+      m_local_kernel = true;
+    }
+  }
+
+  EIGEN_STRONG_INLINE void preloadInput() {
+    // Every coefficient of the input is read once per coefficient of the
+    // kernel: evaluate the input expression once in a local buffer unless its
+    // data is already available.
+    m_inputImpl.evalSubExprsIfNeeded(NULL);
+    const Scalar* in_place = m_inputImpl.data();
+    if (in_place) {
+      m_input = in_place;
+      m_local_input = false;
+    } else {
+      const Index input_size = m_inputImpl.dimensions().TotalSize();
+      Scalar* local = (Scalar*)m_device.allocate_temp(input_size * sizeof(Scalar));
+      const TensorEvaluator<InputArgType, Device>& impl = m_inputImpl;
+      m_device.parallelFor(
+          input_size, impl.costPerCoeff(false) + TensorOpCost(0, sizeof(Scalar), 0),
+          [local, &impl](Index first, Index last) {
+            for (Index i = first; i < last; ++i) {
+              local[i] = impl.coeff(i);
+            }
+          });
+      m_input = local;
+      m_local_input = true;
+    }
+  }
+
+  void executeEval(Scalar* data) const {
+    if (m_dimensions.TotalSize() == 0) {
+      return;
+    }
+    if (useFFT()) {
+      executeEvalFFT(data, typename internal::conditional<FFTSupported, internal::true_type, internal::false_type>::type());
+    } else {
+      executeEvalDirect(data);
+    }
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE CoeffReturnType coeff(Index index) const
+  {
+    eigen_assert(m_buf);
+    eigen_assert(index < m_dimensions.TotalSize());
+    return m_buf[index];
+  }
+
+  template<int LoadMode>
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE PacketReturnType packet(const Index index) const
+  {
+    eigen_assert(m_buf);
+    eigen_assert(index < m_dimensions.TotalSize());
+    return internal::ploadt<PacketReturnType, LoadMode>(m_buf+index);
+  }
+
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE TensorOpCost costPerCoeff(bool vectorized) const {
+    // The whole convolution is computed in evalSubExprsIfNeeded.
+    return TensorOpCost(sizeof(CoeffReturnType), 0, 0, vectorized, PacketSize);
+  }
+
+  EIGEN_DEVICE_FUNC EvaluatorPointerType data() const { return m_buf; }
+
+ private:
+  // The FFT of a line of length n costs about 5 n log2(n) flops when n is a
+  // power of two, and 4 times more with Bluestein's algorithm otherwise. The
+  // convolution takes three transforms (input, kernel and inverse) over the
+  // whole input, against kernel_size multiply-adds per output coefficient when
+  // computed directly. The constant accounts for the direct path being
+  // vectorized and register blocked while the FFT is not.
+  bool useFFT() const {
+    if (!FFTSupported) {
+      return false;
+    }
+    const double kernel_size = m_kernelImpl.dimensions().TotalSize();
+    const double direct_cost = kernel_size * m_dimensions.TotalSize() /
+                               static_cast<double>(internal::packet_traits<Scalar>::size);
+    double log_lengths = 0;
+    for (int i = 0; i < NumKernelDims; ++i) {
+      const Index n = m_inputImpl.dimensions()[m_indices[i]];
+      const double log_n = numext::log(static_cast<double>(n)) / numext::log(2.0);
+      log_lengths += (n & (n - 1)) == 0 ? log_n : 4 * log_n;
+    }
+    const double fft_cost = 5.0 * m_inputImpl.dimensions().TotalSize() * log_lengths;
+    return direct_cost > fft_cost;
+  }
+
+  void executeEvalDirect(Scalar* data) const {
+    const Index kernel_size = m_kernelImpl.dimensions().TotalSize();
+
+    // Offsets in the input of the coefficients of the kernel.
+    std::vector<Index> offsets(kernel_size);
+    for (Index k = 0; k < kernel_size; ++k) {
+      Index offset = 0;
+      Index index = k;
+      if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
+        for (int i = NumKernelDims - 1; i >= 0; --i) {
+          const Index idx = index / m_kernelStride[i];
+          offset += idx * m_inputStride[m_indices[i]];
+          index -= idx * m_kernelStride[i];
+        }
+      } else {
+        for (int i = 0; i < NumKernelDims; ++i) {
+          const Index idx = index / m_kernelStride[i];
+          offset += idx * m_inputStride[m_indices[i]];
+          index -= idx * m_kernelStride[i];
+        }
+      }
+      offsets[k] = offset;
+    }
+
+    // The output coefficients are contiguous in the input up to and including
+    // the innermost convolved dimension.
+    int run_dim = static_cast<int>(Layout) == static_cast<int>(ColMajor) ? NumDims - 1 : 0;
+    for (int i = 0; i < NumKernelDims; ++i) {
+      const int dim = static_cast<int>(m_indices[i]);
+      if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
+        run_dim = numext::mini(run_dim, dim);
+      } else {
+        run_dim = numext::maxi(run_dim, dim);
+      }
+    }
+    const Index run_len = m_outputStride[run_dim] * m_dimensions[run_dim];
+    const Index num_runs = m_dimensions.TotalSize() / run_len;
+
+    // Split the runs in blocks of whole packets.
+    const Index kBlockSize = 64 * internal::packet_traits<Scalar>::size;
+    const Index blocks_per_run = divup(run_len, kBlockSize);
+
+    const Scalar* input = m_input;
+    const Scalar* weights = m_kernel;
+    const Index* kernel_offsets = offsets.data();
+    const double block_size = static_cast<double>(numext::mini(run_len, kBlockSize));
+    const TensorOpCost cost(block_size * kernel_size * sizeof(Scalar), block_size * sizeof(Scalar),
+                            block_size * kernel_size * (TensorOpCost::AddCost<Scalar>() + TensorOpCost::MulCost<Scalar>()),
+                            true, internal::packet_traits<Scalar>::size);
+    m_device.parallelFor(num_runs * blocks_per_run, cost,
+                         [=](Index first, Index last) {
+      for (Index b = first; b < last; ++b) {
+        const Index run = b / blocks_per_run;
+        const Index begin = (b - run * blocks_per_run) * kBlockSize;
+        const Index len = numext::mini(kBlockSize, run_len - begin);
+        internal::ConvolutionRunKernel<Scalar, Index>::run(
+            input + firstInputOfRun(run * run_len, run_dim) + begin, kernel_offsets, weights, kernel_size,
+            data + run * run_len + begin, len);
+      }
+    });
+  }
+
+  // Offset in the input of the output coefficient index, which is the first
+  // coefficient of a run spanning the dimensions up to run_dim.
+  Index firstInputOfRun(Index index, int run_dim) const {
+    Index startInput = 0;
+    if (static_cast<int>(Layout) == static_cast<int>(ColMajor)) {
+      for (int i = NumDims - 1; i > run_dim; --i) {
+        const Index idx = index / m_outputStride[i];
+        startInput += idx * m_inputStride[i];
+        index -= idx * m_outputStride[i];
+      }
+    } else {
+      for (int i = 0; i < run_dim; ++i) {
+        const Index idx = index / m_outputStride[i];
+        startInput += idx * m_inputStride[i];
+        index -= idx * m_outputStride[i];
+      }
+    }
+    return startInput;
+  }
+
+  void executeEvalFFT(Scalar*, internal::false_type) const {
+    eigen_assert(false && "The FFT is not supported for this scalar type");
+  }
+
+  // The correlation computed by TensorConvolutionOp, out(o) = sum_k in(o + k) kernel(k),
+  // doesn't wrap around for the valid outputs: it is the circular convolution
+  // of the input with the reversed kernel, whose FFT is n times the inverse FFT
+  // of the zero padded kernel, n being the number of points of the transforms.
+  void executeEvalFFT(Scalar* data, internal::true_type) const {
+    typedef std::complex<RealScalar> ComplexScalar;
+    typedef Tensor<ComplexScalar, NumDims, Layout, Index> ComplexTensor;
+    const typename TensorEvaluator<InputArgType, Device>::Dimensions& input_dims = m_inputImpl.dimensions();
+    const typename TensorEvaluator<KernelArgType, Device>::Dimensions& kernel_dims = m_kernelImpl.dimensions();
+    TensorMap<const Tensor<Scalar, NumDims, Layout, Index> > input(m_input, input_dims);
+    TensorMap<const Tensor<Scalar, NumKernelDims, Layout, Index> > kernel(m_kernel, kernel_dims);
+
+    // Shuffle the kernel dimensions in the order of the input dimensions they
+    // apply to, so that the kernel can be reshaped and padded to the input.
+    array<Index, NumKernelDims> shuffle;
+    for (int i = 0; i < NumKernelDims; ++i) {
+      shuffle[i] = i;
+    }
+    for (int i = 1; i < NumKernelDims; ++i) {
+      for (int j = i; j > 0 && m_indices[shuffle[j - 1]] > m_indices[shuffle[j]]; --j) {
+        std::swap(shuffle[j - 1], shuffle[j]);
+      }
+    }
+    DSizes<Index, NumDims> kernel_shape;
+    array<std::pair<Index, Index>, NumDims> kernel_padding;
+    array<Index, NumDims> broadcast;
+    for (int i = 0; i < NumDims; ++i) {
+      kernel_shape[i] = 1;
+      kernel_padding[i] = std::make_pair(Index(0), Index(0));
+      broadcast[i] = input_dims[i];
+    }
+    Index fft_size = 1;
+    for (int i = 0; i < NumKernelDims; ++i) {
+      const Index dim = m_indices[i];
+      kernel_shape[dim] = kernel_dims[i];
+      kernel_padding[dim].second = input_dims[dim] - kernel_dims[i];
+      broadcast[dim] = 1;
+      fft_size *= input_dims[dim];
+    }
+
+    DSizes<Index, NumDims> kernel_spectrum_dims = kernel_shape;
+    for (int i = 0; i < NumKernelDims; ++i) {
+      kernel_spectrum_dims[m_indices[i]] = input_dims[m_indices[i]];
+    }
+    ComplexTensor kernel_spectrum(kernel_spectrum_dims);
+    kernel_spectrum.device(m_device) =
+        (kernel.shuffle(shuffle).reshape(kernel_shape) * Scalar(RealScalar(fft_size))).pad(kernel_padding)
+            .template fft<BothParts, FFT_REVERSE>(m_indices);
+
+    ComplexTensor spectrum(input_dims);
+    spectrum.device(m_device) = input.template fft<BothParts, FFT_FORWARD>(m_indices);
+    spectrum.device(m_device) = spectrum * kernel_spectrum.broadcast(broadcast);
+
+    const int ResultPart = NumTraits<Scalar>::IsComplex ? BothParts : RealPart;
+    array<Index, NumDims> offsets;
+    for (int i = 0; i < NumDims; ++i) {
+      offsets[i] = 0;
+    }
+    TensorMap<Tensor<Scalar, NumDims, Layout, Index> > result(data, m_dimensions);
+    // Slice the complex transform: the scalar type of a TensorFFTOp is the one
+    // of its input, not the one of the extracted part.
+    result.device(m_device) = spectrum.template fft<BothParts, FFT_REVERSE>(m_indices)
+                                  .slice(offsets, m_dimensions).unaryExpr(PartOf<ResultPart>());
+  }
+
+  array<Index, NumDims> m_inputStride;
+  array<Index, NumDims> m_outputStride;
+  array<Index, NumKernelDims> m_kernelStride;
+
+  TensorEvaluator<InputArgType, Device> m_inputImpl;
+  TensorEvaluator<KernelArgType, Device> m_kernelImpl;
+  KernelArgType m_kernelArg;
+  Indices m_indices;
+  Dimensions m_dimensions;
+  Scalar* m_buf;
+  const Scalar* m_input;
+  bool m_local_input;
+  const Scalar* m_kernel;
+  bool m_local_kernel;
+
+  const Device EIGEN_DEVICE_REF m_device;
+};
+
+} // end namespace Eigen
+
+#endif  // EIGEN_USE_THREADS
+#endif // EIGEN_CXX11_TENSOR_TENSOR_CONVOLUTION_THREAD_POOL_H
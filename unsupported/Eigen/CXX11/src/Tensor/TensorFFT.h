@@ -19,7 +19,6 @@ namespace Eigen {
   *
   * TODO:
   * Vectorize the Cooley Tukey and the Bluestein algorithm
-  * Add support for multithreaded evaluation
   * Improve the performance on GPU
   */
 
@@ -80,6 +79,100 @@ struct nested<TensorFFTOp<FFT, XprType, FFTResultType, FFTDirection>, 1, typenam
   typedef TensorFFTOp<FFT, XprType, FFTResultType, FFTDirection> type;
 };
 
+// Data of the 1-D transforms of a given length that does not depend on the
+// values being transformed.
+template <typename ComplexScalar>
+struct TensorFFTPlan {
+  Index line_len;
+  bool is_power_of_two;
+  // Padded length used by Bluestein's algorithm (0 for powers of two).
+  Index good_composite;
+  // log2 of the length of the Cooley Tukey transforms.
+  Index log_len;
+  // Bluestein's twiddle factors exp(sqrt(-1) * pi * n^2 / line_len) for
+  // n = 0, 1,..., line_len.
+  std::vector<ComplexScalar> pos_j_base_powered;
+  // Transform of Bluestein's convolution kernel, divided by good_composite.
+  std::vector<ComplexScalar> b;
+};
+
+// Process-wide cache of the plans of the 1-D transforms keyed on the line
+// length, shared by all the FFT evaluators with the same scalar type and
+// direction: the twiddle factors and the transform of Bluestein's kernel are
+// computed once per length instead of once per line and per evaluation.
+template <typename ComplexScalar, int FFTDir>
+class TensorFFTPlanCache {
+ public:
+  typedef TensorFFTPlan<ComplexScalar> Plan;
+  typedef std::shared_ptr<const Plan> PlanPointer;
+
+  // The cache is flushed when it holds that many plans. The plans in use are
+  // kept alive by their evaluators.
+  static const size_t kMaxPlans = 64;
+
+  template <typename MakePlan>
+  static PlanPointer get(Index line_len, MakePlan make_plan) {
+    {
+      std::lock_guard<std::mutex> lock(mutex());
+      typename PlanMap::const_iterator it = plans().find(line_len);
+      if (it != plans().end()) {
+        return it->second;
+      }
+    }
+    // The plan is computed without holding the lock: threads racing for the
+    // same length compute it more than once, but only the first one is kept.
+    PlanPointer plan = make_plan(line_len);
+    std::lock_guard<std::mutex> lock(mutex());
+    if (plans().size() >= kMaxPlans) {
+      plans().clear();
+    }
+    return plans().insert(std::make_pair(line_len, plan)).first->second;
+  }
+
+ private:
+  typedef std::map<Index, PlanPointer> PlanMap;
+
+  static std::mutex& mutex() {
+    static std::mutex m;
+    return m;
+  }
+
+  static PlanMap& plans() {
+    static PlanMap p;
+    return p;
+  }
+};
+
+// Runs f(first, last) over the independent items [0, n) of an FFT
+// evaluation: the coefficients of the input and output conversions and the
+// 1-D lines of the transform along an axis.
+template <typename Device>
+struct FFTLauncher {
+  template <typename Function>
+  void operator()(const Device&, Index n, const TensorOpCost&, Function f) const {
+    f(0, n);
+  }
+};
+
+#ifdef EIGEN_USE_THREADS
+// Specialization for multi-threaded execution.
+template <>
+struct FFTLauncher<ThreadPoolDevice> {
+  template <typename Function>
+  void operator()(const ThreadPoolDevice& device, Index n, const TensorOpCost& cost, Function f) const {
+    // Make the blocks a multiple of 16 items, so that two neighboring threads
+    // don't write to the same cacheline when consecutive items are adjacent in
+    // memory, as the lines of a strided axis are.
+    device.parallelFor(n, cost,
+                       [](Index block_size) {
+                         const Index kBlockAlignment = 16;
+                         return kBlockAlignment * divup(block_size, kBlockAlignment);
+                       },
+                       f);
+  }
+};
+#endif  // EIGEN_USE_THREADS
+
 }  // end namespace internal
 
 template <typename FFT, typename XprType, int FFTResultType, int FFTDir>
@@ -213,108 +306,177 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
 #endif
 
  private:
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void evalToBuf(EvaluatorPointerType data) {
+  typedef internal::TensorFFTPlanCache<ComplexScalar, FFTDir> PlanCache;
+  typedef typename PlanCache::Plan Plan;
+  typedef typename PlanCache::PlanPointer PlanPointer;
+
+  void evalToBuf(EvaluatorPointerType data) {
     const bool write_to_out = internal::is_same<OutputScalar, ComplexScalar>::value;
     ComplexScalar* buf = write_to_out ? (ComplexScalar*)data : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * m_size);
+    internal::FFTLauncher<Device> launcher;
 
-    for (Index i = 0; i < m_size; ++i) {
-      buf[i] = MakeComplex<internal::is_same<InputScalar, RealScalar>::value>()(m_impl.coeff(i));
-    }
+    launcher(m_device, m_size, m_impl.costPerCoeff(false) + TensorOpCost(0, sizeof(ComplexScalar), 0),
+             [this, buf](Index first, Index last) {
+               for (Index i = first; i < last; ++i) {
+                 buf[i] = MakeComplex<internal::is_same<InputScalar, RealScalar>::value>()(m_impl.coeff(i));
+               }
+             });
 
     for (size_t i = 0; i < m_fft.size(); ++i) {
       Index dim = m_fft[i];
       eigen_assert(dim >= 0 && dim < NumDims);
       Index line_len = m_dimensions[dim];
       eigen_assert(line_len >= 1);
-      ComplexScalar* line_buf = (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * line_len);
-      const bool is_power_of_two = isPowerOfTwo(line_len);
-      const Index good_composite = is_power_of_two ? 0 : findGoodComposite(line_len);
-      const Index log_len = is_power_of_two ? getLog2(line_len) : getLog2(good_composite);
-
-      ComplexScalar* a = is_power_of_two ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * good_composite);
-      ComplexScalar* b = is_power_of_two ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * good_composite);
-      ComplexScalar* pos_j_base_powered = is_power_of_two ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * (line_len + 1));
-      if (!is_power_of_two) {
-        // Compute twiddle factors
-        //   t_n = exp(sqrt(-1) * pi * n^2 / line_len)
-        // for n = 0, 1,..., line_len-1.
-        // For n > 2 we use the recurrence t_n = t_{n-1}^2 / t_{n-2} * t_1^2
-
-        // The recurrence is correct in exact arithmetic, but causes
-        // numerical issues for large transforms, especially in
-        // single-precision floating point.
-        //
-        // pos_j_base_powered[0] = ComplexScalar(1, 0);
-        // if (line_len > 1) {
-        //   const ComplexScalar pos_j_base = ComplexScalar(
-        //       numext::cos(M_PI / line_len), numext::sin(M_PI / line_len));
-        //   pos_j_base_powered[1] = pos_j_base;
-        //   if (line_len > 2) {
-        //     const ComplexScalar pos_j_base_sq = pos_j_base * pos_j_base;
-        //     for (int i = 2; i < line_len + 1; ++i) {
-        //       pos_j_base_powered[i] = pos_j_base_powered[i - 1] *
-        //           pos_j_base_powered[i - 1] /
-        //           pos_j_base_powered[i - 2] *
-        //           pos_j_base_sq;
-        //     }
-        //   }
-        // }
-        // TODO(rmlarsen): Find a way to use Eigen's vectorized sin
-        // and cosine functions here.
-        for (int j = 0; j < line_len + 1; ++j) {
-          double arg = ((EIGEN_PI * j) * j) / line_len;
-          std::complex<double> tmp(numext::cos(arg), numext::sin(arg));
-          pos_j_base_powered[j] = static_cast<ComplexScalar>(tmp);
+      const PlanPointer plan = PlanCache::get(line_len, [this](Index n) { return makePlan(n); });
+
+      // The lines along dim are independent: each one is gathered, transformed
+      // in a private buffer and scattered back.
+      const Index fft_len = plan->is_power_of_two ? line_len : plan->good_composite;
+      const double line_bytes = static_cast<double>(sizeof(ComplexScalar) * line_len);
+      const double line_cycles = (plan->is_power_of_two ? 5.0 : 10.0) * fft_len * numext::maxi<Index>(plan->log_len, 1);
+      launcher(m_device, m_size / line_len, TensorOpCost(line_bytes, line_bytes, line_cycles),
+               [this, buf, dim, &plan](Index first, Index last) {
+                 processLines(buf, dim, *plan, first, last);
+               });
+    }
+
+    if(!write_to_out) {
+      launcher(m_device, m_size, TensorOpCost(sizeof(ComplexScalar), sizeof(OutputScalar), 0),
+               [data, buf](Index first, Index last) {
+                 for (Index i = first; i < last; ++i) {
+                   data[i] = PartOf<FFTResultType>()(buf[i]);
+                 }
+               });
+      m_device.deallocate(buf);
+    }
+  }
+
+  // Transforms the lines first, first+1,..., last-1 along dim.
+  void processLines(ComplexScalar* buf, Index dim, const Plan& plan, Index first, Index last) {
+    const Index line_len = plan.line_len;
+    ComplexScalar* line_buf = (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * line_len);
+    ComplexScalar* a = plan.is_power_of_two ? NULL : (ComplexScalar*)m_device.allocate(sizeof(ComplexScalar) * plan.good_composite);
+    const Index stride = m_strides[dim];
+
+    for (Index partial_index = first; partial_index < last; ++partial_index) {
+      const Index base_offset = getBaseOffsetFromIndex(partial_index, dim);
+
+      // get data into line_buf (this may run on a worker thread of the device,
+      // don't use the device's possibly multithreaded memcpy)
+      if (stride == 1) {
+        std::copy(&buf[base_offset], &buf[base_offset] + line_len, line_buf);
+      } else {
+        Index offset = base_offset;
+        for (int j = 0; j < line_len; ++j, offset += stride) {
+          line_buf[j] = buf[offset];
         }
       }
 
-      for (Index partial_index = 0; partial_index < m_size / line_len; ++partial_index) {
-        const Index base_offset = getBaseOffsetFromIndex(partial_index, dim);
-
-        // get data into line_buf
-        const Index stride = m_strides[dim];
-        if (stride == 1) {
-          m_device.memcpy(line_buf, &buf[base_offset], line_len*sizeof(ComplexScalar));
-        } else {
-          Index offset = base_offset;
-          for (int j = 0; j < line_len; ++j, offset += stride) {
-            line_buf[j] = buf[offset];
-          }
-        }
+      // process the line
+      if (plan.is_power_of_two) {
+        processDataLineCooleyTukey(line_buf, line_len, plan.log_len);
+      }
+      else {
+        processDataLineBluestein(line_buf, plan, a);
+      }
 
-        // process the line
-        if (is_power_of_two) {
-          processDataLineCooleyTukey(line_buf, line_len, log_len);
-        }
-        else {
-          processDataLineBluestein(line_buf, line_len, good_composite, log_len, a, b, pos_j_base_powered);
+      // write back
+      if (FFTDir == FFT_FORWARD && stride == 1) {
+        std::copy(line_buf, line_buf + line_len, &buf[base_offset]);
+      } else {
+        Index offset = base_offset;
+        const ComplexScalar div_factor =  ComplexScalar(1.0 / line_len, 0);
+        for (int j = 0; j < line_len; ++j, offset += stride) {
+           buf[offset] = (FFTDir == FFT_FORWARD) ? line_buf[j] : line_buf[j] * div_factor;
         }
+      }
+    }
 
-        // write back
-        if (FFTDir == FFT_FORWARD && stride == 1) {
-          m_device.memcpy(&buf[base_offset], line_buf, line_len*sizeof(ComplexScalar));
-        } else {
-          Index offset = base_offset;
-          const ComplexScalar div_factor =  ComplexScalar(1.0 / line_len, 0);
-          for (int j = 0; j < line_len; ++j, offset += stride) {
-             buf[offset] = (FFTDir == FFT_FORWARD) ? line_buf[j] : line_buf[j] * div_factor;
-          }
-        }
+    m_device.deallocate(line_buf);
+    if (!plan.is_power_of_two) {
+      m_device.deallocate(a);
+    }
+  }
+
+  PlanPointer makePlan(Index line_len) {
+    std::shared_ptr<Plan> plan = std::make_shared<Plan>();
+    plan->line_len = line_len;
+    plan->is_power_of_two = isPowerOfTwo(line_len);
+    plan->good_composite = plan->is_power_of_two ? 0 : findGoodComposite(line_len);
+    plan->log_len = plan->is_power_of_two ? getLog2(line_len) : getLog2(plan->good_composite);
+    if (plan->is_power_of_two) {
+      return plan;
+    }
+
+    // Compute twiddle factors
+    //   t_n = exp(sqrt(-1) * pi * n^2 / line_len)
+    // for n = 0, 1,..., line_len-1.
+    // For n > 2 we use the recurrence t_n = t_{n-1}^2 / t_{n-2} * t_1^2
+
+    // The recurrence is correct in exact arithmetic, but causes
+    // numerical issues for large transforms, especially in
+    // single-precision floating point.
+    //
+    // pos_j_base_powered[0] = ComplexScalar(1, 0);
+    // if (line_len > 1) {
+    //   const ComplexScalar pos_j_base = ComplexScalar(
+    //       numext::cos(M_PI / line_len), numext::sin(M_PI / line_len));
+    //   pos_j_base_powered[1] = pos_j_base;
+    //   if (line_len > 2) {
+    //     const ComplexScalar pos_j_base_sq = pos_j_base * pos_j_base;
+    //     for (int i = 2; i < line_len + 1; ++i) {
+    //       pos_j_base_powered[i] = pos_j_base_powered[i - 1] *
+    //           pos_j_base_powered[i - 1] /
+    //           pos_j_base_powered[i - 2] *
+    //           pos_j_base_sq;
+    //     }
+    //   }
+    // }
+    // TODO(rmlarsen): Find a way to use Eigen's vectorized sin
+    // and cosine functions here.
+    std::vector<ComplexScalar>& pos_j_base_powered = plan->pos_j_base_powered;
+    pos_j_base_powered.resize(line_len + 1);
+    for (int j = 0; j < line_len + 1; ++j) {
+      double arg = ((EIGEN_PI * j) * j) / line_len;
+      std::complex<double> tmp(numext::cos(arg), numext::sin(arg));
+      pos_j_base_powered[j] = static_cast<ComplexScalar>(tmp);
+    }
+
+    // The convolution kernel of Bluestein's algorithm does not depend on the
+    // data: transform it once. The scaling of the inverse transform of the
+    // convolution is folded into it, which is exact since good_composite is a
+    // power of two.
+    const Index n = line_len;
+    const Index m = plan->good_composite;
+    std::vector<ComplexScalar>& b = plan->b;
+    b.resize(m);
+    for (Index i = 0; i < n; ++i) {
+      if(FFTDir == FFT_FORWARD) {
+        b[i] = pos_j_base_powered[i];
       }
-      m_device.deallocate(line_buf);
-      if (!is_power_of_two) {
-        m_device.deallocate(a);
-        m_device.deallocate(b);
-        m_device.deallocate(pos_j_base_powered);
+      else {
+        b[i] = numext::conj(pos_j_base_powered[i]);
       }
     }
-
-    if(!write_to_out) {
-      for (Index i = 0; i < m_size; ++i) {
-        data[i] = PartOf<FFTResultType>()(buf[i]);
+    for (Index i = n; i < m - n; ++i) {
+      b[i] = ComplexScalar(0, 0);
+    }
+    for (Index i = m - n; i < m; ++i) {
+      if(FFTDir == FFT_FORWARD) {
+        b[i] = pos_j_base_powered[m-i];
+      }
+      else {
+        b[i] = numext::conj(pos_j_base_powered[m-i]);
       }
-      m_device.deallocate(buf);
     }
+
+    scramble_FFT(b.data(), m);
+    compute_1D_Butterfly<FFT_FORWARD>(b.data(), m, plan->log_len);
+
+    for (Index i = 0; i < m; ++i) {
+      b[i] /= m;
+    }
+    return plan;
   }
 
   EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE static bool isPowerOfTwo(Index x) {
@@ -342,11 +504,13 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
     compute_1D_Butterfly<FFTDir>(line_buf, line_len, log_len);
   }
 
-  // Call Bluestein's FFT algorithm, m is a good composite number greater than (2 * n - 1), used as the padding length
-  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void processDataLineBluestein(ComplexScalar* line_buf, Index line_len, Index good_composite, Index log_len, ComplexScalar* a, ComplexScalar* b, const ComplexScalar* pos_j_base_powered) {
-    Index n = line_len;
-    Index m = good_composite;
+  // Call Bluestein's FFT algorithm, using the padding length and the transformed kernel of the plan
+  EIGEN_DEVICE_FUNC EIGEN_STRONG_INLINE void processDataLineBluestein(ComplexScalar* line_buf, const Plan& plan, ComplexScalar* a) {
+    Index n = plan.line_len;
+    Index m = plan.good_composite;
     ComplexScalar* data = line_buf;
+    const ComplexScalar* pos_j_base_powered = plan.pos_j_base_powered.data();
+    const ComplexScalar* b = plan.b.data();
 
     for (Index i = 0; i < n; ++i) {
       if(FFTDir == FFT_FORWARD) {
@@ -360,43 +524,16 @@ struct TensorEvaluator<const TensorFFTOp<FFT, ArgType, FFTResultType, FFTDir>, D
       a[i] = ComplexScalar(0, 0);
     }
 
-    for (Index i = 0; i < n; ++i) {
-      if(FFTDir == FFT_FORWARD) {
-        b[i] = pos_j_base_powered[i];
-      }
-      else {
-        b[i] = numext::conj(pos_j_base_powered[i]);
-      }
-    }
-    for (Index i = n; i < m - n; ++i) {
-      b[i] = ComplexScalar(0, 0);
-    }
-    for (Index i = m - n; i < m; ++i) {
-      if(FFTDir == FFT_FORWARD) {
-        b[i] = pos_j_base_powered[m-i];
-      }
-      else {
-        b[i] = numext::conj(pos_j_base_powered[m-i]);
-      }
-    }
-
     scramble_FFT(a, m);
-    compute_1D_Butterfly<FFT_FORWARD>(a, m, log_len);
-
-    scramble_FFT(b, m);
-    compute_1D_Butterfly<FFT_FORWARD>(b, m, log_len);
+    compute_1D_Butterfly<FFT_FORWARD>(a, m, plan.log_len);
 
+    // b is already divided by m, which does the scaling after ifft
     for (Index i = 0; i < m; ++i) {
       a[i] *= b[i];
     }
 
     scramble_FFT(a, m);
-    compute_1D_Butterfly<FFT_REVERSE>(a, m, log_len);
-
-    //Do the scaling after ifft
-    for (Index i = 0; i < m; ++i) {
-      a[i] /= m;
-    }
+    compute_1D_Butterfly<FFT_REVERSE>(a, m, plan.log_len);
 
     for (Index i = 0; i < n; ++i) {
       if(FFTDir == FFT_FORWARD) {
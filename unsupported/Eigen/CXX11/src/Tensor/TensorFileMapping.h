@@ -0,0 +1,119 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_CXX11_TENSOR_TENSOR_FILE_MAPPING_H
+#define EIGEN_CXX11_TENSOR_TENSOR_FILE_MAPPING_H
+
+namespace Eigen {
+
+/** \class TensorFileMapping
+  * \ingroup CXX11_TensorFileMapping_Module
+  *
+  * \brief Memory mapping of a file written by saveTensor().
+  *
+  * The file is mapped read-only and its coefficients are accessed in place
+  * through a TensorMap: they are only loaded by the OS when first touched, so
+  * opening a file does not depend on its size. The maps returned by tensor()
+  * are valid as long as the mapping is open.
+  *
+  * \code
+  * TensorFileMapping file("weights.bin");
+  * TensorMap<const Tensor<float, 2>, Aligned> weights = file.tensor<Tensor<float, 2> >();
+  * \endcode
+  */
+class TensorFileMapping {
+ public:
+  TensorFileMapping() : m_base(NULL), m_size(0) {}
+  explicit TensorFileMapping(const std::string& filename) : m_base(NULL), m_size(0) { open(filename); }
+  ~TensorFileMapping() { close(); }
+
+  TensorFileMapping(const TensorFileMapping&) = delete;
+  void operator=(const TensorFileMapping&) = delete;
+
+  /** Maps the file \a filename. Returns false if it cannot be mapped or is
+    * not a well formed tensor file. */
+  bool open(const std::string& filename) {
+    close();
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(internal::TensorFileHeader)) {
+      ::close(fd);
+      return false;
+    }
+    void* base = ::mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+      return false;
+    }
+    m_base = static_cast<const char*>(base);
+    m_size = st.st_size;
+
+    const internal::TensorFileHeader& h = header();
+    if (std::memcmp(h.magic, internal::kTensorFileMagic, sizeof(h.magic)) != 0 ||
+        h.version != internal::kTensorFileVersion || h.byte_order != internal::kTensorFileByteOrder ||
+        h.data_offset > m_size || h.rank > (m_size - sizeof(h)) / sizeof(numext::uint64_t)) {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  void close() {
+    if (m_base) {
+      ::munmap(const_cast<char*>(m_base), m_size);
+      m_base = NULL;
+      m_size = 0;
+    }
+  }
+
+  bool isOpen() const { return m_base != NULL; }
+
+  /** \returns whether the mapped file holds a tensor of type \a TensorType
+    * whose coefficients are in the file and aligned for an Aligned map. */
+  template <typename TensorType>
+  bool isCompatible() const {
+    typedef typename internal::remove_const<typename TensorType::Scalar>::type Scalar;
+    array<typename TensorType::Index, TensorType::NumIndices> dimensions;
+    numext::uint64_t size;
+    return isOpen() && header().rank == static_cast<numext::uint32_t>(TensorType::NumIndices) &&
+           internal::tensor_file_check<TensorType>(header(), dims(), dimensions, size) &&
+           size <= (m_size - header().data_offset) / sizeof(Scalar) &&
+           (EIGEN_MAX_ALIGN_BYTES == 0 ||
+            reinterpret_cast<std::size_t>(m_base + header().data_offset) % numext::maxi(EIGEN_MAX_ALIGN_BYTES, 1) == 0);
+  }
+
+  /** \returns a read-only map of the mapped tensor, which must be compatible
+    * with \a TensorType. */
+  template <typename TensorType>
+  TensorMap<const TensorType, Aligned> tensor() const {
+    typedef typename internal::remove_const<typename TensorType::Scalar>::type Scalar;
+    eigen_assert(isCompatible<TensorType>() && "the mapped file does not hold a tensor of this type");
+    array<typename TensorType::Index, TensorType::NumIndices> dimensions;
+    numext::uint64_t size;
+    internal::tensor_file_check<TensorType>(header(), dims(), dimensions, size);
+    return TensorMap<const TensorType, Aligned>(reinterpret_cast<const Scalar*>(m_base + header().data_offset),
+                                                dimensions);
+  }
+
+ private:
+  const internal::TensorFileHeader& header() const {
+    return *reinterpret_cast<const internal::TensorFileHeader*>(m_base);
+  }
+  const numext::uint64_t* dims() const {
+    return reinterpret_cast<const numext::uint64_t*>(m_base + sizeof(internal::TensorFileHeader));
+  }
+
+  const char* m_base;
+  std::size_t m_size;
+};
+
+} // end namespace Eigen
+
+#endif // EIGEN_CXX11_TENSOR_TENSOR_FILE_MAPPING_H
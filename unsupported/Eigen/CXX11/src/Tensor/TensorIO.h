@@ -74,6 +74,232 @@ std::ostream& operator << (std::ostream& os, const TensorBase<T, ReadOnlyAccesso
   return os;
 }
 
+namespace internal {
+
+// Scalar type codes of the binary tensor format. They are stored on disk and
+// must not be renumbered.
+enum TensorFileScalarType {
+  TensorFileUnknown = 0,
+  TensorFileBool = 1,
+  TensorFileInt8 = 2,
+  TensorFileUInt8 = 3,
+  TensorFileInt16 = 4,
+  TensorFileUInt16 = 5,
+  TensorFileInt32 = 6,
+  TensorFileUInt32 = 7,
+  TensorFileInt64 = 8,
+  TensorFileUInt64 = 9,
+  TensorFileHalf = 10,
+  TensorFileBFloat16 = 11,
+  TensorFileFloat = 12,
+  TensorFileDouble = 13,
+  TensorFileComplexFloat = 14,
+  TensorFileComplexDouble = 15
+};
+
+// Integers are identified by their size and signedness, so that e.g. long and
+// long long of the same width can read each other's files.
+template <typename T, bool IsIntegral = std::is_integral<T>::value>
+struct tensor_file_scalar {
+  static const int value = TensorFileUnknown;
+};
+
+template <typename T>
+struct tensor_file_scalar<T, true> {
+  static const int value =
+      is_same<T, bool>::value ? TensorFileBool
+                              : TensorFileInt8 + 2 * (sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : 3) +
+                                    (std::is_signed<T>::value ? 0 : 1);
+};
+
+template <> struct tensor_file_scalar<Eigen::half, false> { static const int value = TensorFileHalf; };
+template <> struct tensor_file_scalar<Eigen::bfloat16, false> { static const int value = TensorFileBFloat16; };
+template <> struct tensor_file_scalar<float, false> { static const int value = TensorFileFloat; };
+template <> struct tensor_file_scalar<double, false> { static const int value = TensorFileDouble; };
+template <> struct tensor_file_scalar<std::complex<float>, false> { static const int value = TensorFileComplexFloat; };
+template <> struct tensor_file_scalar<std::complex<double>, false> { static const int value = TensorFileComplexDouble; };
+
+// Fixed part of the header of the binary tensor format. It is followed by the
+// rank dimensions as 64-bit integers, and by padding up to data_offset, a
+// multiple of alignment where the coefficients start. Everything is stored in
+// the byte order of the writer, which byte_order records.
+struct TensorFileHeader {
+  char magic[8];
+  numext::uint32_t version;
+  numext::uint32_t byte_order;
+  numext::uint32_t scalar_type;
+  numext::uint32_t scalar_size;
+  numext::uint32_t layout;
+  numext::uint32_t rank;
+  numext::uint64_t alignment;
+  numext::uint64_t data_offset;
+};
+
+static const char kTensorFileMagic[8] = {'E', 'I', 'G', 'E', 'N', 'T', 'S', 'R'};
+static const numext::uint32_t kTensorFileVersion = 1;
+static const numext::uint32_t kTensorFileByteOrder = 0x01020304;
+
+// Checks that a header describes a tensor of type TensorType and that its
+// dimensions fit the index type. Returns the number of coefficients in size.
+template <typename TensorType>
+bool tensor_file_check(const TensorFileHeader& header, const numext::uint64_t* dims,
+                       array<typename TensorType::Index, TensorType::NumIndices>& dimensions,
+                       numext::uint64_t& size) {
+  typedef typename remove_const<typename TensorType::Scalar>::type Scalar;
+  typedef typename TensorType::Index Index;
+  // The coefficients are stored as raw bytes.
+  EIGEN_STATIC_ASSERT(tensor_file_scalar<Scalar>::value != TensorFileUnknown, THIS_TYPE_IS_NOT_SUPPORTED);
+  if (std::memcmp(header.magic, kTensorFileMagic, sizeof(kTensorFileMagic)) != 0 ||
+      header.version != kTensorFileVersion || header.byte_order != kTensorFileByteOrder ||
+      header.scalar_type != static_cast<numext::uint32_t>(tensor_file_scalar<Scalar>::value) ||
+      header.scalar_size != sizeof(Scalar) || header.layout != static_cast<numext::uint32_t>(TensorType::Layout) ||
+      header.rank != static_cast<numext::uint32_t>(TensorType::NumIndices) ||
+      header.data_offset < sizeof(TensorFileHeader) + sizeof(numext::uint64_t) * header.rank) {
+    return false;
+  }
+  const numext::uint64_t max_size = static_cast<numext::uint64_t>(NumTraits<Index>::highest()) / sizeof(Scalar);
+  size = 1;
+  for (int i = 0; i < TensorType::NumIndices; ++i) {
+    if (dims[i] != 0 && size > max_size / dims[i]) {
+      return false;
+    }
+    size *= dims[i];
+    dimensions[i] = static_cast<Index>(dims[i]);
+  }
+  return true;
+}
+
+}  // end namespace internal
+
+namespace internal {
+
+// Writes the coefficients of the evaluator \a tensor, which must expose them
+// through data(), in the binary format of writeTensor().
+template <typename Evaluator>
+bool tensor_file_write(std::ostream& os, const Evaluator& tensor, std::size_t alignment) {
+  typedef typename remove_const<typename Evaluator::Scalar>::type Scalar;
+  static const int rank = array_size<typename Evaluator::Dimensions>::value;
+
+  TensorFileHeader header;
+  std::memcpy(header.magic, kTensorFileMagic, sizeof(header.magic));
+  header.version = kTensorFileVersion;
+  header.byte_order = kTensorFileByteOrder;
+  header.scalar_type = tensor_file_scalar<Scalar>::value;
+  header.scalar_size = sizeof(Scalar);
+  header.layout = Evaluator::Layout;
+  header.rank = rank;
+  header.alignment = alignment;
+  const std::size_t header_size = sizeof(header) + sizeof(numext::uint64_t) * rank;
+  header.data_offset = divup(header_size, alignment) * alignment;
+
+  numext::uint64_t dims[rank > 0 ? rank : 1];
+  for (int i = 0; i < rank; ++i) {
+    dims[i] = tensor.dimensions()[i];
+  }
+  const std::vector<char> padding(header.data_offset - header_size, 0);
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(reinterpret_cast<const char*>(dims), sizeof(numext::uint64_t) * rank);
+  os.write(padding.data(), padding.size());
+  os.write(reinterpret_cast<const char*>(tensor.data()), sizeof(Scalar) * array_prod(tensor.dimensions()));
+  return os.good();
+}
+
+}  // end namespace internal
+
+/** Writes the evaluation of \a expr to \a os in a binary format: a header
+  * with the dimensions, layout, scalar type and alignment of the tensor,
+  * followed by its raw coefficients at an offset that is a multiple of
+  * \a alignment, so that the file can be mapped by TensorFileMapping.
+  *
+  * The coefficients of tensors, maps and other expressions stored in a
+  * contiguous buffer are written in place; other expressions are evaluated
+  * into a temporary first.
+  *
+  * \sa readTensor(), saveTensor()
+  */
+template <typename T>
+bool writeTensor(std::ostream& os, const TensorBase<T, ReadOnlyAccessors>& expr, std::size_t alignment = 64) {
+  typedef TensorEvaluator<const T, DefaultDevice> Evaluator;
+  typedef typename internal::remove_const<typename Evaluator::Scalar>::type Scalar;
+  EIGEN_STATIC_ASSERT(internal::tensor_file_scalar<Scalar>::value != internal::TensorFileUnknown,
+                      THIS_TYPE_IS_NOT_SUPPORTED);
+  eigen_assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && "alignment must be a power of 2");
+
+  Evaluator tensor(static_cast<const T&>(expr), DefaultDevice());
+  tensor.evalSubExprsIfNeeded(NULL);
+  if (tensor.data() != NULL) {
+    const bool ok = internal::tensor_file_write(os, tensor, alignment);
+    tensor.cleanup();
+    return ok;
+  }
+  tensor.cleanup();
+
+  // Evaluate the expression
+  typedef TensorEvaluator<const TensorForcedEvalOp<const T>, DefaultDevice> ForcedEvaluator;
+  TensorForcedEvalOp<const T> eval = expr.eval();
+  ForcedEvaluator forced(eval, DefaultDevice());
+  forced.evalSubExprsIfNeeded(NULL);
+  const bool ok = internal::tensor_file_write(os, forced, alignment);
+  forced.cleanup();
+  return ok;
+}
+
+/** Reads a tensor written by writeTensor() from \a is into \a tensor, which
+  * is resized. Returns false if the data is not a tensor with the scalar type,
+  * rank and layout of \a tensor.
+  *
+  * \sa writeTensor(), loadTensor()
+  */
+template <typename Scalar, int NumIndices, int Options, typename IndexType>
+bool readTensor(std::istream& is, Tensor<Scalar, NumIndices, Options, IndexType>& tensor) {
+  typedef Tensor<Scalar, NumIndices, Options, IndexType> TensorType;
+  internal::TensorFileHeader header;
+  numext::uint64_t dims[NumIndices > 0 ? NumIndices : 1];
+  if (!is.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.rank != static_cast<numext::uint32_t>(NumIndices) ||
+      !is.read(reinterpret_cast<char*>(dims), sizeof(numext::uint64_t) * NumIndices)) {
+    return false;
+  }
+  array<IndexType, NumIndices> dimensions;
+  numext::uint64_t size;
+  if (!internal::tensor_file_check<TensorType>(header, dims, dimensions, size) ||
+      !is.ignore(header.data_offset - sizeof(header) - sizeof(numext::uint64_t) * NumIndices)) {
+    return false;
+  }
+  // Do not trust the header with the allocation if the stream is known to be too short.
+  const std::streampos pos = is.tellg();
+  if (pos != std::streampos(-1)) {
+    is.seekg(0, std::ios::end);
+    const std::streampos end = is.tellg();
+    is.clear();
+    is.seekg(pos);
+    if (end != std::streampos(-1) && static_cast<numext::uint64_t>(end - pos) < sizeof(Scalar) * size) {
+      return false;
+    }
+  }
+  tensor.resize(dimensions);
+  return static_cast<bool>(is.read(reinterpret_cast<char*>(tensor.data()), sizeof(Scalar) * size));
+}
+
+/** Writes the evaluation of \a expr to the file \a filename with writeTensor(). */
+template <typename T>
+bool saveTensor(const TensorBase<T, ReadOnlyAccessors>& expr, const std::string& filename, std::size_t alignment = 64) {
+  std::ofstream out(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!out) {
+    return false;
+  }
+  return writeTensor(out, expr, alignment);
+}
+
+/** Reads the file \a filename written by saveTensor() into \a tensor with readTensor(). */
+template <typename Scalar, int NumIndices, int Options, typename IndexType>
+bool loadTensor(Tensor<Scalar, NumIndices, Options, IndexType>& tensor, const std::string& filename) {
+  std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  return readTensor(in, tensor);
+}
+
 } // end namespace Eigen
 
 #endif // EIGEN_CXX11_TENSOR_TENSOR_IO_H
@@ -215,6 +215,112 @@ EIGEN_STRONG_INLINE Index AdjustBlockSize(Index item_size, Index block_size) {
   return items_per_cacheline * divup(block_size, items_per_cacheline);
 }
 
+// Reduces the coefficients [first, last) of a scan line with unit stride,
+// i.e. computes the accumulator that the scan of the chunk ends with when it
+// starts from the identity.
+template <typename Self, bool Vectorize>
+struct ReduceChunk {
+  EIGEN_STRONG_INLINE typename Self::CoeffReturnType operator()(Self& self, Index first, Index last) {
+    typename Self::CoeffReturnType accum = self.accumulator().initialize();
+    for (Index curr = first; curr < last; ++curr) {
+      self.accumulator().reduce(self.inner().coeff(curr), &accum);
+    }
+    return accum;
+  }
+};
+
+// Specialization for vectorized reduction.
+template <typename Self>
+struct ReduceChunk<Self, /*Vectorize=*/true> {
+  EIGEN_STRONG_INLINE typename Self::CoeffReturnType operator()(Self& self, Index first, Index last) {
+    using Packet = typename Self::PacketReturnType;
+    const int PacketSize = internal::unpacket_traits<Packet>::size;
+    Packet vaccum = self.accumulator().template initializePacket<Packet>();
+    Index curr = first;
+    for (; curr + PacketSize <= last; curr += PacketSize) {
+      self.accumulator().reducePacket(self.inner().template packet<Unaligned>(curr), &vaccum);
+    }
+    typename Self::CoeffReturnType accum = self.accumulator().initialize();
+    for (; curr < last; ++curr) {
+      self.accumulator().reduce(self.inner().coeff(curr), &accum);
+    }
+    return self.accumulator().finalizeBoth(accum, vaccum);
+  }
+};
+
+// Computes the scan of the coefficients [first, last) of a scan line with
+// unit stride, starting from the accumulator of the coefficients before first.
+template <typename Self>
+EIGEN_STRONG_INLINE void ScanChunk(Self& self, Index first, Index last,
+                                   typename Self::CoeffReturnType accum,
+                                   typename Self::CoeffReturnType* data) {
+  if (self.exclusive()) {
+    for (Index curr = first; curr < last; ++curr) {
+      data[curr] = self.accumulator().finalize(accum);
+      self.accumulator().reduce(self.inner().coeff(curr), &accum);
+    }
+  } else {
+    for (Index curr = first; curr < last; ++curr) {
+      self.accumulator().reduce(self.inner().coeff(curr), &accum);
+      data[curr] = self.accumulator().finalize(accum);
+    }
+  }
+}
+
+// Two-pass blocked scan of lines with unit stride, used when there are too
+// few lines to keep the threads busy: the chunks of each line are reduced in
+// parallel, the chunk results are scanned to get the accumulator each chunk
+// starts with, and the chunks are then scanned in parallel. This requires the
+// reducer to be associative and stateless.
+template <typename Self, bool Vectorize>
+struct BlockedScan {
+  void operator()(Self& self, typename Self::CoeffReturnType* data, Index num_lines, Index chunk_size) {
+    using Scalar = typename Self::CoeffReturnType;
+    const Index num_chunks = divup(self.size(), chunk_size);
+    const Index num_tasks = num_lines * num_chunks;
+    Scalar* partials = static_cast<Scalar*>(self.device().allocate(num_tasks * sizeof(Scalar)));
+
+    // Maps a task to its range [first, last) of the output.
+    auto range = [&](Index task, Index* first, Index* last) {
+      const Index line = task / num_chunks;
+      *first = line * self.size() + (task % num_chunks) * chunk_size;
+      *last = numext::mini(*first + chunk_size, (line + 1) * self.size());
+    };
+
+    self.device().parallelFor(
+        num_tasks, TensorOpCost(chunk_size * sizeof(Scalar), 0, chunk_size, Vectorize,
+                                internal::unpacket_traits<typename Self::PacketReturnType>::size),
+        [&](Index first_task, Index last_task) {
+          for (Index task = first_task; task < last_task; ++task) {
+            Index first, last;
+            range(task, &first, &last);
+            partials[task] = ReduceChunk<Self, Vectorize>()(self, first, last);
+          }
+        });
+
+    // Exclusive scan of the chunk results of each line.
+    for (Index line = 0; line < num_lines; ++line) {
+      Scalar accum = self.accumulator().initialize();
+      for (Index chunk = 0; chunk < num_chunks; ++chunk) {
+        const Scalar partial = partials[line * num_chunks + chunk];
+        partials[line * num_chunks + chunk] = accum;
+        self.accumulator().reduce(partial, &accum);
+      }
+    }
+
+    self.device().parallelFor(
+        num_tasks, TensorOpCost(chunk_size * sizeof(Scalar), chunk_size * sizeof(Scalar), 16 * chunk_size),
+        [&](Index first_task, Index last_task) {
+          for (Index task = first_task; task < last_task; ++task) {
+            Index first, last;
+            range(task, &first, &last);
+            ScanChunk(self, first, last, partials[task], data);
+          }
+        });
+    self.device().deallocate(partials);
+  }
+};
+
 template <typename Self>
 struct ReduceBlock<Self, /*Vectorize=*/true, /*Parallel=*/true> {
   EIGEN_STRONG_INLINE void operator()(Self& self, Index idx1,
@@ -290,6 +396,19 @@ struct ScanLauncher<Self, Reducer, ThreadPoolDevice, Vectorize> {
     const Index inner_block_size = self.stride() * self.size();
     bool parallelize_by_outer_blocks = (total_size >= (self.stride() * inner_block_size));
 
+    // Lines with unit stride that are too few to be spread over the threads,
+    // e.g. a single long 1-D scan, are split in chunks instead.
+    const Index kMinChunkSize = 16384;
+    const Index num_lines = total_size / inner_block_size;
+    if (self.stride() == 1 && !internal::reducer_traits<Reducer, ThreadPoolDevice>::IsStateful &&
+        num_lines < self.device().numThreads() && self.size() >= 2 * kMinChunkSize) {
+      const Index chunk_size = AdjustBlockSize(
+          sizeof(Scalar), numext::maxi<Index>(kMinChunkSize, divup<Index>(self.size(), 4 * self.device().numThreads())));
+      BlockedScan<Self, Vectorize> scan;
+      scan(self, data, num_lines, chunk_size);
+      return;
+    }
+
     if ((parallelize_by_outer_blocks && total_size <= 4096) ||
         (!parallelize_by_outer_blocks && self.stride() < PacketSize)) {
       ScanLauncher<Self, Reducer, DefaultDevice, Vectorize> launcher;
@@ -0,0 +1,360 @@
+// This file is part of Eigen, a lightweight C++ template library
+// for linear algebra.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef EIGEN_SELLMATRIX_H
+#define EIGEN_SELLMATRIX_H
+
+namespace Eigen {
+
+template<typename _Scalar, typename _StorageIndex=int> class SellMatrix;
+
+namespace internal {
+
+// SellMatrix looks like a row-major SparseMatrix to the rest of Eigen, and in particular to the iterative solvers.
+// It does not expose compressed storage arrays though, hence the CompressedAccessBit is removed.
+template<typename _Scalar, typename _StorageIndex>
+struct traits<SellMatrix<_Scalar,_StorageIndex> > : traits<SparseMatrix<_Scalar,RowMajor,_StorageIndex> >
+{
+  enum {
+    Flags = traits<SparseMatrix<_Scalar,RowMajor,_StorageIndex> >::Flags & ~CompressedAccessBit
+  };
+};
+
+// Loads the packet { x[indices[0]], ..., x[indices[size-1]] }
+template<typename Packet, typename Scalar, typename StorageIndex>
+EIGEN_STRONG_INLINE Packet sell_gather(const Scalar* x, const StorageIndex* indices)
+{
+  enum { Size = unpacket_traits<Packet>::size };
+  EIGEN_ALIGN_MAX Scalar buffer[Size];
+  for(int l=0; l<Size; ++l)
+    buffer[l] = x[indices[l]];
+  return pload<Packet>(buffer);
+}
+
+#if defined(EIGEN_VECTORIZE_AVX512)
+template<> EIGEN_STRONG_INLINE Packet16f sell_gather<Packet16f,float,int>(const float* x, const int* indices)
+{
+  return _mm512_i32gather_ps(_mm512_loadu_si512(reinterpret_cast<const void*>(indices)), x, 4);
+}
+template<> EIGEN_STRONG_INLINE Packet8d sell_gather<Packet8d,double,int>(const double* x, const int* indices)
+{
+  return _mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices)), x, 8);
+}
+#elif defined(EIGEN_VECTORIZE_AVX2)
+template<> EIGEN_STRONG_INLINE Packet8f sell_gather<Packet8f,float,int>(const float* x, const int* indices)
+{
+  return _mm256_i32gather_ps(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices)), 4);
+}
+template<> EIGEN_STRONG_INLINE Packet4d sell_gather<Packet4d,double,int>(const double* x, const int* indices)
+{
+  return _mm256_i32gather_pd(x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices)), 8);
+}
+#endif
+
+} // end namespace internal
+
+/** \ingroup SparseExtra_Module
+  * \class SellMatrix
+  *
+  * \brief A sparse matrix stored in the SELL-C-sigma format for vectorized matrix-vector products
+  *
+  * \tparam _Scalar the scalar type
+  * \tparam _StorageIndex the type of the column indices
+  *
+  * The rows are grouped into chunks of C consecutive rows, C being the packet size of \a _Scalar. Each chunk is
+  * stored column by column, its rows being padded with zeros to the length of its longest row, so that a product
+  * with a dense vector processes a whole chunk with packet loads and multiply-adds, the entries of the vector
+  * being gathered with the gather instructions of AVX2 or AVX512 when available.
+  * To limit the padding, the rows are sorted by decreasing number of non zeros within windows of \c sigma rows.
+  * A value of \c sigma equal to 1 disables the sorting, a value equal to the number of rows minimizes the padding
+  * at the price of locality in the destination vector.
+  *
+  * The matrix is built from any sparse expression and is read-only. It supports products with dense vectors and
+  * matrices, which are computed in parallel over the chunks when multi-threading is enabled, and can be used as the
+  * matrix type of ConjugateGradient (with the \c Lower|Upper mode only) or BiCGSTAB, together with
+  * IdentityPreconditioner or DiagonalPreconditioner:
+  * \code
+  * SparseMatrix<double> A = ...;
+  * SellMatrix<double> S(A);
+  * ConjugateGradient<SellMatrix<double>, Lower|Upper> cg(S);
+  * x = cg.solve(b);
+  * \endcode
+  *
+  * \sa SparseMatrix, BlockSparseMatrix
+  */
+template<typename _Scalar, typename _StorageIndex>
+class SellMatrix : public EigenBase<SellMatrix<_Scalar,_StorageIndex> >
+{
+  public:
+    typedef _Scalar Scalar;
+    typedef typename NumTraits<Scalar>::Real RealScalar;
+    typedef _StorageIndex StorageIndex;
+    typedef typename internal::packet_traits<Scalar>::type Packet;
+    enum {
+      ChunkHeight = internal::unpacket_traits<Packet>::size,
+      ColsAtCompileTime = Dynamic,
+      MaxColsAtCompileTime = Dynamic,
+      IsRowMajor = true
+    };
+
+    class InnerIterator;
+
+    /** Default constructor, creates an empty matrix */
+    SellMatrix() : m_rows(0), m_cols(0), m_nonZeros(0), m_sigma(1) {}
+
+    /** Converts the sparse expression \a other, sorting its rows within windows of \a sigma rows */
+    template<typename OtherDerived>
+    explicit SellMatrix(const SparseMatrixBase<OtherDerived>& other, Index sigma = 32*ChunkHeight)
+      : m_rows(0), m_cols(0), m_nonZeros(0), m_sigma(1)
+    {
+      assign(other, sigma);
+    }
+
+    template<typename OtherDerived>
+    SellMatrix& operator=(const SparseMatrixBase<OtherDerived>& other)
+    {
+      return assign(other, m_sigma>1 ? m_sigma : Index(32*ChunkHeight));
+    }
+
+    /** Converts the sparse expression \a other, sorting its rows within windows of \a sigma rows */
+    template<typename OtherDerived>
+    SellMatrix& assign(const SparseMatrixBase<OtherDerived>& other, Index sigma);
+
+    Index rows() const { return m_rows; }
+    Index cols() const { return m_cols; }
+    Index outerSize() const { return m_rows; }
+    Index innerSize() const { return m_cols; }
+    /** \returns the number of non zeros, padding excluded */
+    Index nonZeros() const { return m_nonZeros; }
+    /** \returns the number of stored entries, padding included */
+    Index storedEntries() const { return m_values.size(); }
+    /** \returns the size of the windows within which the rows are sorted */
+    Index sigma() const { return m_sigma; }
+
+    /** \returns an expression of the product of \c *this with the dense expression \a x */
+    template<typename Rhs>
+    Product<SellMatrix,Rhs,AliasFreeProduct> operator*(const MatrixBase<Rhs>& x) const
+    {
+      return Product<SellMatrix,Rhs,AliasFreeProduct>(*this, x.derived());
+    }
+
+    /** \internal Accumulates \a alpha * \c *this * \a rhs into \a dst, for the chunks \a begin to \a end */
+    template<typename Dest, typename Rhs>
+    void scaleAndAddTo(Dest& dst, const Rhs& rhs, const Scalar& alpha, Index begin, Index end) const;
+
+    /** \internal \returns the first chunk processed by the task \a t out of \a tasks, balancing the stored entries */
+    Index chunkPartition(Index t, Index tasks) const
+    {
+      Index chunks = m_chunkStart.size()-1;
+      if(t==tasks) return chunks;
+      Index target = (Index(m_chunkStart(chunks))*t)/tasks;
+      return std::lower_bound(m_chunkStart.data(), m_chunkStart.data()+chunks, StorageIndex(target)) - m_chunkStart.data();
+    }
+
+  protected:
+    Index m_rows;
+    Index m_cols;
+    Index m_nonZeros;
+    Index m_sigma;
+    Matrix<StorageIndex,Dynamic,1> m_chunkStart;  // offset of each chunk in m_values, with a trailing total
+    Matrix<StorageIndex,Dynamic,1> m_chunkLength; // number of stored columns of each chunk
+    Matrix<StorageIndex,Dynamic,1> m_slotRow;     // row stored in each slot, or -1 for the padding rows of the last chunk
+    Matrix<StorageIndex,Dynamic,1> m_rowSlot;     // slot of each row
+    Matrix<StorageIndex,Dynamic,1> m_rowLength;   // number of non zeros of each slot
+    Matrix<StorageIndex,Dynamic,1> m_indices;
+    Matrix<Scalar,Dynamic,1> m_values;
+
+    struct LongerRow
+    {
+      explicit LongerRow(const StorageIndex* lengths) : m_lengths(lengths) {}
+      bool operator()(StorageIndex a, StorageIndex b) const { return m_lengths[a] > m_lengths[b]; }
+      const StorageIndex* m_lengths;
+    };
+};
+
+/** \class SellMatrix::InnerIterator
+  * \brief Iterates over the non zeros of a row, in increasing column order, padding excluded
+  */
+template<typename Scalar, typename StorageIndex>
+class SellMatrix<Scalar,StorageIndex>::InnerIterator
+{
+  public:
+    InnerIterator(const SellMatrix& mat, Index row)
+      : m_row(row)
+    {
+      Index slot = mat.m_rowSlot(row);
+      Index offset = mat.m_chunkStart(slot/ChunkHeight) + slot%ChunkHeight;
+      m_values = mat.m_values.data() + offset;
+      m_indices = mat.m_indices.data() + offset;
+      m_end = mat.m_rowLength(slot);
+      m_k = 0;
+    }
+
+    InnerIterator& operator++() { ++m_k; return *this; }
+    const Scalar& value() const { return m_values[m_k*ChunkHeight]; }
+    StorageIndex index() const { return m_indices[m_k*ChunkHeight]; }
+    Index row() const { return m_row; }
+    Index col() const { return index(); }
+    Index outer() const { return m_row; }
+    operator bool() const { return m_k < m_end; }
+
+  protected:
+    const Scalar* m_values;
+    const StorageIndex* m_indices;
+    Index m_row;
+    Index m_k;
+    Index m_end;
+};
+
+template<typename Scalar, typename StorageIndex>
+template<typename OtherDerived>
+SellMatrix<Scalar,StorageIndex>& SellMatrix<Scalar,StorageIndex>::assign(const SparseMatrixBase<OtherDerived>& other, Index sigma)
+{
+  eigen_assert(sigma>=1);
+  const SparseMatrix<Scalar,RowMajor,StorageIndex> mat(other.derived());
+  m_rows = mat.rows();
+  m_cols = mat.cols();
+  m_nonZeros = mat.nonZeros();
+  m_sigma = sigma;
+
+  const Index chunks = (m_rows+ChunkHeight-1)/ChunkHeight;
+  const Index slots = chunks*ChunkHeight;
+  Matrix<StorageIndex,Dynamic,1> lengths(m_rows);
+  for(Index i=0; i<m_rows; ++i)
+    lengths(i) = StorageIndex(mat.outerIndexPtr()[i+1] - mat.outerIndexPtr()[i]);
+
+  // sort the rows by decreasing length within each window of sigma rows
+  m_slotRow.setConstant(slots, -1);
+  for(Index i=0; i<m_rows; ++i)
+    m_slotRow(i) = StorageIndex(i);
+  for(Index w=0; w<m_rows; w+=sigma)
+    std::stable_sort(m_slotRow.data()+w, m_slotRow.data()+numext::mini(w+sigma, m_rows), LongerRow(lengths.data()));
+  m_rowSlot.resize(m_rows);
+  m_rowLength.setZero(slots);
+  for(Index s=0; s<m_rows; ++s)
+  {
+    m_rowSlot(m_slotRow(s)) = StorageIndex(s);
+    m_rowLength(s) = lengths(m_slotRow(s));
+  }
+
+  m_chunkStart.resize(chunks+1);
+  m_chunkLength.resize(chunks);
+  m_chunkStart(0) = 0;
+  for(Index c=0; c<chunks; ++c)
+  {
+    m_chunkLength(c) = m_rowLength.segment(c*ChunkHeight, ChunkHeight).maxCoeff();
+    m_chunkStart(c+1) = m_chunkStart(c) + m_chunkLength(c)*ChunkHeight;
+  }
+
+  // The padding entries have a zero value and point to the last column stored in their row, so that they can be
+  // processed as the others without reading entries of the vector that the row does not already depend on.
+  // The empty rows point to the column 0 and their results are discarded by scaleAndAddTo.
+  m_values.setZero(m_chunkStart(chunks));
+  m_indices.setZero(m_chunkStart(chunks));
+  for(Index s=0; s<m_rows; ++s)
+  {
+    Index offset = m_chunkStart(s/ChunkHeight) + s%ChunkHeight;
+    Index k = 0;
+    for(typename SparseMatrix<Scalar,RowMajor,StorageIndex>::InnerIterator it(mat, m_slotRow(s)); it; ++it, ++k)
+    {
+      m_values(offset + k*ChunkHeight) = it.value();
+      m_indices(offset + k*ChunkHeight) = it.index();
+    }
+    for(Index length = m_chunkLength(s/ChunkHeight); k>0 && k<length; ++k)
+      m_indices(offset + k*ChunkHeight) = m_indices(offset + (k-1)*ChunkHeight);
+  }
+  return *this;
+}
+
+template<typename Scalar, typename StorageIndex>
+template<typename Dest, typename Rhs>
+void SellMatrix<Scalar,StorageIndex>::scaleAndAddTo(Dest& dst, const Rhs& rhs, const Scalar& alpha, Index begin, Index end) const
+{
+  EIGEN_ALIGN_MAX Scalar acc[ChunkHeight];
+  for(Index j=0; j<rhs.cols(); ++j)
+  {
+    const Scalar* x = rhs.col(j).data();
+    for(Index c=begin; c<end; ++c)
+    {
+      const Scalar* values = m_values.data() + m_chunkStart(c);
+      const StorageIndex* indices = m_indices.data() + m_chunkStart(c);
+      Packet p0 = internal::pset1<Packet>(Scalar(0));
+      Packet p1 = internal::pset1<Packet>(Scalar(0));
+      const Index length = m_chunkLength(c);
+      Index k = 0;
+      // two accumulators to hide the latency of the multiply-adds
+      for(; k+1<length; k+=2)
+      {
+        p0 = internal::pmadd(internal::pload<Packet>(values + k*ChunkHeight),
+                             internal::sell_gather<Packet>(x, indices + k*ChunkHeight), p0);
+        p1 = internal::pmadd(internal::pload<Packet>(values + (k+1)*ChunkHeight),
+                             internal::sell_gather<Packet>(x, indices + (k+1)*ChunkHeight), p1);
+      }
+      if(k<length)
+        p0 = internal::pmadd(internal::pload<Packet>(values + k*ChunkHeight),
+                             internal::sell_gather<Packet>(x, indices + k*ChunkHeight), p0);
+      internal::pstore(acc, internal::padd(p0, p1));
+      for(Index l=0; l<ChunkHeight; ++l)
+      {
+        StorageIndex row = m_slotRow(c*ChunkHeight+l);
+        if(row>=0 && m_rowLength(c*ChunkHeight+l)>0)
+          dst.coeffRef(row, j) += alpha * acc[l];
+      }
+    }
+  }
+}
+
+namespace internal {
+
+template<typename Scalar, typename StorageIndex, typename Rhs, typename Dest>
+struct sell_product_task
+{
+  typedef SellMatrix<Scalar,StorageIndex> Lhs;
+  sell_product_task(const Lhs& lhs, const Rhs& rhs, Dest& dst, const Scalar& alpha, Index tasks)
+    : m_lhs(lhs), m_rhs(rhs), m_dst(dst), m_alpha(alpha), m_tasks(tasks)
+  {}
+  void operator()(Index t) const
+  {
+    m_lhs.scaleAndAddTo(m_dst, m_rhs, m_alpha, m_lhs.chunkPartition(t, m_tasks), m_lhs.chunkPartition(t+1, m_tasks));
+  }
+  const Lhs& m_lhs;
+  const Rhs& m_rhs;
+  Dest& m_dst;
+  const Scalar& m_alpha;
+  Index m_tasks;
+};
+
+template<typename Scalar, typename StorageIndex, typename Rhs, int ProductType>
+struct generic_product_impl<SellMatrix<Scalar,StorageIndex>, Rhs, SparseShape, DenseShape, ProductType>
+  : generic_product_impl_base<SellMatrix<Scalar,StorageIndex>, Rhs, generic_product_impl<SellMatrix<Scalar,StorageIndex>, Rhs, SparseShape, DenseShape, ProductType> >
+{
+  typedef SellMatrix<Scalar,StorageIndex> Lhs;
+
+  template<typename Dest>
+  static void scaleAndAddTo(Dest& dst, const Lhs& lhs, const Rhs& rhs, const Scalar& alpha)
+  {
+    // the kernel requires contiguous columns of the rhs
+    typedef Ref<const Matrix<Scalar,Dynamic,Dynamic> > ActualRhs;
+    ActualRhs actualRhs(rhs);
+    Index chunks = lhs.chunkPartition(1,1);
+    Index threads = sparse_dense_product_threads(lhs.storedEntries()*rhs.cols());
+    if(threads>1)
+    {
+      // chunks write to disjoint rows of the destination; more tasks than threads so that they are dynamically balanced
+      Index tasks = numext::mini<Index>(threads*4, chunks);
+      parallelize_tasks(tasks, sell_product_task<Scalar,StorageIndex,ActualRhs,Dest>(lhs, actualRhs, dst, alpha, tasks));
+    }
+    else
+      lhs.scaleAndAddTo(dst, actualRhs, alpha, 0, chunks);
+  }
+};
+
+} // end namespace internal
+
+} // end namespace Eigen
+
+#endif // EIGEN_SELLMATRIX_H
@@ -273,6 +273,55 @@ static void test_argmin_dim()
   }
 }
 
+template <int DataLayout, typename Scalar>
+static void test_argmax_argmin_ties()
+{
+  // Long enough for the vectorized reduction of the innermost dimension to
+  // split its runs in several chunks and to leave a scalar tail.
+  const int inner_dim = DataLayout == ColMajor ? 0 : 1;
+  array<DenseIndex, 2> dims;
+  dims[inner_dim] = 20011;
+  dims[1 - inner_dim] = 3;
+  Tensor<Scalar, 2, DataLayout> tensor(dims);
+  tensor.setRandom();
+  // Few distinct values, so that the ties are broken on the smallest index,
+  // and NaNs that are never selected.
+  tensor = (tensor * Scalar(4)).floor();
+  tensor.data()[0] = std::numeric_limits<Scalar>::quiet_NaN();
+  tensor.data()[12345] = std::numeric_limits<Scalar>::quiet_NaN();
+
+  Tensor<DenseIndex, 1, DataLayout> tensor_argmax = tensor.argmax(inner_dim);
+  Tensor<DenseIndex, 1, DataLayout> tensor_argmin = tensor.argmin(inner_dim);
+  Tensor<DenseIndex, 0, DataLayout> full_argmax = tensor.argmax();
+  Tensor<DenseIndex, 0, DataLayout> full_argmin = tensor.argmin();
+
+  DenseIndex full_max = 0, full_min = 0;
+  for (DenseIndex n = 0; n < dims[1 - inner_dim]; ++n) {
+    DenseIndex max_index = 0, min_index = 0;
+    for (DenseIndex i = 0; i < dims[inner_dim]; ++i) {
+      const Scalar value = tensor.data()[n * dims[inner_dim] + i];
+      if (value > tensor.data()[n * dims[inner_dim] + max_index] ||
+          (numext::isnan)(tensor.data()[n * dims[inner_dim] + max_index])) {
+        max_index = i;
+      }
+      if (value < tensor.data()[n * dims[inner_dim] + min_index] ||
+          (numext::isnan)(tensor.data()[n * dims[inner_dim] + min_index])) {
+        min_index = i;
+      }
+    }
+    VERIFY_IS_EQUAL(tensor_argmax(n), max_index);
+    VERIFY_IS_EQUAL(tensor_argmin(n), min_index);
+    if (n == 0 || tensor.data()[n * dims[inner_dim] + max_index] > tensor.data()[full_max]) {
+      full_max = n * dims[inner_dim] + max_index;
+    }
+    if (n == 0 || tensor.data()[n * dims[inner_dim] + min_index] < tensor.data()[full_min]) {
+      full_min = n * dims[inner_dim] + min_index;
+    }
+  }
+  VERIFY_IS_EQUAL(full_argmax(), full_max);
+  VERIFY_IS_EQUAL(full_argmin(), full_min);
+}
+
 EIGEN_DECLARE_TEST(cxx11_tensor_argmax)
 {
   CALL_SUBTEST(test_simple_index_tuples<RowMajor>());
@@ -291,4 +340,8 @@ EIGEN_DECLARE_TEST(cxx11_tensor_argmax)
   CALL_SUBTEST(test_argmax_dim<ColMajor>());
   CALL_SUBTEST(test_argmin_dim<RowMajor>());
   CALL_SUBTEST(test_argmin_dim<ColMajor>());
+  CALL_SUBTEST((test_argmax_argmin_ties<RowMajor, float>()));
+  CALL_SUBTEST((test_argmax_argmin_ties<ColMajor, float>()));
+  CALL_SUBTEST((test_argmax_argmin_ties<RowMajor, double>()));
+  CALL_SUBTEST((test_argmax_argmin_ties<ColMajor, double>()));
 }
@@ -560,6 +560,30 @@ static void test_large_contraction_with_output_kernel() {
   }
 }
 
+// Contractions of 8-bit tensors cast to int go through dedicated kernels and must be exact.
+template <int DataLayout>
+static void test_int8_contraction() {
+  Tensor<int8_t, 3, DataLayout> t_left(23, 7, 19);
+  Tensor<uint8_t, 3, DataLayout> t_right(7, 19, 31);
+  t_left.setRandom();
+  t_right.setRandom();
+  t_left(0, 0, 0) = -128;
+  t_right(0, 0, 0) = 255;
+
+  Tensor<int, 3, DataLayout> i_left = t_left.template cast<int>();
+  Tensor<int, 3, DataLayout> i_right = t_right.template cast<int>();
+
+  Eigen::array<DimPair, 2> dims({{DimPair(1, 0), DimPair(2, 1)}});
+  Tensor<int, 2, DataLayout> expected = i_left.contract(i_right, dims);
+  Tensor<int, 2, DataLayout> result = t_left.template cast<int>().contract(t_right.template cast<int>(), dims);
+
+  VERIFY_IS_EQUAL(result.dimension(0), expected.dimension(0));
+  VERIFY_IS_EQUAL(result.dimension(1), expected.dimension(1));
+  for (Index i = 0; i < result.size(); i++) {
+    VERIFY_IS_EQUAL(result.data()[i], expected.data()[i]);
+  }
+}
+
 EIGEN_DECLARE_TEST(cxx11_tensor_contraction)
 {
   CALL_SUBTEST_1(test_evals<ColMajor>());
@@ -594,6 +618,8 @@ EIGEN_DECLARE_TEST(cxx11_tensor_contraction)
   CALL_SUBTEST_8(test_const_inputs<RowMajor>());
   CALL_SUBTEST_8(test_large_contraction_with_output_kernel<ColMajor>());
   CALL_SUBTEST_8(test_large_contraction_with_output_kernel<RowMajor>());
+  CALL_SUBTEST_9(test_int8_contraction<ColMajor>());
+  CALL_SUBTEST_9(test_int8_contraction<RowMajor>());
 
   // Force CMake to split this test.
   // EIGEN_SUFFIXES;1;2;3;4;5;6;7;8
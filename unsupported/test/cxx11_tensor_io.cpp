@@ -8,9 +8,12 @@
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include "main.h"
+#include <cstdio>
+#include <fstream>
 #include <sstream>
 #include <string>
 #include <Eigen/CXX11/Tensor>
+#include <Eigen/CXX11/TensorFileMapping>
 
 
 template<int DataLayout>
@@ -119,6 +122,128 @@ static void test_output_const()
 }
 
 
+template<int DataLayout>
+static void test_binary_roundtrip()
+{
+  Tensor<float, 3, DataLayout> tensor(2, 3, 7);
+  tensor.setRandom();
+
+  std::stringstream ss;
+  VERIFY(writeTensor(ss, tensor));
+  Tensor<float, 3, DataLayout> result;
+  VERIFY(readTensor(ss, result));
+  VERIFY_IS_EQUAL(result.dimension(0), 2);
+  VERIFY_IS_EQUAL(result.dimension(1), 3);
+  VERIFY_IS_EQUAL(result.dimension(2), 7);
+  for (int i = 0; i < tensor.size(); ++i) {
+    VERIFY_IS_EQUAL(result.data()[i], tensor.data()[i]);
+  }
+
+  // Expressions are evaluated, and the format checks the scalar type, rank
+  // and layout of the tensor it is read into.
+  Tensor<int, 1, DataLayout> ints(5);
+  ints.setValues({1, 2, 3, 4, 5});
+  std::stringstream ss2;
+  VERIFY(writeTensor(ss2, ints * 2, 16));
+  Tensor<int, 1, DataLayout> ints2;
+  VERIFY(readTensor(ss2, ints2));
+  for (int i = 0; i < 5; ++i) {
+    VERIFY_IS_EQUAL(ints2(i), 2 * (i + 1));
+  }
+  ss2.seekg(0);
+  Tensor<float, 1, DataLayout> floats;
+  VERIFY(!readTensor(ss2, floats));
+  ss2.seekg(0);
+  Tensor<int, 2, DataLayout> ints3;
+  VERIFY(!readTensor(ss2, ints3));
+  ss2.seekg(0);
+  Tensor<int, 1, DataLayout == ColMajor ? RowMajor : ColMajor> ints4;
+  VERIFY(!readTensor(ss2, ints4));
+
+  // Slices are written in place when they are contiguous, and evaluated
+  // otherwise.
+  Tensor<float, 3, DataLayout> slice;
+  for (int k = 0; k < 2; ++k) {
+    array<Index, 3> offsets = {{0, 0, 2}};
+    array<Index, 3> extents = {{2, 3, 4}};
+    if (k == 1) {
+      offsets[DataLayout == ColMajor ? 0 : 2] = 1;
+      extents[DataLayout == ColMajor ? 0 : 2] = 1;
+    }
+    std::stringstream ss4;
+    VERIFY(writeTensor(ss4, tensor.slice(offsets, extents)));
+    VERIFY(readTensor(ss4, slice));
+    Tensor<float, 3, DataLayout> expected = tensor.slice(offsets, extents);
+    VERIFY_IS_EQUAL(slice.size(), expected.size());
+    for (int i = 0; i < expected.size(); ++i) {
+      VERIFY_IS_EQUAL(slice.data()[i], expected.data()[i]);
+    }
+  }
+
+  // A truncated stream is rejected before the tensor is resized.
+  std::string truncated = ss.str();
+  truncated.resize(truncated.size() - sizeof(float));
+  std::stringstream ss5(truncated);
+  Tensor<float, 3, DataLayout> result2;
+  VERIFY(!readTensor(ss5, result2));
+  VERIFY_IS_EQUAL(result2.size(), 0);
+
+  Tensor<std::complex<double>, 0, DataLayout> scalar;
+  scalar() = std::complex<double>(1, 2);
+  std::stringstream ss3;
+  VERIFY(writeTensor(ss3, scalar));
+  Tensor<std::complex<double>, 0, DataLayout> scalar2;
+  VERIFY(readTensor(ss3, scalar2));
+  VERIFY_IS_EQUAL(scalar2(), scalar());
+}
+
+template<int DataLayout>
+static void test_binary_file()
+{
+  Tensor<double, 2, DataLayout> tensor(31, 17);
+  tensor.setRandom();
+  const std::string filename = DataLayout == ColMajor ? "cxx11_tensor_io_col.bin" : "cxx11_tensor_io_row.bin";
+  VERIFY(saveTensor(tensor, filename));
+
+  Tensor<double, 2, DataLayout> result;
+  VERIFY(loadTensor(result, filename));
+  VERIFY_IS_EQUAL(result.dimension(0), 31);
+  VERIFY_IS_EQUAL(result.dimension(1), 17);
+  for (int i = 0; i < tensor.size(); ++i) {
+    VERIFY_IS_EQUAL(result.data()[i], tensor.data()[i]);
+  }
+
+#if EIGEN_OS_UNIX
+  TensorFileMapping file(filename);
+  VERIFY(file.isOpen());
+  VERIFY((file.isCompatible<Tensor<double, 2, DataLayout> >()));
+  VERIFY((!file.isCompatible<Tensor<float, 2, DataLayout> >()));
+  VERIFY((!file.isCompatible<Tensor<double, 3, DataLayout> >()));
+  TensorMap<const Tensor<double, 2, DataLayout>, Aligned> map = file.tensor<Tensor<double, 2, DataLayout> >();
+  VERIFY_IS_EQUAL(map.dimension(0), 31);
+  VERIFY_IS_EQUAL(map.dimension(1), 17);
+  VERIFY(internal::UIntPtr(map.data()) % EIGEN_MAX_ALIGN_BYTES == 0);
+  for (int i = 0; i < 31; ++i) {
+    for (int j = 0; j < 17; ++j) {
+      VERIFY_IS_EQUAL(map(i, j), tensor(i, j));
+    }
+  }
+  Tensor<double, 0, DataLayout> map_sum = map.sum();
+  Tensor<double, 0, DataLayout> sum = tensor.sum();
+  VERIFY_IS_APPROX(map_sum(), sum());
+  file.close();
+  VERIFY(!file.isOpen());
+
+  // Not a tensor file.
+  std::ofstream("cxx11_tensor_io_bad.bin") << "not a tensor, but long enough to hold a header";
+  VERIFY(!file.open("cxx11_tensor_io_bad.bin"));
+  VERIFY(!file.open("cxx11_tensor_io_missing.bin"));
+  std::remove("cxx11_tensor_io_bad.bin");
+#endif
+  std::remove(filename.c_str());
+}
+
+
 EIGEN_DECLARE_TEST(cxx11_tensor_io)
 {
   CALL_SUBTEST(test_output_0d<ColMajor>());
@@ -133,4 +258,8 @@ EIGEN_DECLARE_TEST(cxx11_tensor_io)
   CALL_SUBTEST(test_output_string<RowMajor>());
   CALL_SUBTEST(test_output_const<ColMajor>());
   CALL_SUBTEST(test_output_const<RowMajor>());
+  CALL_SUBTEST(test_binary_roundtrip<ColMajor>());
+  CALL_SUBTEST(test_binary_roundtrip<RowMajor>());
+  CALL_SUBTEST(test_binary_file<ColMajor>());
+  CALL_SUBTEST(test_binary_file<RowMajor>());
 }
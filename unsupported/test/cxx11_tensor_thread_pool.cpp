@@ -275,6 +275,37 @@ void test_multithread_contraction_agrees_with_singlethread() {
   }
 }
 
+template<int DataLayout>
+void test_multithread_int8_contraction() {
+  int contract_size = internal::random<int>(1, 5000);
+
+  Tensor<int8_t, 2, DataLayout> left(internal::random<int>(1, 80), contract_size);
+  Tensor<uint8_t, 3, DataLayout> right(contract_size,
+                                       internal::random<int>(1, 37),
+                                       internal::random<int>(1, 51));
+  left.setRandom();
+  right.setRandom();
+
+  typedef Tensor<float, 1>::DimensionPair DimPair;
+  Eigen::array<DimPair, 1> dims({{DimPair(1, 0)}});
+
+  Eigen::ThreadPool tp(internal::random<int>(2, 11));
+  Eigen::ThreadPoolDevice thread_pool_device(&tp, internal::random<int>(2, 11));
+
+  Tensor<int, 2, DataLayout> i_left = left.template cast<int>();
+  Tensor<int, 3, DataLayout> i_right = right.template cast<int>();
+  Tensor<int, 3, DataLayout> st_result;
+  st_result = i_left.contract(i_right, dims);
+
+  Tensor<int, 3, DataLayout> tp_result(st_result.dimensions());
+  tp_result.device(thread_pool_device) = left.template cast<int>().contract(right.template cast<int>(), dims);
+
+  VERIFY(dimensions_match(st_result.dimensions(), tp_result.dimensions()));
+  for (ptrdiff_t i = 0; i < st_result.size(); i++) {
+    VERIFY_IS_EQUAL(st_result.data()[i], tp_result.data()[i]);
+  }
+}
+
 // Apply Sqrt to all output elements.
 struct SqrtOutputKernel {
   template <typename Index, typename Scalar>
@@ -670,6 +701,189 @@ void test_threadpool_allocate(TestAllocator* allocator)
   VERIFY_IS_EQUAL(allocator->dealloc_count(), num_allocs);
 }
 
+template<int DataLayout, int FFTDir>
+void test_multithread_fft()
+{
+  const int num_threads = internal::random<int>(2, 11);
+  ThreadPool threads(num_threads);
+  Eigen::ThreadPoolDevice device(&threads, num_threads);
+
+  // A power of two and non power of two lengths, transformed along strided and
+  // contiguous axes.
+  Tensor<float, 3, DataLayout> input(internal::random<int>(1, 67), 32, internal::random<int>(1, 67));
+  input.setRandom();
+  array<ptrdiff_t, 3> fft = {{0, 1, 2}};
+
+  Tensor<std::complex<float>, 3, DataLayout> st_result = input.template fft<BothParts, FFTDir>(fft);
+  Tensor<std::complex<float>, 3, DataLayout> tp_result(input.dimensions());
+  tp_result.device(device) = input.template fft<BothParts, FFTDir>(fft);
+  Tensor<float, 3, DataLayout> tp_real(input.dimensions());
+  tp_real.device(device) = input.template fft<RealPart, FFTDir>(fft);
+
+  // The lines are transformed exactly as in the single threaded evaluation.
+  for (int i = 0; i < input.size(); ++i) {
+    VERIFY_IS_EQUAL(tp_result.data()[i], st_result.data()[i]);
+    VERIFY_IS_EQUAL(tp_real.data()[i], st_result.data()[i].real());
+  }
+}
+
+template<int DataLayout>
+void test_multithread_convolution()
+{
+  const int num_threads = internal::random<int>(2, 11);
+  ThreadPool threads(num_threads);
+  Eigen::ThreadPoolDevice device(&threads, num_threads);
+
+  // Convolution along non adjacent dimensions given out of order, of input
+  // and kernel expressions.
+  Tensor<float, 4, DataLayout> input(3, internal::random<int>(20, 70), 5, internal::random<int>(20, 70));
+  Tensor<float, 2, DataLayout> kernel(internal::random<int>(1, 11), internal::random<int>(1, 11));
+  input.setRandom();
+  kernel.setRandom();
+  array<ptrdiff_t, 2> dims = {{3, 1}};
+
+  Tensor<float, 4, DataLayout> st_result = (input * 2.0f).convolve(kernel + kernel, dims);
+  Tensor<float, 4, DataLayout> tp_result(st_result.dimensions());
+  tp_result.device(device) = (input * 2.0f).convolve(kernel + kernel, dims);
+  VERIFY_IS_APPROX(Map<ArrayXf>(tp_result.data(), tp_result.size()),
+                   Map<ArrayXf>(st_result.data(), st_result.size()));
+
+  // A 1D convolution within an expression.
+  Tensor<double, 1, DataLayout> input1(internal::random<int>(100, 1000));
+  Tensor<double, 1, DataLayout> kernel1(internal::random<int>(1, 30));
+  input1.setRandom();
+  kernel1.setRandom();
+  array<ptrdiff_t, 1> dims1 = {{0}};
+  Tensor<double, 1, DataLayout> st_result1 = input1.convolve(kernel1, dims1) * 3.0;
+  Tensor<double, 1, DataLayout> tp_result1(st_result1.dimensions());
+  tp_result1.device(device) = input1.convolve(kernel1, dims1) * 3.0;
+  VERIFY_IS_APPROX(Map<ArrayXd>(tp_result1.data(), tp_result1.size()),
+                   Map<ArrayXd>(st_result1.data(), st_result1.size()));
+
+  // An empty input.
+  Tensor<float, 2, DataLayout> empty_input(0, 10);
+  Tensor<float, 1, DataLayout> kernel2(internal::random<int>(1, 10));
+  kernel2.setRandom();
+  array<ptrdiff_t, 1> dims2 = {{1}};
+  Tensor<float, 2, DataLayout> empty_result(0, 11 - kernel2.size());
+  empty_result.device(device) = empty_input.convolve(kernel2, dims2);
+  VERIFY_IS_EQUAL(empty_result.dimension(0), 0);
+  VERIFY_IS_EQUAL(empty_result.dimension(1), 11 - kernel2.size());
+}
+
+template<int DataLayout>
+void test_multithread_fft_convolution()
+{
+  const int num_threads = internal::random<int>(2, 11);
+  ThreadPool threads(num_threads);
+  Eigen::ThreadPoolDevice device(&threads, num_threads);
+
+  // Large enough a kernel to be applied in the Fourier domain.
+  Tensor<float, 2, DataLayout> input(256, 250);
+  Tensor<float, 2, DataLayout> kernel(90, 100);
+  input.setRandom();
+  kernel.setRandom();
+  array<ptrdiff_t, 2> dims = {{1, 0}};
+
+  Tensor<float, 2, DataLayout> result(256 - 100 + 1, 250 - 90 + 1);
+  result.device(device) = input.convolve(kernel, dims);
+
+  VectorXf expected(100), actual(100);
+  for (int s = 0; s < 100; ++s) {
+    const int i = internal::random<int>(0, result.dimension(0) - 1);
+    const int j = internal::random<int>(0, result.dimension(1) - 1);
+    float sum = 0;
+    for (int k = 0; k < 90; ++k) {
+      for (int l = 0; l < 100; ++l) {
+        sum += input(i + l, j + k) * kernel(k, l);
+      }
+    }
+    expected(s) = sum;
+    actual(s) = result(i, j);
+  }
+  VERIFY_IS_APPROX(actual, expected);
+}
+
+template<int DataLayout>
+void test_multithread_argmax()
+{
+  const int num_threads = internal::random<int>(2, 11);
+  ThreadPool threads(num_threads);
+  Eigen::ThreadPoolDevice device(&threads, num_threads);
+
+  // Runs long enough to be reduced in several chunks, with many ties.
+  const int inner_dim = DataLayout == ColMajor ? 0 : 1;
+  array<Index, 2> dims;
+  dims[inner_dim] = internal::random<Index>(100000, 300000);
+  dims[1 - inner_dim] = internal::random<Index>(1, 5);
+  Tensor<float, 2, DataLayout> input(dims);
+  input.setRandom();
+  input = (input * 16.0f).floor();
+
+  Tensor<Index, 1, DataLayout> tp_argmax(dims[1 - inner_dim]);
+  Tensor<Index, 1, DataLayout> tp_argmin(dims[1 - inner_dim]);
+  Tensor<Index, 0, DataLayout> tp_full_argmax;
+  tp_argmax.device(device) = (input * 2.0f).argmax(inner_dim);
+  tp_argmin.device(device) = input.argmin(inner_dim);
+  tp_full_argmax.device(device) = input.argmax();
+
+  Index full_max = 0;
+  for (Index n = 0; n < dims[1 - inner_dim]; ++n) {
+    const float* run = input.data() + n * dims[inner_dim];
+    Index max_index = 0, min_index = 0;
+    for (Index i = 1; i < dims[inner_dim]; ++i) {
+      if (run[i] > run[max_index]) max_index = i;
+      if (run[i] < run[min_index]) min_index = i;
+    }
+    VERIFY_IS_EQUAL(tp_argmax(n), max_index);
+    VERIFY_IS_EQUAL(tp_argmin(n), min_index);
+    if (run[max_index] > input.data()[full_max]) full_max = n * dims[inner_dim] + max_index;
+  }
+  VERIFY_IS_EQUAL(tp_full_argmax(), full_max);
+}
+
+template<int DataLayout>
+void test_multithread_scan()
+{
+  const int num_threads = internal::random<int>(2, 11);
+  ThreadPool threads(num_threads);
+  Eigen::ThreadPoolDevice device(&threads, num_threads);
+
+  // Few lines, long enough to be scanned in several chunks.
+  const int scan_dim = DataLayout == ColMajor ? 0 : 1;
+  array<Index, 2> dims;
+  dims[scan_dim] = internal::random<Index>(40000, 300000);
+  dims[1 - scan_dim] = internal::random<Index>(1, 3);
+  const bool exclusive = internal::random<bool>();
+
+  Tensor<int, 2, DataLayout> ints(dims);
+  ints = ints.random().unaryExpr([](int x) { return x % 100; });
+  Tensor<int, 2, DataLayout> st_ints = ints.cumsum(scan_dim, exclusive);
+  Tensor<int, 2, DataLayout> tp_ints(dims);
+  tp_ints.device(device) = ints.cumsum(scan_dim, exclusive);
+  VERIFY_IS_EQUAL(Map<VectorXi>(tp_ints.data(), tp_ints.size()), Map<VectorXi>(st_ints.data(), st_ints.size()));
+
+  Tensor<float, 2, DataLayout> input(dims);
+  input.setRandom();
+  Tensor<float, 2, DataLayout> st_result = input.scan(scan_dim, internal::MaxReducer<float>(), exclusive);
+  Tensor<float, 2, DataLayout> tp_result(dims);
+  tp_result.device(device) = input.scan(scan_dim, internal::MaxReducer<float>(), exclusive);
+  VERIFY_IS_EQUAL(Map<VectorXf>(tp_result.data(), tp_result.size()), Map<VectorXf>(st_result.data(), st_result.size()));
+
+  // Products of factors close to 1, that stay representable.
+  Tensor<double, 2, DataLayout> factors(dims);
+  factors.setRandom();
+  factors = factors * 1e-4 + 1.0 - 0.5e-4;
+  Tensor<double, 2, DataLayout> st_prod = factors.cumprod(scan_dim, exclusive);
+  Tensor<double, 2, DataLayout> tp_prod(dims);
+  tp_prod.device(device) = factors.cumprod(scan_dim, exclusive);
+  VERIFY_IS_APPROX(Map<ArrayXd>(tp_prod.data(), tp_prod.size()), Map<ArrayXd>(st_prod.data(), st_prod.size()));
+
+  st_result = input.cumsum(scan_dim, exclusive);
+  tp_result.device(device) = input.cumsum(scan_dim, exclusive);
+  VERIFY_IS_APPROX(Map<ArrayXf>(tp_result.data(), tp_result.size()), Map<ArrayXf>(st_result.data(), st_result.size()));
+}
+
 EIGEN_DECLARE_TEST(cxx11_tensor_thread_pool)
 {
   CALL_SUBTEST_1(test_multithread_elementwise());
@@ -683,6 +897,8 @@ EIGEN_DECLARE_TEST(cxx11_tensor_thread_pool)
   CALL_SUBTEST_3(test_multithread_contraction_agrees_with_singlethread<RowMajor>());
   CALL_SUBTEST_3(test_multithread_contraction_with_output_kernel<ColMajor>());
   CALL_SUBTEST_3(test_multithread_contraction_with_output_kernel<RowMajor>());
+  CALL_SUBTEST_3(test_multithread_int8_contraction<ColMajor>());
+  CALL_SUBTEST_3(test_multithread_int8_contraction<RowMajor>());
 
   CALL_SUBTEST_4(test_async_multithread_contraction_agrees_with_singlethread<ColMajor>());
   CALL_SUBTEST_4(test_async_multithread_contraction_agrees_with_singlethread<RowMajor>());
@@ -716,6 +932,20 @@ EIGEN_DECLARE_TEST(cxx11_tensor_thread_pool)
   CALL_SUBTEST_11(test_multithread_shuffle<RowMajor>(&test_allocator));
   CALL_SUBTEST_11(test_threadpool_allocate(&test_allocator));
 
+  CALL_SUBTEST_12((test_multithread_fft<ColMajor, FFT_FORWARD>()));
+  CALL_SUBTEST_12((test_multithread_fft<RowMajor, FFT_REVERSE>()));
+
+  CALL_SUBTEST_13(test_multithread_convolution<ColMajor>());
+  CALL_SUBTEST_13(test_multithread_convolution<RowMajor>());
+  CALL_SUBTEST_13(test_multithread_fft_convolution<ColMajor>());
+  CALL_SUBTEST_13(test_multithread_fft_convolution<RowMajor>());
+
+  CALL_SUBTEST_14(test_multithread_argmax<ColMajor>());
+  CALL_SUBTEST_14(test_multithread_argmax<RowMajor>());
+
+  CALL_SUBTEST_15(test_multithread_scan<ColMajor>());
+  CALL_SUBTEST_15(test_multithread_scan<RowMajor>());
+
   // Force CMake to split this test.
-  // EIGEN_SUFFIXES;1;2;3;4;5;6;7;8;9;10;11
+  // EIGEN_SUFFIXES;1;2;3;4;5;6;7;8;9;10;11;12;13;14;15
 }
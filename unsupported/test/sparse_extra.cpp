@@ -187,6 +187,81 @@ void check_marketio_vector()
   VERIFY_IS_EQUAL(v1,v2);
 }
 
+template<typename Scalar, typename StorageIndex>
+void check_sell_matrix()
+{
+  typedef SparseMatrix<Scalar,ColMajor,StorageIndex> SparseMatrixType;
+  typedef Matrix<Scalar,Dynamic,Dynamic> DenseMatrix;
+  typedef Matrix<Scalar,Dynamic,1> DenseVector;
+  typedef typename NumTraits<Scalar>::Real RealScalar;
+  Index rows = internal::random<Index>(1,200);
+  Index cols = internal::random<Index>(1,200);
+  DenseMatrix refMat = DenseMatrix::Zero(rows, cols);
+  SparseMatrixType m(rows, cols);
+  initSparse<Scalar>(internal::random<double>(0.01,0.3), refMat, m);
+  // a few long rows to exercise the padding
+  for(Index j=0; j<cols; ++j)
+    refMat(0,j) = m.coeffRef(0,j) = internal::random<Scalar>();
+
+  Index sigma = internal::random<Index>(1,2*rows);
+  SellMatrix<Scalar,StorageIndex> sm(m, sigma);
+  VERIFY_IS_EQUAL(sm.rows(), rows);
+  VERIFY_IS_EQUAL(sm.cols(), cols);
+  VERIFY_IS_EQUAL(sm.nonZeros(), m.nonZeros());
+  VERIFY(sm.storedEntries() >= sm.nonZeros());
+
+  DenseMatrix fromIterators = DenseMatrix::Zero(rows, cols);
+  for(Index i=0; i<sm.outerSize(); ++i)
+    for(typename SellMatrix<Scalar,StorageIndex>::InnerIterator it(sm,i); it; ++it)
+      fromIterators(it.row(), it.col()) = it.value();
+  VERIFY_IS_EQUAL(fromIterators, refMat);
+
+  DenseVector x = DenseVector::Random(cols), y = DenseVector::Random(rows);
+  DenseMatrix X = DenseMatrix::Random(cols, 3);
+  Matrix<Scalar,Dynamic,Dynamic,RowMajor> Xr = X;
+  Scalar alpha = internal::random<Scalar>();
+  VERIFY_IS_APPROX(DenseVector(sm*x), refMat*x);
+  VERIFY_IS_APPROX(DenseMatrix(sm*X), refMat*X);
+  VERIFY_IS_APPROX(DenseMatrix(sm*Xr), refMat*X);
+  DenseVector yref = y + alpha*(refMat*x);
+  y.noalias() += alpha*(sm*x);
+  VERIFY_IS_APPROX(y, yref);
+  VERIFY_IS_APPROX(DenseVector(sm*(x+x)), refMat*(x+x));
+
+  // the padding must not propagate non finite entries of x to the rows which do not reference them
+  DenseVector xinf = x;
+  xinf(0) = Scalar(std::numeric_limits<RealScalar>::infinity());
+  DenseVector yinf = sm*xinf, x0 = x;
+  x0(0) = Scalar(0);
+  DenseVector y0 = refMat*x0;
+  for(Index i=0; i<rows; ++i)
+  {
+    if(refMat(i,0)!=Scalar(0))
+      continue;
+    VERIFY((numext::isfinite)(yinf(i)));
+    VERIFY_IS_APPROX(yinf(i)+Scalar(1), y0(i)+Scalar(1));
+  }
+
+  // use as the matrix type of iterative solvers
+  Index n = internal::random<Index>(20,200);
+  SparseMatrixType A(n,n);
+  DenseMatrix refA = DenseMatrix::Zero(n,n);
+  initSparse<Scalar>(0.05, refA, A);
+  A = SparseMatrixType(A.adjoint()*A);
+  for(Index i=0; i<n; ++i)
+    A.coeffRef(i,i) += Scalar(n);
+  SellMatrix<Scalar,StorageIndex> sA(A);
+  DenseVector b = DenseVector::Random(n);
+  ConjugateGradient<SellMatrix<Scalar,StorageIndex>, Lower|Upper, DiagonalPreconditioner<Scalar> > cg(sA);
+  DenseVector xcg = cg.solve(b);
+  VERIFY(cg.info()==Success);
+  VERIFY_IS_APPROX(A*xcg, b);
+  BiCGSTAB<SellMatrix<Scalar,StorageIndex>, IdentityPreconditioner> bicg(sA);
+  DenseVector xbicg = bicg.solve(b);
+  VERIFY(bicg.info()==Success);
+  VERIFY_IS_APPROX(A*xbicg, b);
+}
+
 EIGEN_DECLARE_TEST(sparse_extra)
 {
   for(int i = 0; i < g_repeat; i++) {
@@ -221,6 +296,11 @@ EIGEN_DECLARE_TEST(sparse_extra)
     CALL_SUBTEST_5( (check_marketio_vector<Matrix<std::complex<float>,Dynamic,1> >()) );
     CALL_SUBTEST_5( (check_marketio_vector<Matrix<std::complex<double>,Dynamic,1> >()) );
 
+    CALL_SUBTEST_6( (check_sell_matrix<double,int>()) );
+    CALL_SUBTEST_6( (check_sell_matrix<float,int>()) );
+    CALL_SUBTEST_6( (check_sell_matrix<double,long int>()) );
+    CALL_SUBTEST_6( (check_sell_matrix<std::complex<double>,int>()) );
+
     TEST_SET_BUT_UNUSED_VARIABLE(s);
   }
 }